@@ -0,0 +1,32 @@
+// another way to achieve what #pragma once does
+#ifndef benchmark_hpp
+#define benchmark_hpp
+// time measurement
+#include <chrono>
+// reading sizes from the command line
+#include <cstdlib>
+// returns the smallest time, in seconds, taken by function over some
+// repetitions, so that warming up caches does not count
+template<typename Function>
+double seconds(Function function, int repetitions = 3){
+  double best {0};
+
+  for (int r {0}; r < repetitions; ++r){
+    const auto start {std::chrono::steady_clock::now()};
+    function();
+    const std::chrono::duration<double> elapsed {std::chrono::steady_clock::now() - start};
+
+    if (r == 0 || elapsed.count() < best){
+      best = elapsed.count();
+    }
+  }
+
+  return best;
+}
+// returns the argument at position i of the command line as a number,
+// or fallback if there is no such argument
+inline std::size_t argument(int argc, char** argv, int i, std::size_t fallback){
+  return i < argc ? std::strtoul(argv[i], nullptr, 10) : fallback;
+}
+
+#endif
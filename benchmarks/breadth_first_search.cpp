@@ -0,0 +1,50 @@
+// compares top-down, bottom-up and direction-optimizing breadth first
+// searches on a random digraph, stored as rows of bits and in
+// compressed sparse rows. Searches are repeated in the same graph, so
+// in-neighbors are built once, before timing. Usage: breadth_first_search_benchmark [n]
+// [degree], for n vertices with degree out-neighbors on average
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+#include <breadth_first_search.hpp>
+#include <csr_graph.hpp>
+
+#include "benchmark.hpp"
+
+int main(int argc, char** argv){
+  const std::size_t n {argument(argc, argv, 1, 16384)};
+  const std::size_t degree {argument(argc, argv, 2, 16)};
+
+  std::mt19937 generator {42};
+  std::uniform_int_distribution<std::size_t> vertex {0, n - 1};
+
+  Digraph d {n};
+  for (std::size_t e {0}; e < n * degree; ++e){
+    d.add_edge(vertex(generator), vertex(generator));
+  }
+  const auto csr {CsrDigraph::from(d)};
+  // every search starts at the same vertex
+  const std::size_t source {0};
+  std::size_t reached {0};
+  for (const auto distance : breadth_first_search(d, source).distance){
+    reached += distance != BfsTree::unreached;
+  }
+
+  std::cout << "n = " << n << ", edges = " << d.num_edges << ", reached = " << reached
+            << ", threads = " << ThreadPool::shared().num_threads() << '\n'
+            << std::setw(14) << "direction" << std::setw(14) << "bits (s)" << std::setw(14) << "csr (s)" << '\n';
+
+  const std::pair<const char*, BfsDirection> directions[] {{"top-down", BfsDirection::top_down},
+                                                           {"bottom-up", BfsDirection::bottom_up},
+                                                           {"optimizing", BfsDirection::optimizing}};
+  // searchers are built once, so in-neighbors are not timed
+  BreadthFirstSearch<Digraph> bits_search {d};
+  BreadthFirstSearch<CsrDigraph> csr_search {csr};
+  for (const auto& [name, direction] : directions){
+    const double bits {seconds([&](){ bits_search.search(source, direction); })};
+    const double compressed {seconds([&](){ csr_search.search(source, direction); })};
+
+    std::cout << std::setw(14) << name << std::setw(14) << bits << std::setw(14) << compressed << '\n';
+  }
+}
@@ -0,0 +1,64 @@
+// compares parallel connected components (Afforest) with a sequential
+// union-find over DisjointSet, on a random graph stored as rows of
+// bits and in compressed sparse rows. Usage:
+// connected_components_benchmark [n] [degree], for n vertices with
+// degree neighbors on average
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+#include <connected_components.hpp>
+#include <csr_graph.hpp>
+#include <disjoint_sets.hpp>
+
+#include "benchmark.hpp"
+// number of components found by joining the endpoints of every edge
+template<typename GraphType>
+std::size_t union_find(const GraphType& g){
+  DisjointSet sets {g.num_verts};
+  std::size_t count {g.num_verts};
+
+  for (std::size_t u {0}; u < g.num_verts; ++u){
+    g.for_each_neighbor(u, [&](std::size_t v){
+      if (u < v && sets.join(u, v)){
+        --count;
+      }
+    });
+  }
+
+  return count;
+}
+
+int main(int argc, char** argv){
+  const std::size_t n {argument(argc, argv, 1, 32768)};
+  const std::size_t degree {argument(argc, argv, 2, 4)};
+
+  std::mt19937 generator {42};
+  std::uniform_int_distribution<std::size_t> vertex {0, n - 1};
+
+  Graph g {n};
+  for (std::size_t e {0}; e < n * degree / 2; ++e){
+    const std::size_t u {vertex(generator)};
+    const std::size_t v {vertex(generator)};
+    if (u != v){
+      g.add_edge(u, v);
+    }
+  }
+  const auto csr {CsrGraph::from(g)};
+
+  const std::size_t count {connected_components(g).count()};
+  if (count != union_find(g)){
+    std::cout << "component counts differ\n";
+    return 1;
+  }
+
+  std::cout << "n = " << n << ", edges = " << g.num_edges << ", components = " << count
+            << ", threads = " << ThreadPool::shared().num_threads() << '\n'
+            << std::setw(14) << "algorithm" << std::setw(14) << "bits (s)" << std::setw(14) << "csr (s)" << '\n'
+            << std::setw(14) << "union-find"
+            << std::setw(14) << seconds([&](){ union_find(g); })
+            << std::setw(14) << seconds([&](){ union_find(csr); }) << '\n'
+            << std::setw(14) << "afforest"
+            << std::setw(14) << seconds([&](){ connected_components(g); })
+            << std::setw(14) << seconds([&](){ connected_components(csr); }) << '\n';
+}
@@ -0,0 +1,53 @@
+// compares building graphs edge by edge, with add_edge, and in bulk,
+// with build_graph, from the same random edge list, with repeated
+// edges. Usage: edge_list_benchmark [n] [degree], for n vertices with
+// degree edges per vertex on average
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+#include <edge_list.hpp>
+
+#include "benchmark.hpp"
+// graph built by adding edges one by one
+template<typename GraphType>
+GraphType one_by_one(std::size_t num_verts, const std::vector<Edge>& edges){
+  GraphType g {num_verts};
+  for (const auto& [u, v] : edges){
+    g.add_edge(u, v);
+  }
+
+  return g;
+}
+
+int main(int argc, char** argv){
+  const std::size_t n {argument(argc, argv, 1, 32768)};
+  const std::size_t degree {argument(argc, argv, 2, 16)};
+
+  std::mt19937 generator {42};
+  std::uniform_int_distribution<std::size_t> vertex {0, n - 1};
+
+  std::vector<Edge> edges (n * degree);
+  for (auto& e : edges){
+    e = {vertex(generator), vertex(generator)};
+  }
+
+  const auto bulk {build_graph<Digraph>(n, edges)};
+  if (!bulk || bulk->num_edges != one_by_one<Digraph>(n, edges).num_edges){
+    std::cout << "edge counts differ\n";
+    return 1;
+  }
+
+  std::cout << "n = " << n << ", edges = " << edges.size() << ", distinct = " << bulk->num_edges
+            << ", threads = " << ThreadPool::shared().num_threads() << '\n'
+            << std::setw(14) << "graph" << std::setw(14) << "add_edge (s)" << std::setw(14) << "bulk (s)" << '\n'
+            << std::setw(14) << "Digraph"
+            << std::setw(14) << seconds([&](){ one_by_one<Digraph>(n, edges); })
+            << std::setw(14) << seconds([&](){ build_graph<Digraph>(n, edges); }) << '\n'
+            << std::setw(14) << "Graph"
+            << std::setw(14) << seconds([&](){ one_by_one<Graph>(n, edges); })
+            << std::setw(14) << seconds([&](){ build_graph<Graph>(n, edges); }) << '\n'
+            << std::setw(14) << "CsrGraph"
+            << std::setw(14) << seconds([&](){ CsrGraph::from(one_by_one<Graph>(n, edges)); })
+            << std::setw(14) << seconds([&](){ build_graph<CsrGraph>(n, edges); }) << '\n';
+}
@@ -0,0 +1,51 @@
+// compares getting a graph back at start up by adding its edges one
+// by one, by loading a graph file into memory, and by mapping it.
+// Usage: graph_file_benchmark [n] [degree], for a random graph with n
+// vertices and degree neighbors on average
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <graph_file.hpp>
+
+#include "benchmark.hpp"
+
+int main(int argc, char** argv){
+  const std::size_t n {argument(argc, argv, 1, 16384)};
+  const std::size_t degree {argument(argc, argv, 2, 16)};
+  const std::string path {"graph_file_benchmark.bin"};
+
+  std::mt19937 generator {42};
+  std::uniform_int_distribution<std::size_t> vertex {0, n - 1};
+
+  std::vector<std::pair<std::size_t, std::size_t>> edges (n * degree / 2);
+  for (auto& e : edges){
+    e = {vertex(generator), vertex(generator)};
+  }
+  const auto build {[&](){
+    Graph g {n};
+    for (const auto& [u, v] : edges){
+      g.add_edge(u, v);
+    }
+
+    return g;
+  }};
+
+  const Graph g {build()};
+  if (!save_snapshot(g, path)){
+    std::cout << "cannot write " << path << '\n';
+    return 1;
+  }
+  // results are kept, so that nothing is optimized away
+  volatile std::size_t kept {0};
+
+  std::cout << "n = " << n << ", edges = " << g.num_edges << '\n'
+            << std::setw(14) << "start up" << std::setw(14) << "time (s)" << '\n'
+            << std::setw(14) << "add_edge" << std::setw(14) << seconds([&](){ kept = build().num_edges; }) << '\n'
+            << std::setw(14) << "load" << std::setw(14) << seconds([&](){ kept = load_snapshot<Graph>(path)->num_edges; }) << '\n'
+            << std::setw(14) << "map" << std::setw(14) << seconds([&](){ kept = MappedGraph<Graph>::open(path)->num_edges; }) << '\n';
+
+  std::remove(path.c_str());
+}
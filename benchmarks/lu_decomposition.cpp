@@ -0,0 +1,37 @@
+// measures the blocked LU factorization, and inversion through it.
+// Usage:
+// lu_decomposition_benchmark [n], for a random n x n matrix
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+#include <lu_decomposition.hpp>
+
+#include "benchmark.hpp"
+
+int main(int argc, char** argv){
+  const std::size_t n {argument(argc, argv, 1, 1000)};
+
+  std::mt19937 generator {42};
+  std::uniform_real_distribution<double> value {-1, 1};
+
+  SquareMatrix<double> a {n};
+  for (std::size_t i {0}; i < n; ++i){
+    for (std::size_t j {0}; j < n; ++j){
+      a.at(i, j) = value(generator);
+    }
+  }
+  // factorization takes 2n^3/3 floating point operations, and solving
+  // for the n columns of the identity 2n^3 more
+  const double time {seconds([&](){ LUDecomposition<double> lu {a}; })};
+  const double flops {2.0 * n * n * n / 3};
+  const LUDecomposition<double> lu {a};
+  const double inverse_time {seconds([&](){ lu.inverse(); })};
+  const double inverse_flops {2.0 * n * n * n};
+
+  std::cout << "n = " << n << ", threads = " << ThreadPool::shared().num_threads() << '\n'
+            << std::setw(14) << "" << std::setw(14) << "time (s)" << std::setw(14) << "GFLOP/s" << '\n'
+            << std::setw(14) << "factorization" << std::setw(14) << time << std::setw(14) << flops / time / 1e9 << '\n'
+            << std::setw(14) << "inverse" << std::setw(14) << inverse_time
+            << std::setw(14) << inverse_flops / inverse_time / 1e9 << '\n';
+}
@@ -0,0 +1,62 @@
+// compares sparse (CSR and CSC) and dense products at several
+// densities. Usage: sparse_matrix_benchmark [n] [k], for n x n
+// matrices multiplied by a vector and by a n x k matrix
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <sparse_matrix.hpp>
+
+#include "benchmark.hpp"
+
+int main(int argc, char** argv){
+  const std::size_t n {argument(argc, argv, 1, 2000)};
+  const std::size_t k {argument(argc, argv, 2, 32)};
+
+  std::mt19937 generator {42};
+  std::uniform_real_distribution<double> value {-1, 1};
+
+  Matrix<double> b {n, k};
+  for (std::size_t i {0}; i < n; ++i){
+    for (std::size_t j {0}; j < k; ++j){
+      b.at(i, j) = value(generator);
+    }
+  }
+  std::vector<double> x (n, 1);
+  std::vector<double> y (n);
+  Matrix<double> x_dense {n, 1};
+  Matrix<double> y_dense {n, 1};
+  Matrix<double> c {n, k};
+  x_dense = 1;
+
+  std::cout << "n = " << n << ", k = " << k << ", threads = " << ThreadPool::shared().num_threads() << '\n'
+            << std::setw(10) << "density"
+            << std::setw(14) << "dense mv (s)" << std::setw(14) << "csr mv (s)" << std::setw(14) << "csc mv (s)"
+            << std::setw(14) << "dense mm (s)" << std::setw(14) << "csr mm (s)" << std::setw(14) << "csc mm (s)" << '\n';
+
+  for (double density : {0.001, 0.01, 0.05, 0.2, 0.5}){
+    // random matrix with the given fraction of nonzeros
+    std::bernoulli_distribution nonzero {density};
+    Matrix<double> a {n, n};
+    for (std::size_t i {0}; i < n; ++i){
+      for (std::size_t j {0}; j < n; ++j){
+        if (nonzero(generator)){
+          a.at(i, j) = value(generator);
+        }
+      }
+    }
+    CsrMatrix<double> csr {a};
+    CscMatrix<double> csc {a};
+
+    std::cout << std::setw(10) << density
+              << std::setw(14) << seconds([&](){ multiply(a, x_dense, y_dense); })
+              << std::setw(14) << seconds([&](){ multiply(csr, x, y); })
+              << std::setw(14) << seconds([&](){ multiply(csc, x, y); })
+              << std::setw(14) << seconds([&](){ multiply(a, b, c); })
+              << std::setw(14) << seconds([&](){ multiply(csr, b, c); })
+              << std::setw(14) << seconds([&](){ multiply(csc, b, c); }) << '\n';
+  }
+
+  return 0;
+}
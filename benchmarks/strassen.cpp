@@ -0,0 +1,54 @@
+// compares Strassen-Winograd multiplication, at several crossover
+// sizes, with the classical blocked kernel, to find the crossover of
+// this machine. Usage: strassen_benchmark [n], for n x n matrices
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+#include <strassen.hpp>
+
+#include "benchmark.hpp"
+
+int main(int argc, char** argv){
+  const std::size_t n {argument(argc, argv, 1, 2048)};
+
+  std::mt19937 generator {42};
+  std::uniform_real_distribution<double> value {-1, 1};
+
+  SquareMatrix<double> a {n};
+  SquareMatrix<double> b {n};
+  SquareMatrix<double> c {n};
+  for (std::size_t i {0}; i < n; ++i){
+    for (std::size_t j {0}; j < n; ++j){
+      a.at(i, j) = value(generator);
+      b.at(i, j) = value(generator);
+    }
+  }
+  // rates are given in classical flops (2n^3) per second, so they are
+  // comparable across algorithms
+  const double flops {2.0 * n * n * n};
+  const double classical {seconds([&](){ multiply(a, b, c); })};
+
+  std::cout << "n = " << n << ", threads = " << ThreadPool::shared().num_threads() << '\n'
+            << std::setw(12) << "crossover" << std::setw(14) << "time (s)" << std::setw(14) << "GFLOP/s" << '\n'
+            << std::setw(12) << "classical" << std::setw(14) << classical << std::setw(14) << flops / classical / 1e9 << '\n';
+
+  std::size_t best_crossover {n};
+  double best {classical};
+  for (std::size_t crossover {64}; crossover < n; crossover *= 2){
+    const double time {seconds([&](){ strassen_multiply(a, b, c, crossover); })};
+    if (time < best){
+      best = time;
+      best_crossover = crossover;
+    }
+
+    std::cout << std::setw(12) << crossover << std::setw(14) << time << std::setw(14) << flops / time / 1e9 << '\n';
+  }
+
+  if (best_crossover < n){
+    std::cout << "best crossover: " << best_crossover << '\n';
+  }
+  else{
+    std::cout << "classical multiplication is faster at this size\n";
+  }
+}
@@ -0,0 +1,71 @@
+// times the transitive closure of a random digraph, and compares
+// reachability queries answered by an index with queries answered by
+// a depth first search each. Usage: transitive_closure_benchmark [n]
+// [degree], for n vertices with degree out-neighbors on average
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+#include <transitive_closure.hpp>
+
+#include "benchmark.hpp"
+
+int main(int argc, char** argv){
+  const std::size_t n {argument(argc, argv, 1, 8192)};
+  const std::size_t degree {argument(argc, argv, 2, 2)};
+  const std::size_t queries {1000};
+
+  std::mt19937 generator {42};
+  std::uniform_int_distribution<std::size_t> vertex {0, n - 1};
+
+  Digraph d {n};
+  for (std::size_t e {0}; e < n * degree; ++e){
+    d.add_edge(vertex(generator), vertex(generator));
+  }
+  const auto csr {CsrDigraph::from(d)};
+
+  std::vector<std::pair<std::size_t, std::size_t>> pairs (queries);
+  for (auto& [u, v] : pairs){
+    u = vertex(generator);
+    v = vertex(generator);
+  }
+
+  const ReachabilityIndex index {csr};
+  std::size_t reached {0};
+  for (const auto& [u, v] : pairs){
+    reached += index.reachable(u, v);
+  }
+
+  const double closure {seconds([&](){ transitive_closure(csr); })};
+  const double build {seconds([&](){ ReachabilityIndex{csr}; })};
+  // each search stops as soon as it finds the target
+  struct Target : DfsVisitor{
+    std::size_t target;
+    bool discover_vertex(std::size_t v){
+      return v != target;
+    }
+  };
+  std::size_t found {0};
+  const double searched {seconds([&](){
+                                   found = 0;
+                                   for (const auto& [u, v] : pairs){
+                                     Target t {};
+                                     t.target = v;
+                                     found += !depth_first_search(csr, u, t);
+                                   }
+                                 }, 1)};
+  const double indexed {seconds([&](){
+                                  found = 0;
+                                  for (const auto& [u, v] : pairs){
+                                    found += index.reachable(u, v);
+                                  }
+                                })};
+
+  std::cout << "n = " << n << ", edges = " << d.num_edges << ", components = " << index.num_components()
+            << ", reachable pairs = " << reached << " / " << queries
+            << ", threads = " << ThreadPool::shared().num_threads() << '\n'
+            << std::setw(28) << "closure of digraph (s)" << std::setw(14) << closure << '\n'
+            << std::setw(28) << "index (s)" << std::setw(14) << build << '\n'
+            << std::setw(28) << "queries by search (s)" << std::setw(14) << searched << '\n'
+            << std::setw(28) << "queries by index (s)" << std::setw(14) << indexed << '\n';
+}
@@ -0,0 +1,66 @@
+// compares triangle counting by checking every triple of vertices
+// with has_edge, with intersecting rows of bits, and with merging
+// lists of neighbors of a compressed graph, on a random graph.
+// Usage: triangle_counting_benchmark [n] [degree], for n vertices with
+// degree neighbors on average
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+#include <csr_graph.hpp>
+#include <triangle_counting.hpp>
+
+#include "benchmark.hpp"
+// number of triangles found by checking every triple u < v < w, the
+// last edge only when the first one is present
+std::size_t triple_loop(const Graph& g){
+  std::size_t count {0};
+  for (std::size_t u {0}; u < g.num_verts; ++u){
+    for (std::size_t v {u + 1}; v < g.num_verts; ++v){
+      if (g.has_edge(u, v)){
+        for (std::size_t w {v + 1}; w < g.num_verts; ++w){
+          count += g.has_edge(v, w) && g.has_edge(u, w);
+        }
+      }
+    }
+  }
+
+  return count;
+}
+
+int main(int argc, char** argv){
+  const std::size_t n {argument(argc, argv, 1, 4096)};
+  const std::size_t degree {argument(argc, argv, 2, 64)};
+
+  std::mt19937 generator {42};
+  std::uniform_int_distribution<std::size_t> vertex {0, n - 1};
+
+  Graph g {n};
+  for (std::size_t e {0}; e < n * degree / 2; ++e){
+    const std::size_t u {vertex(generator)};
+    const std::size_t v {vertex(generator)};
+    if (u != v){
+      g.add_edge(u, v);
+    }
+  }
+
+  const CsrGraph csr {CsrGraph::from(g)};
+  const std::size_t count {count_triangles(g)};
+  if (count != triple_loop(g) || count != count_triangles(csr)){
+    std::cout << "triangle counts differ\n";
+    return 1;
+  }
+
+  // results are kept, so that counting is not optimized away
+  volatile std::size_t kept {0};
+
+  std::cout << "n = " << n << ", edges = " << g.num_edges << ", triangles = " << count
+            << ", threads = " << ThreadPool::shared().num_threads() << '\n'
+            << std::setw(22) << "algorithm" << std::setw(14) << "time (s)" << '\n'
+            << std::setw(22) << "triple loop" << std::setw(14) << seconds([&](){ kept = triple_loop(g); }) << '\n'
+            << std::setw(22) << "count_triangles" << std::setw(14) << seconds([&](){ kept = count_triangles(g); }) << '\n'
+            << std::setw(22) << "triangles_per_vertex" << std::setw(14) << seconds([&](){ kept = triangles_per_vertex(g)[0]; }) << '\n'
+            << std::setw(22) << "clustering" << std::setw(14) << seconds([&](){ clustering_coefficients(g); }) << '\n'
+            << std::setw(22) << "count_triangles (CSR)" << std::setw(14) << seconds([&](){ kept = count_triangles(csr); }) << '\n'
+            << std::setw(22) << "per_vertex (CSR)" << std::setw(14) << seconds([&](){ kept = triangles_per_vertex(csr)[0]; }) << '\n';
+}
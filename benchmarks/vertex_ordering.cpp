@@ -0,0 +1,61 @@
+// compares depth and breadth first searches on a grid whose vertices
+// are labeled at random, stored in compressed sparse rows, before and
+// after reordering its vertices. Random labels scatter the neighbors
+// of each vertex through memory; reordering brings them back close
+// together. Usage: vertex_ordering_benchmark [width], for a square
+// grid of width x width vertices
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+#include <breadth_first_search.hpp>
+#include <vertex_ordering.hpp>
+
+#include "benchmark.hpp"
+// times a forest depth first search over g, and a breadth first
+// search from source, with in-neighbors built before timing
+void time_searches(const char* name, const CsrGraph& g, std::size_t source){
+  BreadthFirstSearch<CsrGraph> search {g};
+
+  std::cout << std::setw(14) << name
+            << std::setw(14) << seconds([&](){ depth_first_search(g, [](std::size_t){}); })
+            << std::setw(14) << seconds([&](){ search.search(source, BfsDirection::top_down); })
+            << std::setw(16) << seconds([&](){ search.search(source); }) << '\n';
+}
+
+int main(int argc, char** argv){
+  const std::size_t width {argument(argc, argv, 1, 1024)};
+  const std::size_t n {width * width};
+
+  std::vector<std::size_t> label (n);
+  for (std::size_t v {0}; v < n; ++v){
+    label[v] = v;
+  }
+  std::shuffle(label.begin(), label.end(), std::mt19937{42});
+
+  std::vector<Edge> edges {};
+  for (std::size_t v {0}; v < n; ++v){
+    if ((v + 1) % width != 0){
+      edges.push_back({label[v], label[v + 1]});
+    }
+    if (v + width < n){
+      edges.push_back({label[v], label[v + width]});
+    }
+  }
+  const auto g {build_graph<CsrGraph>(n, std::move(edges))};
+  // every search starts at the same vertex, whatever its label
+  const std::size_t source {label[0]};
+
+  std::cout << "n = " << n << ", edges = " << g->num_edges << ", threads = " << ThreadPool::shared().num_threads() << '\n'
+            << std::setw(14) << "ordering" << std::setw(14) << "dfs (s)" << std::setw(14) << "bfs (s)"
+            << std::setw(16) << "optimizing (s)" << '\n';
+  time_searches("random", *g, source);
+
+  const std::pair<const char*, VertexOrdering> orderings[] {{"rcm", VertexOrdering::reverse_cuthill_mckee},
+                                                            {"degree", VertexOrdering::degree},
+                                                            {"breadth-first", VertexOrdering::breadth_first}};
+  for (const auto& [name, ordering] : orderings){
+    const auto reordered {reorder(*g, ordering)};
+    time_searches(name, reordered.graph, reordered.permutation.forward[source]);
+  }
+}
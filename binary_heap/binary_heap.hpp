@@ -2,6 +2,8 @@
 #pragma once
 // for comparation functions
 #include <functional>
+// priority_element and extract may have nothing to return
+#include <optional>
 // for contiguous memory management
 #include <vector>
 // A binary max heap assgning a priority to each Element
@@ -0,0 +1,370 @@
+// another way to achieve what #pragma once does
+#ifndef bit_matrix_hpp
+#define bit_matrix_hpp
+// fill and copy of words
+#include <algorithm>
+// words are 64 bit unsigned integers
+#include <cstdint>
+// rows are parameterized by their (possibly const) word type
+#include <type_traits>
+// we are going to store words in a vector
+#include <vector>
+// bit operations on single words. Compilers provide them as builtins,
+// which become single instructions on most targets
+namespace bit_detail{
+  using word_type = std::uint64_t;
+  // number of set bits of w
+  inline std::size_t popcount(word_type w){
+#if defined(__GNUC__)
+    return static_cast<std::size_t>(__builtin_popcountll(w));
+#else
+    std::size_t count {0};
+    for (; w != 0; w &= w - 1){
+      ++count;
+    }
+    return count;
+#endif
+  }
+  // position of the lowest set bit of w, which must not be zero
+  inline std::size_t lowest_set(word_type w){
+#if defined(__GNUC__)
+    return static_cast<std::size_t>(__builtin_ctzll(w));
+#else
+    std::size_t position {0};
+    for (; (w & 1) == 0; w >>= 1){
+      ++position;
+    }
+    return position;
+#endif
+  }
+}
+// a sequence of bits stored in consecutive words, such as a row of a
+// BitMatrix. Word is either a mutable or a const word type, giving
+// read-write and read-only rows. Bits are numbered from the lowest
+// bit of the first word; bits past size() are always zero, so whole
+// words can be combined without masking
+template<typename Word>
+class BitRow_{
+public:
+  using size_type = std::size_t;
+  using word_type = std::remove_const_t<Word>;
+  // number of bits per word
+  static constexpr size_type word_bits {64};
+private:
+  // first word and number of bits
+  Word*     words_;
+  size_type size_;
+  // number of words holding our bits
+  size_type num_words_() const{
+    return (size_ + word_bits - 1) / word_bits;
+  }
+  // applies operation to each pair of corresponding words of this
+  // row and row, storing results in this row
+  template<typename Other, typename Operation>
+  const BitRow_& combine_(const BitRow_<Other>& row, Operation operation) const{
+    const size_type n {std::min(num_words_(), row.num_words())};
+
+    for (size_type w {0}; w < n; ++w){
+      words_[w] = operation(words_[w], row.words()[w]);
+    }
+
+    return *this;
+  }
+public:
+  // simple constructor
+  BitRow_(Word* words, size_type size) : words_{words}, size_{size}
+  {}
+  // a mutable row can be seen as an immutable one
+  template<typename Other,
+           typename = std::enable_if_t<std::is_same_v<const Other, Word> && !std::is_same_v<Other, Word>>>
+  BitRow_(const BitRow_<Other>& row) : words_{row.words()}, size_{row.size()}
+  {}
+  // number of bits
+  size_type size() const{
+    return size_;
+  }
+  // underlying words
+  Word* words() const{
+    return words_;
+  }
+  size_type num_words() const{
+    return num_words_();
+  }
+  // value of bit j
+  bool test(size_type j) const{
+    return (words_[j / word_bits] >> (j % word_bits)) & 1;
+  }
+  // sets bit j to value
+  void set(size_type j, bool value = true) const{
+    const word_type mask {word_type{1} << (j % word_bits)};
+
+    if (value){
+      words_[j / word_bits] |= mask;
+    }
+    else{
+      words_[j / word_bits] &= ~mask;
+    }
+  }
+  // whole-row operations with another row of the same size, one word
+  // (64 bits) at a time
+  template<typename Other>
+  const BitRow_& operator&=(const BitRow_<Other>& row) const{
+    return combine_(row, [](word_type a, word_type b){ return a & b; });
+  }
+  template<typename Other>
+  const BitRow_& operator|=(const BitRow_<Other>& row) const{
+    return combine_(row, [](word_type a, word_type b){ return a | b; });
+  }
+  template<typename Other>
+  const BitRow_& operator^=(const BitRow_<Other>& row) const{
+    return combine_(row, [](word_type a, word_type b){ return a ^ b; });
+  }
+  // copies bits of row into this row
+  template<typename Other>
+  const BitRow_& assign(const BitRow_<Other>& row) const{
+    return combine_(row, [](word_type, word_type b){ return b; });
+  }
+  // sets every bit to zero
+  void reset() const{
+    std::fill(words_, words_ + num_words_(), word_type{0});
+  }
+  // number of set bits
+  size_type count() const{
+    size_type total {0};
+
+    for (size_type w {0}; w < num_words_(); ++w){
+      total += bit_detail::popcount(words_[w]);
+    }
+
+    return total;
+  }
+  // determines whether some bit is set
+  bool any() const{
+    for (size_type w {0}; w < num_words_(); ++w){
+      if (words_[w] != 0){
+        return true;
+      }
+    }
+
+    return false;
+  }
+  // position of the first set bit at position j or later. Returns
+  // size() if there is no such bit. Words with no set bits are
+  // skipped whole
+  size_type find_next(size_type j) const{
+    if (j >= size_){
+      return size_;
+    }
+
+    size_type w {j / word_bits};
+    // bits before j are discarded from the first word
+    word_type word {words_[w] & (~word_type{0} << (j % word_bits))};
+
+    while (word == 0){
+      if (++w == num_words_()){
+        return size_;
+      }
+      word = words_[w];
+    }
+
+    return w * word_bits + bit_detail::lowest_set(word);
+  }
+  // position of the first set bit, or size() if there is none
+  size_type find_first() const{
+    return find_next(0);
+  }
+  // calls function(j) for each set bit j, in increasing order
+  template<typename Function>
+  void for_each_set(Function function) const{
+    for (size_type w {0}; w < num_words_(); ++w){
+      for (word_type word {words_[w]}; word != 0; word &= word - 1){
+        function(w * word_bits + bit_detail::lowest_set(word));
+      }
+    }
+  }
+};
+// number of bits set in both a and b, computed without building their
+// intersection
+template<typename WordA, typename WordB>
+std::size_t count_and(const BitRow_<WordA>& a, const BitRow_<WordB>& b){
+  const std::size_t n {std::min(a.num_words(), b.num_words())};
+  std::size_t total {0};
+
+  for (std::size_t w {0}; w < n; ++w){
+    total += bit_detail::popcount(a.words()[w] & b.words()[w]);
+  }
+
+  return total;
+}
+// class to represent a matrix of bits. Each row is stored in its own
+// sequence of 64 bit words, so rows are word-aligned, and operations
+// on whole rows (see BitRow_) process 64 positions per instruction
+class BitMatrix{
+public:
+  using size_type = std::size_t;
+  using word_type = bit_detail::word_type;
+  // mutable and immutable rows
+  using Row      = BitRow_<word_type>;
+  using ConstRow = BitRow_<const word_type>;
+  // number of bits per word
+  static constexpr size_type word_bits {Row::word_bits};
+  // class to represent a reference to a single bit
+  class reference{
+    // word holding the bit, and mask selecting it
+    word_type& word_;
+    word_type  mask_;
+  public:
+    // simple constructor
+    reference(word_type& word, size_type bit) : word_{word}, mask_{word_type{1} << bit}
+    {}
+    // implicitly converts reference to bool
+    operator bool() const{
+      return (word_ & mask_) != 0;
+    }
+    // assigns value to referenced bit
+    reference& operator=(bool value){
+      if (value){
+        word_ |= mask_;
+      }
+      else{
+        word_ &= ~mask_;
+      }
+
+      return *this;
+    }
+    // assigns value of ref to referenced bit
+    reference& operator=(const reference& ref){
+      return *this = static_cast<bool>(ref);
+    }
+  };
+private:
+  // words of each row, stored linewise, number of rows, number of
+  // columns and number of words per row
+  std::vector<word_type> data_;
+  size_type rows_;
+  size_type cols_;
+  size_type words_per_row_;
+  // mask of the valid bits of the last word of each row
+  word_type last_word_mask_() const{
+    return cols_ % word_bits == 0 ? ~word_type{0} : (word_type{1} << (cols_ % word_bits)) - 1;
+  }
+public:
+  // const references to number of rows and number of columns
+  const size_type& num_rows;
+  const size_type& num_cols;
+  // builds a matrix with a certain number of rows and columns, every
+  // bit being zero
+  BitMatrix(size_type rows, size_type cols)
+    : data_{}, rows_{rows}, cols_{cols}, words_per_row_{(cols + word_bits - 1) / word_bits},
+      num_rows{rows_}, num_cols{cols_}
+  {
+    data_.resize(rows_ * words_per_row_, 0);
+  }
+  // copy constructor
+  BitMatrix(const BitMatrix& m)
+    : data_{m.data_}, rows_{m.rows_}, cols_{m.cols_}, words_per_row_{m.words_per_row_},
+      num_rows{rows_}, num_cols{cols_}
+  {}
+  // copy assignment
+  BitMatrix& operator=(const BitMatrix& m){
+    data_          = m.data_;
+    rows_          = m.rows_;
+    cols_          = m.cols_;
+    words_per_row_ = m.words_per_row_;
+
+    return *this;
+  }
+  // move constructor
+  BitMatrix(BitMatrix&& m)
+    : data_{std::move(m.data_)}, rows_{m.rows_}, cols_{m.cols_}, words_per_row_{m.words_per_row_},
+      num_rows{rows_}, num_cols{cols_}
+  {
+    m.rows_          = 0;
+    m.cols_          = 0;
+    m.words_per_row_ = 0;
+  }
+  // move assignment
+  BitMatrix& operator=(BitMatrix&& m){
+    data_          = std::move(m.data_);
+    rows_          = m.rows_;
+    cols_          = m.cols_;
+    words_per_row_ = m.words_per_row_;
+
+    m.rows_          = 0;
+    m.cols_          = 0;
+    m.words_per_row_ = 0;
+
+    return *this;
+  }
+  // provides access to bit at position (i, j)
+  reference at(size_type i, size_type j){
+    return {data_[i * words_per_row_ + j / word_bits], j % word_bits};
+  }
+  // returns a copy of bit at position (i, j)
+  bool const_at(size_type i, size_type j) const{
+    return (data_[i * words_per_row_ + j / word_bits] >> (j % word_bits)) & 1;
+  }
+  // returns representation of row i
+  Row row(size_type i){
+    return {data_.data() + i * words_per_row_, cols_};
+  }
+  ConstRow row(size_type i) const{
+    return {data_.data() + i * words_per_row_, cols_};
+  }
+  // number of words of each row
+  size_type words_per_row() const{
+    return words_per_row_;
+  }
+  // words of every row, stored linewise
+  word_type* data(){
+    return data_.data();
+  }
+  const word_type* data() const{
+    return data_.data();
+  }
+  // assigns value to each position of matrix. Bits past the last
+  // column are kept zero
+  BitMatrix& operator=(bool value){
+    if (!value){
+      std::fill(data_.begin(), data_.end(), word_type{0});
+    }
+    else if (words_per_row_ > 0){
+      for (size_type i {0}; i < rows_; ++i){
+        word_type* words {data_.data() + i * words_per_row_};
+        std::fill(words, words + words_per_row_, ~word_type{0});
+        words[words_per_row_ - 1] = last_word_mask_();
+      }
+    }
+
+    return *this;
+  }
+  // number of set bits
+  size_type count() const{
+    size_type total {0};
+
+    for (auto word : data_){
+      total += bit_detail::popcount(word);
+    }
+
+    return total;
+  }
+};
+// square matrix of bits. It is a template (whose only meaningful
+// argument is bool) so that it can take the place of SquareMatrix
+// wherever a matrix template is expected, such as in Digraph_
+template<typename Type = bool>
+class BitSquareMatrix : public BitMatrix{
+  static_assert(std::is_same_v<Type, bool>, "BitSquareMatrix only holds bits");
+public:
+  // simple constructor
+  BitSquareMatrix(size_type n) : BitMatrix{n, n}
+  {}
+  // assigns value to each position of matrix
+  BitSquareMatrix& operator=(bool value){
+    BitMatrix::operator=(value);
+
+    return *this;
+  }
+};
+
+#endif
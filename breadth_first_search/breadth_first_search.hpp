@@ -0,0 +1,381 @@
+// another way to achieve what #pragma once does
+#ifndef breadth_first_search_hpp
+#define breadth_first_search_hpp
+// min
+#include <algorithm>
+// vertices are claimed through atomic operations on words of bits
+#include <atomic>
+// in-neighbors are built on demand
+#include <memory>
+// trees are moved out of the state of searches
+#include <utility>
+// distances, parents and frontiers are kept in vectors
+#include <vector>
+// frontiers are rows of bits, and graphs provide neighbor_row
+#include <bit_matrix.hpp>
+#include <graph.hpp>
+// levels are expanded in parallel
+#include <thread_pool.hpp>
+// how a breadth first search expands each level: top-down steps scan
+// the neighbors of the frontier, looking for unvisited vertices, and
+// bottom-up steps scan the unvisited vertices, looking for a parent in
+// the frontier. Top-down steps are cheaper while the frontier is
+// small; bottom-up steps are cheaper when it holds a large part of the
+// graph, as each unvisited vertex stops at its first parent.
+// Optimizing searches switch between both as the frontier grows and
+// shrinks
+enum class BfsDirection{optimizing, top_down, bottom_up};
+// result of a breadth first search: the number of edges in a shortest
+// path from the source to each vertex, and the previous vertex in one
+// such path, which makes parents a tree rooted at the source (whose
+// parent is itself). Vertices not reachable from the source have
+// distance and parent unreached
+struct BfsTree{
+  using size_type = std::size_t;
+
+  static constexpr size_type unreached {~size_type{0}};
+
+  std::vector<size_type> distance;
+  std::vector<size_type> parent;
+  // whether v is reachable from the source
+  bool reached(size_type v) const{
+    return distance[v] != unreached;
+  }
+};
+// helpers of breadth first search. Sets of vertices (the visited
+// vertices and the current and next frontiers) are rows of bits, one
+// bit per vertex, so both kinds of steps process them a word at a
+// time, and threads work on disjoint ranges of words
+namespace bfs_detail{
+  using size_type = std::size_t;
+  using word_type = bit_detail::word_type;
+
+  constexpr size_type word_bits {BitMatrix::word_bits};
+  // optimizing searches go bottom-up when the edges leaving the
+  // frontier exceed 1 / alpha of those leaving unvisited vertices, and
+  // back top-down when the frontier holds less than 1 / beta of the
+  // vertices. These are the values suggested by Beamer et al
+  constexpr size_type alpha {14};
+  constexpr size_type beta  {24};
+  // graphs with rows of bits go bottom-up when there are less than
+  // this many unvisited vertices per frontier vertex
+  constexpr size_type bit_rows_ratio {1};
+  // parallel loops take at least this many words (1024 vertices) per
+  // chunk
+  constexpr size_type grain {16};
+  // in-neighbors of every vertex, which bottom-up steps scan looking
+  // for a parent in the frontier. Undirected graphs are their own
+  // in-neighbors; directed graphs are transposed, into a matrix of
+  // bits when they have rows of bits, and into compressed sparse rows
+  // otherwise, so that memory grows as the graph itself does
+  template<typename G>
+  class InNeighbors{
+    static constexpr bool bit_rows_ {graph_detail::has_neighbor_rows<G>::value};
+
+    const G& g_;
+    // rows of the transposed matrix of bits
+    BitMatrix rows_;
+    // first position of the in-neighbors of each vertex, and
+    // in-neighbors of every vertex
+    std::vector<size_type> start_;
+    std::vector<size_type> source_;
+    // whether u is in frontier
+    static bool in_frontier(size_type u, const std::vector<word_type>& frontier){
+      return (frontier[u / word_bits] >> (u % word_bits)) & 1;
+    }
+  public:
+    // transposes g, if needed
+    InNeighbors(const G& g, ThreadPool& pool)
+      : g_{g}, rows_{0, 0}, start_{}, source_{}
+    {
+      const size_type n {g.num_verts};
+
+      if constexpr (G::directed && bit_rows_){
+        rows_ = BitMatrix{n, n};
+        // sources u in [64 w, 64 w + 64) only write word w of the
+        // transposed rows, so chunks of whole words do not collide
+        const size_type words {(n + word_bits - 1) / word_bits};
+        pool.parallel_for(0, words, [&](size_type first, size_type last){
+          for (size_type u {first * word_bits}; u < std::min(n, last * word_bits); ++u){
+            g.neighbor_row(u).for_each_set([this, u](size_type v){ rows_.row(v).set(u); });
+          }
+        });
+      }
+      else if constexpr (G::directed){
+        start_.assign(n + 1, 0);
+        for (size_type u {0}; u < n; ++u){
+          g.for_each_neighbor(u, [this](size_type v){ ++start_[v + 1]; });
+        }
+        for (size_type v {0}; v < n; ++v){
+          start_[v + 1] += start_[v];
+        }
+        // sources are visited in increasing order, so each list of
+        // in-neighbors ends up sorted
+        source_.resize(start_[n]);
+        std::vector<size_type> next {start_.begin(), start_.end() - 1};
+        for (size_type u {0}; u < n; ++u){
+          g.for_each_neighbor(u, [this, &next, u](size_type v){ source_[next[v]++] = u; });
+        }
+      }
+      else{
+        static_cast<void>(pool);
+      }
+    }
+    // first in-neighbor of v in frontier, or num_verts if there is none
+    size_type find_in(size_type v, const std::vector<word_type>& frontier) const{
+      if constexpr (bit_rows_){
+        const auto row {G::directed ? rows_.row(v) : g_.neighbor_row(v)};
+        for (size_type w {0}; w < row.num_words(); ++w){
+          const word_type common {row.words()[w] & frontier[w]};
+          if (common != 0){
+            return w * word_bits + bit_detail::lowest_set(common);
+          }
+        }
+      }
+      else if constexpr (G::directed){
+        for (size_type k {start_[v]}; k < start_[v + 1]; ++k){
+          if (in_frontier(source_[k], frontier)){
+            return source_[k];
+          }
+        }
+      }
+      else{
+        size_type cursor {0};
+        for (size_type u {graph_detail::next_neighbor(g_, v, cursor)}; u < g_.num_verts; u = graph_detail::next_neighbor(g_, v, cursor)){
+          if (in_frontier(u, frontier)){
+            return u;
+          }
+        }
+      }
+
+      return g_.num_verts;
+    }
+  };
+  // number of vertices and of edges leaving them, in a frontier
+  struct FrontierSize{
+    size_type vertices;
+    size_type edges;
+  };
+}
+// breadth first searches in a fixed graph D, which may be any graph
+// providing num_verts, for_each_neighbor and out_degree (or degree, if
+// it is undirected); graphs with rows of bits are scanned a word at a
+// time. Each level is expanded in parallel, and direction tells how
+// (see BfsDirection). What searches need besides the graph (degrees,
+// and in-neighbors for bottom-up steps) is computed once, so it pays
+// to keep a BreadthFirstSearch for many searches in the same graph,
+// which must not change meanwhile
+template<typename DigraphType>
+class BreadthFirstSearch{
+public:
+  using size_type = typename DigraphType::size_type;
+private:
+  // aliases for helpers
+  using word_type    = bfs_detail::word_type;
+  using FrontierSize = bfs_detail::FrontierSize;
+  using InNeighbors  = bfs_detail::InNeighbors<DigraphType>;
+
+  static constexpr size_type word_bits {bfs_detail::word_bits};
+  static constexpr size_type grain {bfs_detail::grain};
+  // graphs with rows of bits scan whole rows whatever the degrees
+  static constexpr bool bit_rows_ {graph_detail::has_neighbor_rows<DigraphType>::value};
+
+  const DigraphType& D_;
+  ThreadPool& pool_;
+  // number of vertices and of words of sets of vertices
+  size_type num_verts_;
+  size_type num_words_;
+  // number of edges leaving each vertex, which sizes frontiers in
+  // graphs without rows of bits, and their sum
+  std::vector<size_type> degree_;
+  size_type total_edges_;
+  // in-neighbors are only built if a bottom-up step needs them
+  std::unique_ptr<InNeighbors> in_;
+  // state of a search: visited vertices and next frontier are written
+  // concurrently by top-down steps, while the current frontier is only
+  // read
+  struct State_{
+    BfsTree tree;
+    std::vector<std::atomic<word_type>> visited;
+    std::vector<std::atomic<word_type>> next;
+    std::vector<word_type> frontier;
+  };
+  // mask of the bits of word w standing for vertices
+  word_type valid_(size_type w) const{
+    return (w + 1) * word_bits <= num_verts_ ? ~word_type{0} : (word_type{1} << (num_verts_ % word_bits)) - 1;
+  }
+  // v is found from parent u at level: only the thread which set its
+  // visited bit gets here, so the rest of its state is written without
+  // synchronization
+  void found_(State_& state, size_type level, size_type u, size_type v, FrontierSize& size) const{
+    state.tree.distance[v] = level;
+    state.tree.parent[v]   = u;
+    ++size.vertices;
+    if constexpr (!bit_rows_){
+      size.edges += degree_[v];
+    }
+  }
+  // expands the frontier by scanning its vertices' neighbors. Each
+  // chunk takes some words of the frontier and claims unvisited
+  // neighbors a word at a time
+  FrontierSize top_down_(State_& state, size_type level){
+    std::atomic<size_type> vertices {0};
+    std::atomic<size_type> edges {0};
+
+    pool_.parallel_for(0, num_words_, [&](size_type first, size_type last){
+      FrontierSize size {0, 0};
+      const auto claim {[&](size_type u, size_type w, word_type candidates){
+                          candidates &= ~state.visited[w].load(std::memory_order_relaxed);
+                          if (candidates == 0){
+                            return;
+                          }
+                          const word_type claimed {candidates & ~state.visited[w].fetch_or(candidates, std::memory_order_relaxed)};
+                          if (claimed != 0){
+                            state.next[w].fetch_or(claimed, std::memory_order_relaxed);
+                            for (word_type bits {claimed}; bits != 0; bits &= bits - 1){
+                              found_(state, level, u, w * word_bits + bit_detail::lowest_set(bits), size);
+                            }
+                          }
+                        }};
+
+      for (size_type fw {first}; fw < last; ++fw){
+        for (word_type members {state.frontier[fw]}; members != 0; members &= members - 1){
+          const size_type u {fw * word_bits + bit_detail::lowest_set(members)};
+          if constexpr (bit_rows_){
+            const auto row {D_.neighbor_row(u)};
+            for (size_type w {0}; w < row.num_words(); ++w){
+              if (row.words()[w] != 0){
+                claim(u, w, row.words()[w]);
+              }
+            }
+          }
+          else{
+            D_.for_each_neighbor(u, [&claim, u](size_type v){ claim(u, v / word_bits, word_type{1} << (v % word_bits)); });
+          }
+        }
+      }
+      vertices += size.vertices;
+      edges    += size.edges;
+    }, grain);
+
+    return {vertices.load(), edges.load()};
+  }
+  // expands the frontier by looking for a parent of each unvisited
+  // vertex in it. Each chunk owns its words of visited and next, so
+  // they are written without atomic read-modify-writes
+  FrontierSize bottom_up_(State_& state, size_type level){
+    if (!in_){
+      in_ = std::make_unique<InNeighbors>(D_, pool_);
+    }
+    std::atomic<size_type> vertices {0};
+    std::atomic<size_type> edges {0};
+
+    pool_.parallel_for(0, num_words_, [&](size_type first, size_type last){
+      FrontierSize size {0, 0};
+      for (size_type w {first}; w < last; ++w){
+        const word_type seen {state.visited[w].load(std::memory_order_relaxed)};
+        word_type now {0};
+        for (word_type pending {~seen & valid_(w)}; pending != 0; pending &= pending - 1){
+          const size_type v {w * word_bits + bit_detail::lowest_set(pending)};
+          const size_type u {in_->find_in(v, state.frontier)};
+          if (u < num_verts_){
+            found_(state, level, u, v, size);
+            now |= word_type{1} << (v % word_bits);
+          }
+        }
+        state.visited[w].store(seen | now, std::memory_order_relaxed);
+        state.next[w].store(now, std::memory_order_relaxed);
+      }
+      vertices += size.vertices;
+      edges    += size.edges;
+    }, grain);
+
+    return {vertices.load(), edges.load()};
+  }
+  // whether the next step should be bottom-up, given the size of the
+  // frontier and of the unvisited part of the graph. Bit rows cost the
+  // same whatever the degrees: a whole row per frontier vertex in
+  // top-down steps, and at most a whole row per unvisited vertex in
+  // bottom-up ones. Otherwise, costs follow edges
+  static bool choose_bottom_up_(bool bottom_up, FrontierSize frontier, FrontierSize unvisited, size_type num_verts){
+    if constexpr (bit_rows_){
+      static_cast<void>(bottom_up);
+      static_cast<void>(num_verts);
+
+      return unvisited.vertices < frontier.vertices * bfs_detail::bit_rows_ratio;
+    }
+    else if (!bottom_up){
+      return frontier.edges > unvisited.edges / bfs_detail::alpha;
+    }
+    else{
+      return frontier.vertices >= num_verts / bfs_detail::beta;
+    }
+  }
+public:
+  // prepares searches in D, run by threads of pool
+  explicit BreadthFirstSearch(const DigraphType& D, ThreadPool& pool = ThreadPool::shared())
+    : D_{D}, pool_{pool}, num_verts_{D.num_verts}, num_words_{(D.num_verts + word_bits - 1) / word_bits},
+      degree_{}, total_edges_{0}, in_{}
+  {
+    if constexpr (!bit_rows_){
+      degree_.resize(num_verts_);
+      pool_.parallel_for(0, num_verts_, [this](size_type first, size_type last){
+        for (size_type u {first}; u < last; ++u){
+          degree_[u] = graph_detail::out_degree(D_, u);
+        }
+      }, grain * word_bits);
+      for (const size_type d : degree_){
+        total_edges_ += d;
+      }
+    }
+  }
+  // searches D from source: returns the distance from source to each
+  // vertex, along with a tree of shortest paths. When a vertex has
+  // several parents in the previous level, which one it gets depends
+  // on the scheduling of threads
+  BfsTree search(size_type source, BfsDirection direction = BfsDirection::optimizing){
+    State_ state {{std::vector<size_type>(num_verts_, BfsTree::unreached), std::vector<size_type>(num_verts_, BfsTree::unreached)},
+                  std::vector<std::atomic<word_type>>(num_words_), std::vector<std::atomic<word_type>>(num_words_),
+                  std::vector<word_type>(num_words_, 0)};
+    for (size_type w {0}; w < num_words_; ++w){
+      state.visited[w].store(0, std::memory_order_relaxed);
+      state.next[w].store(0, std::memory_order_relaxed);
+    }
+
+    const word_type source_bit {word_type{1} << (source % word_bits)};
+    state.tree.distance[source] = 0;
+    state.tree.parent[source]   = source;
+    state.visited[source / word_bits].store(source_bit, std::memory_order_relaxed);
+    state.frontier[source / word_bits] = source_bit;
+
+    FrontierSize frontier {1, bit_rows_ ? 0 : degree_[source]};
+    FrontierSize unvisited {num_verts_ - 1, total_edges_ - frontier.edges};
+    bool bottom_up {direction == BfsDirection::bottom_up};
+
+    for (size_type level {1}; frontier.vertices > 0; ++level){
+      if (direction == BfsDirection::optimizing){
+        bottom_up = choose_bottom_up_(bottom_up, frontier, unvisited, num_verts_);
+      }
+
+      frontier = bottom_up ? bottom_up_(state, level) : top_down_(state, level);
+      unvisited.vertices -= frontier.vertices;
+      unvisited.edges    -= frontier.edges;
+      // next frontier becomes the current one
+      for (size_type w {0}; w < num_words_; ++w){
+        state.frontier[w] = state.next[w].exchange(0, std::memory_order_relaxed);
+      }
+    }
+
+    return std::move(state.tree);
+  }
+};
+// performs a single breadth first search in D starting at vertex
+// source (see BreadthFirstSearch)
+template<typename DigraphType>
+BfsTree breadth_first_search(const DigraphType& D, typename DigraphType::size_type source,
+                             BfsDirection direction = BfsDirection::optimizing,
+                             ThreadPool& pool = ThreadPool::shared()){
+  return BreadthFirstSearch<DigraphType>{D, pool}.search(source, direction);
+}
+
+#endif
@@ -0,0 +1,174 @@
+// another way to achieve what #pragma once does
+#ifndef connected_components_hpp
+#define connected_components_hpp
+// the most frequent sampled component is found by sorting
+#include <algorithm>
+// components are hooked through compare-and-swap
+#include <atomic>
+// vertices are sampled with a fixed seed, so results do not vary
+#include <random>
+// labels and sizes are kept in vectors
+#include <vector>
+// graphs provide neighbors through next_neighbor
+#include <graph.hpp>
+// vertices are linked in parallel
+#include <thread_pool.hpp>
+// connected components of an undirected graph: the component of each
+// vertex, numbered from 0 in the order of their smallest vertices, and
+// the number of vertices of each component
+struct Components{
+  using size_type = std::size_t;
+
+  std::vector<size_type> label;
+  std::vector<size_type> size;
+  // number of components
+  size_type count() const{
+    return size.size();
+  }
+};
+// Afforest (Sutton et al.): every vertex starts as a tree of its own,
+// whose root is its parent, and edges link trees by hooking the root
+// with the larger index under the other root, through compare-and-swap,
+// so concurrent links never lock. First, only a couple of edges per
+// vertex are linked, which is usually enough to join most of the graph
+// into a single giant tree. Then, the giant tree is found by sampling,
+// and the remaining edges are only scanned from vertices outside it,
+// skipping most of the graph
+namespace components_detail{
+  using size_type = std::size_t;
+  using Parents = std::vector<std::atomic<size_type>>;
+  // edges linked per vertex before the giant tree is looked for
+  constexpr size_type neighbor_rounds {2};
+  // vertices sampled to find the giant tree
+  constexpr size_type samples {1024};
+  // vertices per chunk of parallel loops
+  constexpr size_type grain {1024};
+  // links the trees of u and v, hooking the larger of their roots
+  // under the smaller one. When a compare-and-swap fails, another
+  // thread has hooked that root meanwhile, so roots are looked for
+  // again from where it left them
+  inline void link(size_type u, size_type v, Parents& parent){
+    size_type p_u {parent[u].load(std::memory_order_relaxed)};
+    size_type p_v {parent[v].load(std::memory_order_relaxed)};
+
+    while (p_u != p_v){
+      const size_type high {std::max(p_u, p_v)};
+      const size_type low  {std::min(p_u, p_v)};
+      size_type p_high {parent[high].load(std::memory_order_relaxed)};
+      // already linked by someone else
+      if (p_high == low){
+        break;
+      }
+      // high is a root, so it is hooked, unless it stopped being one
+      if (p_high == high && parent[high].compare_exchange_strong(p_high, low, std::memory_order_relaxed)){
+        break;
+      }
+      p_u = parent[parent[high].load(std::memory_order_relaxed)].load(std::memory_order_relaxed);
+      p_v = parent[low].load(std::memory_order_relaxed);
+    }
+  }
+  // makes the parent of each vertex the root of its tree. Parents only
+  // get smaller, so a vertex may be compressed while others are
+  inline void compress(Parents& parent, ThreadPool& pool){
+    pool.parallel_for(0, parent.size(), [&parent](size_type first, size_type last){
+      for (size_type v {first}; v < last; ++v){
+        size_type p {parent[v].load(std::memory_order_relaxed)};
+        for (size_type pp {parent[p].load(std::memory_order_relaxed)}; p != pp; pp = parent[p].load(std::memory_order_relaxed)){
+          p = pp;
+        }
+        parent[v].store(p, std::memory_order_relaxed);
+      }
+    }, grain);
+  }
+  // root of the largest tree among a sample of vertices, whose parents
+  // must be compressed
+  inline size_type most_frequent_root(const Parents& parent){
+    std::mt19937_64 generator {parent.size()};
+    std::uniform_int_distribution<size_type> vertex {0, parent.size() - 1};
+
+    std::vector<size_type> roots (samples);
+    for (auto& root : roots){
+      root = parent[vertex(generator)].load(std::memory_order_relaxed);
+    }
+    std::sort(roots.begin(), roots.end());
+    // longest run of equal roots
+    size_type best {roots[0]};
+    size_type best_run {0};
+    for (size_type first {0}, last {0}; first < roots.size(); first = last){
+      while (last < roots.size() && roots[last] == roots[first]){
+        ++last;
+      }
+      if (last - first > best_run){
+        best     = roots[first];
+        best_run = last - first;
+      }
+    }
+
+    return best;
+  }
+}
+// finds the connected components of undirected graph G, which may be
+// any graph providing num_verts and next_neighbor (or neighbors), with
+// its vertices linked in parallel by threads of pool
+template<typename GraphType>
+Components connected_components(const GraphType& G, ThreadPool& pool = ThreadPool::shared()){
+  static_assert(!GraphType::directed, "connected components are only defined for undirected graphs");
+  using namespace components_detail;
+
+  const size_type n {G.num_verts};
+  Parents parent (n);
+  for (size_type v {0}; v < n; ++v){
+    parent[v].store(v, std::memory_order_relaxed);
+  }
+  // scan position of the neighbors of each vertex, shared by both
+  // phases so that no edge is linked twice
+  std::vector<size_type> cursor (n, 0);
+  // the first few edges of every vertex
+  for (size_type round {0}; round < neighbor_rounds; ++round){
+    pool.parallel_for(0, n, [&](size_type first, size_type last){
+      for (size_type u {first}; u < last; ++u){
+        const size_type v {graph_detail::next_neighbor(G, u, cursor[u])};
+        if (v < n){
+          link(u, v, parent);
+        }
+      }
+    }, grain);
+    compress(parent, pool);
+  }
+  // the remaining edges of vertices outside the giant tree. Edges
+  // between the giant tree and other vertices are scanned from the
+  // latter, as the graph is undirected
+  if (n > 0){
+    const size_type giant {most_frequent_root(parent)};
+    pool.parallel_for(0, n, [&](size_type first, size_type last){
+      for (size_type u {first}; u < last; ++u){
+        if (parent[u].load(std::memory_order_relaxed) == giant){
+          continue;
+        }
+        for (size_type v {graph_detail::next_neighbor(G, u, cursor[u])}; v < n; v = graph_detail::next_neighbor(G, u, cursor[u])){
+          link(u, v, parent);
+        }
+      }
+    }, grain);
+    compress(parent, pool);
+  }
+  // roots are the smallest vertices of their trees, so numbering roots
+  // as vertices are visited in increasing order gives dense labels in
+  // the order of their smallest vertices
+  Components result {std::vector<size_type>(n), {}};
+  for (size_type v {0}; v < n; ++v){
+    const size_type root {parent[v].load(std::memory_order_relaxed)};
+    if (root == v){
+      result.label[v] = result.size.size();
+      result.size.push_back(0);
+    }
+    else{
+      result.label[v] = result.label[root];
+    }
+    ++result.size[result.label[v]];
+  }
+
+  return result;
+}
+
+#endif
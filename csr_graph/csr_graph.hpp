@@ -0,0 +1,219 @@
+// another way to achieve what #pragma once does
+#ifndef csr_graph_hpp
+#define csr_graph_hpp
+// neighbors are found by binary search
+#include <algorithm>
+// vertices are stored as fixed width integers
+#include <cstdint>
+// compressed forms are moved into graphs
+#include <utility>
+// offsets and neighbors are kept in vectors
+#include <vector>
+// compressed graphs are built from Digraph_ and Graph_
+#include <graph.hpp>
+// contiguous range of the neighbors of a vertex, in increasing order
+template<typename Index>
+class NeighborSpan{
+  const Index* first_;
+  const Index* last_;
+public:
+  using size_type = std::size_t;
+
+  NeighborSpan(const Index* first, const Index* last) : first_{first}, last_{last}
+  {}
+
+  const Index* begin() const{
+    return first_;
+  }
+  const Index* end() const{
+    return last_;
+  }
+  size_type size() const{
+    return static_cast<size_type>(last_ - first_);
+  }
+  bool empty() const{
+    return first_ == last_;
+  }
+  Index operator[](size_type k) const{
+    return first_[k];
+  }
+};
+// a class to represent a directed graph in compressed sparse row
+// form: the out-neighbors of every vertex, in increasing order, are
+// stored contiguously in a single array, and vertex u owns positions
+// [start_[u], start_[u + 1]) of it. Memory grows with the number of
+// edges rather than with the square of the number of vertices, but
+// the graph is immutable: it is built from another graph. Vertices
+// are stored as Index, so 32 bit indices (the default) halve the
+// memory of graphs with fewer than 2^32 vertices
+template<typename Index = std::uint32_t>
+class CsrDigraph_{
+public:
+  // we use the same size_type as Digraph
+  using size_type = Digraph::size_type;
+  using Neighbors = NeighborSpan<Index>;
+  // type of stored vertices
+  using index_type = Index;
+  // edges have a direction
+  static constexpr bool directed {true};
+protected:
+  // first position of the neighbors of each vertex, plus the total
+  // number of positions
+  std::vector<size_type> start_;
+  // neighbors of every vertex
+  std::vector<Index> neighbor_;
+private:
+  // number of vertices
+  size_type num_verts_;
+protected:
+  // number of edges
+  size_type num_edges_;
+  // builds a graph with no vertices
+  CsrDigraph_() : start_(1, 0), neighbor_{}, num_verts_{0}, num_edges_{0}, num_verts{num_verts_}, num_edges{num_edges_}
+  {}
+  // fills offsets and neighbors from graph g, which provides
+  // for_each_neighbor. Offsets come from a first pass counting
+  // neighbors, so neighbors are written once, in place
+  template<typename GraphType>
+  void build_(const GraphType& g){
+    num_verts_ = g.num_verts;
+    start_.assign(num_verts_ + 1, 0);
+    for (size_type u {0}; u < num_verts_; ++u){
+      size_type degree {0};
+      g.for_each_neighbor(u, [&degree](size_type){ ++degree; });
+      start_[u + 1] = start_[u] + degree;
+    }
+
+    neighbor_.resize(start_[num_verts_]);
+    for (size_type u {0}; u < num_verts_; ++u){
+      Index* out {neighbor_.data() + start_[u]};
+      g.for_each_neighbor(u, [&out](size_type v){ *out++ = static_cast<Index>(v); });
+    }
+  }
+  // takes compressed form start and neighbor (see from_compressed),
+  // which holds num_e edges
+  void assign_compressed_(std::vector<size_type> start, std::vector<Index> neighbor, size_type num_e){
+    num_verts_ = start.size() - 1;
+    num_edges_ = num_e;
+    start_     = std::move(start);
+    neighbor_  = std::move(neighbor);
+  }
+public:
+  // const references to the number of vertices and edges, respectively
+  const size_type& num_verts;
+  const size_type& num_edges;
+  // copy and move constructors, which bind references to this graph
+  CsrDigraph_(const CsrDigraph_& d)
+    : start_{d.start_}, neighbor_{d.neighbor_}, num_verts_{d.num_verts_}, num_edges_{d.num_edges_},
+      num_verts{num_verts_}, num_edges{num_edges_}
+  {}
+  CsrDigraph_(CsrDigraph_&& d)
+    : start_{std::move(d.start_)}, neighbor_{std::move(d.neighbor_)}, num_verts_{d.num_verts_}, num_edges_{d.num_edges_},
+      num_verts{num_verts_}, num_edges{num_edges_}
+  {}
+  // builds the compressed form of digraph d
+  template<template<typename Type> typename MatrixType>
+  static CsrDigraph_ from(const Digraph_<MatrixType>& d){
+    CsrDigraph_ result {};
+    result.build_(d);
+    result.num_edges_ = d.num_edges;
+
+    return result;
+  }
+  // builds a digraph from its compressed form: start holds the first
+  // position of the neighbors of each vertex, plus the total number of
+  // positions, and the neighbors of vertex u, in increasing order, are
+  // at positions [start[u], start[u + 1]) of neighbor
+  static CsrDigraph_ from_compressed(std::vector<size_type> start, std::vector<Index> neighbor){
+    CsrDigraph_ result {};
+    const size_type num_e {neighbor.size()};
+    result.assign_compressed_(std::move(start), std::move(neighbor), num_e);
+
+    return result;
+  }
+  // out-neighbors of u, in increasing order
+  Neighbors neighbors(size_type u) const{
+    return {neighbor_.data() + start_[u], neighbor_.data() + start_[u + 1]};
+  }
+  // determines whether there is an edge from u to v
+  bool has_edge(size_type u, size_type v) const{
+    const Neighbors n {neighbors(u)};
+
+    return std::binary_search(n.begin(), n.end(), static_cast<Index>(v));
+  }
+  // returns the first vertex v, not smaller than from, such that there
+  // is an edge from u to v. Returns num_verts if there is none
+  size_type next_neighbor(size_type u, size_type from) const{
+    const Neighbors n {neighbors(u)};
+    if (from >= num_verts_){
+      return num_verts_;
+    }
+    const Index* next {std::lower_bound(n.begin(), n.end(), static_cast<Index>(from))};
+
+    return next != n.end() ? *next : num_verts_;
+  }
+  // calls function(v) for each edge from u to v, in increasing order
+  // of v
+  template<typename Function>
+  void for_each_neighbor(size_type u, Function function) const{
+    for (const Index v : neighbors(u)){
+      function(static_cast<size_type>(v));
+    }
+  }
+  // number of edges leaving u
+  size_type out_degree(size_type u) const{
+    return start_[u + 1] - start_[u];
+  }
+  // raw offsets and neighbors, for algorithms scanning the whole graph
+  const std::vector<size_type>& offsets() const{
+    return start_;
+  }
+  const std::vector<Index>& targets() const{
+    return neighbor_;
+  }
+};
+// alias for the usual compressed digraph
+using CsrDigraph = CsrDigraph_<>;
+// a class to represent an undirected graph in compressed sparse row
+// form. Both directions of each edge are stored, so the neighborhood
+// of every vertex is contiguous
+template<typename Index = std::uint32_t>
+class CsrGraph_ : public CsrDigraph_<Index>{
+  // alias for superclass
+  using Digraph = CsrDigraph_<Index>;
+
+  // builds a graph with no vertices
+  CsrGraph_() : Digraph{}
+  {}
+public:
+  // we use the same size_type as superclass
+  using size_type = typename Digraph::size_type;
+  // edges have no direction
+  static constexpr bool directed {false};
+  // builds the compressed form of graph g
+  template<template<typename Type> typename MatrixType>
+  static CsrGraph_ from(const Graph_<MatrixType>& g){
+    CsrGraph_ result {};
+    result.build_(g);
+    result.num_edges_ = g.num_edges;
+
+    return result;
+  }
+  // builds a graph from its compressed form (see
+  // CsrDigraph_::from_compressed), which must hold both directions of
+  // each of its num_e edges
+  static CsrGraph_ from_compressed(std::vector<size_type> start, std::vector<Index> neighbor, size_type num_e){
+    CsrGraph_ result {};
+    result.assign_compressed_(std::move(start), std::move(neighbor), num_e);
+
+    return result;
+  }
+  // number of edges incident to u
+  size_type degree(size_type u) const{
+    return this->out_degree(u);
+  }
+};
+// alias for the usual compressed graph
+using CsrGraph = CsrGraph_<>;
+
+#endif
@@ -0,0 +1,332 @@
+// another way to achieve what #pragma once does
+#ifndef edge_list_hpp
+#define edge_list_hpp
+// edges are sorted, merged and deduplicated
+#include <algorithm>
+// binary files store vertices as fixed width integers
+#include <cstdint>
+// edge lists are read from and written to streams and files
+#include <fstream>
+#include <istream>
+// reading or building may fail
+#include <optional>
+#include <string>
+// edges are pairs of vertices
+#include <utility>
+#include <vector>
+// we build every kind of graph
+#include <csr_graph.hpp>
+#include <graph.hpp>
+// edges are sorted and graphs filled in parallel
+#include <thread_pool.hpp>
+// an edge (u, v), from u to v; in undirected graphs, between u and v
+using Edge = std::pair<std::size_t, std::size_t>;
+// helpers of bulk construction: edges are sorted and deduplicated in
+// linear time, in parallel, so that each graph can be filled in a
+// single pass, without checking whether edges are already present
+namespace edge_list_detail{
+  using size_type = std::size_t;
+  // elements per chunk of parallel loops
+  constexpr size_type grain {1 << 16};
+  // bits of the digits edges are sorted by. Each chunk counts its
+  // digits in a histogram of 2^11 entries, which fits in the L1 cache,
+  // so counting and scattering keep all of them close at hand however
+  // many vertices there are
+  constexpr size_type digit_bits {11};
+  constexpr size_type radix {size_type{1} << digit_bits};
+  // moves edges to sorted, stably ordered by digit, whose values are
+  // below radix, with a counting sort, which takes linear time: chunks
+  // of edges count their digits, and then scatter their edges to the
+  // place of those digits, in parallel. Returns false, leaving sorted
+  // untouched, when all edges have the same digit, as they are sorted
+  // already
+  template<typename Digit>
+  bool counting_sort(const std::vector<Edge>& edges, std::vector<Edge>& sorted, Digit digit, ThreadPool& pool){
+    const size_type n {edges.size()};
+    const size_type chunks {std::min(pool.num_threads(), std::max<size_type>(1, n / grain))};
+    const size_type chunk {(n + chunks - 1) / chunks};
+    // edges of chunk c with digit d go from position[c * radix + d]
+    std::vector<size_type> position (chunks * radix, 0);
+    pool.parallel_for(0, chunks, [&](size_type first, size_type last){
+      for (size_type c {first}; c < last; ++c){
+        for (size_type k {c * chunk}; k < std::min(n, (c + 1) * chunk); ++k){
+          ++position[c * radix + digit(edges[k])];
+        }
+      }
+    });
+    size_type next {0};
+    for (size_type d {0}; d < radix; ++d){
+      size_type count {0};
+      for (size_type c {0}; c < chunks; ++c){
+        count += position[c * radix + d];
+      }
+      if (count == n){
+        return false;
+      }
+      for (size_type c {0}; c < chunks; ++c){
+        const size_type count_c {position[c * radix + d]};
+        position[c * radix + d] = next;
+        next += count_c;
+      }
+    }
+
+    pool.parallel_for(0, chunks, [&](size_type first, size_type last){
+      for (size_type c {first}; c < last; ++c){
+        for (size_type k {c * chunk}; k < std::min(n, (c + 1) * chunk); ++k){
+          sorted[position[c * radix + digit(edges[k])]++] = edges[k];
+        }
+      }
+    });
+
+    return true;
+  }
+  // sorts edges, whose endpoints are vertices among num_verts, by
+  // source and then by target, which is a radix sort with digits of
+  // digit_bits bits, the least significant first. Unlike comparison
+  // sorts, it takes linear time, and has no branches to mispredict.
+  // Vertices are labeled with just the bits num_verts needs, and when
+  // both labels of an edge fit in 64 bits, they are sorted as a single
+  // key, source bits above target bits, which takes fewer passes
+  inline void sort_edges(std::vector<Edge>& edges, size_type num_verts, ThreadPool& pool){
+    size_type bits {0};
+    for (size_type label {num_verts > 0 ? num_verts - 1 : 0}; label > 0; label >>= 1){
+      ++bits;
+    }
+
+    std::vector<Edge> sorted (edges.size());
+    const auto sort_by {[&](size_type key_bits, auto key){
+      for (size_type shift {0}; shift < key_bits; shift += digit_bits){
+        const auto digit {[shift, key](const Edge& e){ return key(e) >> shift & (radix - 1); }};
+        if (counting_sort(edges, sorted, digit, pool)){
+          edges.swap(sorted);
+        }
+      }
+    }};
+    if (2 * bits <= 64){
+      sort_by(2 * bits, [bits](const Edge& e){ return std::uint64_t{e.first} << bits | e.second; });
+    }
+    else{
+      sort_by(bits, [](const Edge& e){ return e.second; });
+      sort_by(bits, [](const Edge& e){ return e.first; });
+    }
+  }
+  // removes consecutive duplicates of v: chunks count the elements
+  // they keep, and then copy them to their place, in parallel
+  template<typename Type>
+  void parallel_unique(std::vector<Type>& v, ThreadPool& pool){
+    const size_type n {v.size()};
+    const size_type chunks {std::max<size_type>(1, (n + grain - 1) / grain)};
+    // an element is kept when it differs from the previous one
+    const auto kept {[&v](size_type k){ return k == 0 || v[k] != v[k - 1]; }};
+
+    std::vector<size_type> offset (chunks + 1, 0);
+    pool.parallel_for(0, chunks, [&](size_type first, size_type last){
+      for (size_type c {first}; c < last; ++c){
+        for (size_type k {c * grain}; k < std::min(n, (c + 1) * grain); ++k){
+          offset[c + 1] += kept(k);
+        }
+      }
+    });
+    for (size_type c {0}; c < chunks; ++c){
+      offset[c + 1] += offset[c];
+    }
+
+    std::vector<Type> result (offset[chunks]);
+    pool.parallel_for(0, chunks, [&](size_type first, size_type last){
+      for (size_type c {first}; c < last; ++c){
+        size_type out {offset[c]};
+        for (size_type k {c * grain}; k < std::min(n, (c + 1) * grain); ++k){
+          if (kept(k)){
+            result[out++] = v[k];
+          }
+        }
+      }
+    });
+    v.swap(result);
+  }
+  // whether every endpoint of edges is a vertex of a graph with
+  // num_verts vertices
+  inline bool valid(const std::vector<Edge>& edges, size_type num_verts, ThreadPool& pool){
+    std::vector<char> chunk_valid ((edges.size() + grain - 1) / grain, 1);
+    pool.parallel_for(0, chunk_valid.size(), [&](size_type first, size_type last){
+      for (size_type c {first}; c < last; ++c){
+        for (size_type k {c * grain}; k < std::min(edges.size(), (c + 1) * grain); ++k){
+          if (edges[k].first >= num_verts || edges[k].second >= num_verts){
+            chunk_valid[c] = 0;
+          }
+        }
+      }
+    });
+
+    return std::all_of(chunk_valid.begin(), chunk_valid.end(), [](char v){ return v != 0; });
+  }
+  // builds a compressed graph from edges, sorted and without
+  // duplicates, which hold both directions of its num_e edges when it
+  // is undirected
+  template<typename GraphType>
+  GraphType compress(size_type num_verts, const std::vector<Edge>& edges, size_type num_e, ThreadPool& pool){
+    using Index = typename GraphType::index_type;
+
+    std::vector<size_type> start (num_verts + 1);
+    std::vector<Index> neighbor (edges.size());
+    pool.parallel_for(0, num_verts, [&](size_type first, size_type last){
+      const auto source {[](const Edge& e, size_type u){ return e.first < u; }};
+      for (size_type u {first}; u < last; ++u){
+        start[u] = static_cast<size_type>(std::lower_bound(edges.begin(), edges.end(), u, source) - edges.begin());
+      }
+    }, grain);
+    start[num_verts] = edges.size();
+    pool.parallel_for(0, edges.size(), [&](size_type first, size_type last){
+      for (size_type k {first}; k < last; ++k){
+        neighbor[k] = static_cast<Index>(edges[k].second);
+      }
+    }, grain);
+
+    if constexpr (GraphType::directed){
+      return GraphType::from_compressed(std::move(start), std::move(neighbor));
+    }
+    else{
+      return GraphType::from_compressed(std::move(start), std::move(neighbor), num_e);
+    }
+  }
+}
+// builds a graph of GraphType (Digraph_, Graph_, CsrDigraph_ or
+// CsrGraph_) with num_verts vertices and the given edges, in any order
+// and possibly repeated. In undirected graphs, (u, v) and (v, u) are
+// the same edge. Returns nothing if some endpoint is not a vertex.
+// Edges are sorted and deduplicated in parallel, and then the graph is
+// filled in a single pass, setting its number of edges once, which is
+// much faster than adding edges one by one
+template<typename GraphType = Digraph>
+std::optional<GraphType> build_graph(std::size_t num_verts, std::vector<Edge> edges, ThreadPool& pool = ThreadPool::shared()){
+  using namespace edge_list_detail;
+
+  if (!valid(edges, num_verts, pool)){
+    return {};
+  }
+  constexpr bool compressed {graph_detail::has_neighbor_span<GraphType>::value};
+  // compressed undirected graphs store both directions of each edge,
+  // so edges are mirrored, and then sorted along with the originals;
+  // other undirected graphs keep edges as (u, v), u <= v
+  if constexpr (!GraphType::directed){
+    const size_type n {edges.size()};
+    if constexpr (compressed){
+      edges.resize(2 * n);
+    }
+    pool.parallel_for(0, n, [&edges, n](size_type first, size_type last){
+      for (size_type k {first}; k < last; ++k){
+        if constexpr (compressed){
+          edges[n + k] = {edges[k].second, edges[k].first};
+        }
+        else if (edges[k].first > edges[k].second){
+          std::swap(edges[k].first, edges[k].second);
+        }
+      }
+    }, grain);
+  }
+  sort_edges(edges, num_verts, pool);
+  parallel_unique(edges, pool);
+
+  if constexpr (compressed){
+    size_type num_e {edges.size()};
+    // loops are stored once, and every other edge twice
+    if constexpr (!GraphType::directed){
+      const auto loops {std::count_if(edges.begin(), edges.end(), [](const Edge& e){ return e.first == e.second; })};
+      num_e = (edges.size() + static_cast<size_type>(loops)) / 2;
+    }
+
+    return compress<GraphType>(num_verts, edges, num_e, pool);
+  }
+  else{
+    return GraphType::from_sorted_edges(num_verts, edges.data(), edges.size(), pool);
+  }
+}
+// builds a graph of GraphType with num_verts vertices and the edges
+// read from a text stream (see read_edge_list)
+template<typename GraphType = Digraph>
+std::optional<GraphType> build_graph(std::size_t num_verts, std::istream& in, ThreadPool& pool = ThreadPool::shared());
+// builds a graph of GraphType with num_verts vertices and the edges
+// of the binary edge list file at path (see load_edge_list)
+template<typename GraphType = Digraph, typename Vertex = std::uint32_t>
+std::optional<GraphType> load_graph(std::size_t num_verts, const std::string& path, ThreadPool& pool = ThreadPool::shared());
+// reads an edge list from a text stream: pairs of vertices separated
+// by any whitespace, until the end of the stream. Returns nothing if
+// something other than a vertex is found, or a pair is incomplete
+inline std::optional<std::vector<Edge>> read_edge_list(std::istream& in){
+  std::vector<Edge> edges {};
+
+  Edge e {};
+  while (in >> e.first){
+    if (!(in >> e.second)){
+      return {};
+    }
+    edges.push_back(e);
+  }
+  if (!in.eof()){
+    return {};
+  }
+
+  return edges;
+}
+// binary edge list files hold pairs of vertices (u, v), each stored as
+// a Vertex in the byte order of the machine that wrote them, with
+// nothing else. This is the format of many graph generators, and it
+// is read with a single call
+template<typename Vertex = std::uint32_t>
+std::optional<std::vector<Edge>> load_edge_list(const std::string& path){
+  std::ifstream file {path, std::ios::binary | std::ios::ate};
+  if (!file){
+    return {};
+  }
+  const auto size {static_cast<std::size_t>(file.tellg())};
+  if (size % (2 * sizeof(Vertex)) != 0){
+    return {};
+  }
+
+  std::vector<Vertex> vertices (size / sizeof(Vertex));
+  if (!file.seekg(0).read(reinterpret_cast<char*>(vertices.data()), size)){
+    return {};
+  }
+
+  std::vector<Edge> edges (vertices.size() / 2);
+  for (std::size_t k {0}; k < edges.size(); ++k){
+    edges[k] = {vertices[2 * k], vertices[2 * k + 1]};
+  }
+
+  return edges;
+}
+// writes edges to a binary edge list file at path. Returns false if
+// the file could not be written
+template<typename Vertex = std::uint32_t>
+bool save_edge_list(const std::vector<Edge>& edges, const std::string& path){
+  std::vector<Vertex> vertices (2 * edges.size());
+  for (std::size_t k {0}; k < edges.size(); ++k){
+    vertices[2 * k]     = static_cast<Vertex>(edges[k].first);
+    vertices[2 * k + 1] = static_cast<Vertex>(edges[k].second);
+  }
+
+  std::ofstream file {path, std::ios::binary | std::ios::trunc};
+  file.write(reinterpret_cast<const char*>(vertices.data()), vertices.size() * sizeof(Vertex));
+
+  return static_cast<bool>(file.flush());
+}
+template<typename GraphType>
+std::optional<GraphType> build_graph(std::size_t num_verts, std::istream& in, ThreadPool& pool){
+  auto edges {read_edge_list(in)};
+  if (!edges){
+    return {};
+  }
+
+  return build_graph<GraphType>(num_verts, std::move(*edges), pool);
+}
+template<typename GraphType, typename Vertex>
+std::optional<GraphType> load_graph(std::size_t num_verts, const std::string& path, ThreadPool& pool){
+  auto edges {load_edge_list<Vertex>(path)};
+  if (!edges){
+    return {};
+  }
+
+  return build_graph<GraphType>(num_verts, std::move(*edges), pool);
+}
+
+#endif
@@ -1,26 +1,123 @@
 // this is another way of achieving what #pragma once does
 #ifndef graph_hpp
 #define graph_hpp
+// sorted edges are split among threads by binary search
+#include <algorithm>
+// by default, graphs are represented by matrices of bits, whose rows
+// are scanned a word at a time
+#include <bit_matrix.hpp>
 // we are going to use matrices to represent our graphs
 #include <matrix.hpp>
-// stack and vector will be used in depth first search
-#include <stack>
+// building from rows of bits may fail
+#include <optional>
+// graphs are built from edge lists in parallel
+#include <thread_pool.hpp>
+// type traits select how neighbors are scanned
+#include <type_traits>
+// declval detects neighbor ranges
+#include <utility>
+// vector will be used in depth first search
 #include <vector>
-// a class to represent a directed graph represented with MatrixType
-template<template<typename Type> typename MatrixType = SquareMatrix>
+// a class to represent a directed graph represented with MatrixType,
+// which may be BitSquareMatrix (the default), SquareMatrix or any
+// other square matrix template
+template<template<typename Type> typename MatrixType = BitSquareMatrix>
 class Digraph_{
-private:
+protected:
   // alias for MatrixType
   using Data = MatrixType<bool>;
+  // matrices of bits provide whole rows, whose set bits are found a
+  // word at a time
+  static constexpr bool bit_rows_ {std::is_base_of_v<BitMatrix, Data>};
 public:
   // we use the same size_type as Data
   using size_type = typename Data::size_type;
-private:
+  // edges have a direction
+  static constexpr bool directed {true};
+protected:
   // our digraph is represented with an adjacency matrix
   Data data_;
-  // number of vertices and (directed) edges, respectively
+private:
+  // number of vertices
   size_type num_verts_;
+protected:
+  // number of (directed) edges
   size_type num_edges_;
+  // sets the entries of the count edges at edges, which are sorted.
+  // Matrices of bits keep each row in its own words, so sources are
+  // split among threads of pool; other matrices may pack several rows
+  // in a word, so they are filled sequentially
+  void set_sorted_(const std::pair<size_type, size_type>* edges, size_type count, ThreadPool& pool){
+    if constexpr (bit_rows_){
+      pool.parallel_for(0, num_verts_, [this, edges, count](size_type first, size_type last){
+        const auto source {[](const std::pair<size_type, size_type>& e, size_type u){ return e.first < u; }};
+        const auto* e    {std::lower_bound(edges, edges + count, first, source)};
+        const auto* end  {std::lower_bound(e, edges + count, last, source)};
+        for (; e != end; ++e){
+          data_.row(e->first).set(e->second);
+        }
+      }, BitMatrix::word_bits);
+    }
+    else{
+      static_cast<void>(pool);
+
+      for (size_type k {0}; k < count; ++k){
+        data_.at(edges[k].first, edges[k].second) = true;
+      }
+    }
+  }
+  // reads the rows of bits of every vertex with read (see
+  // from_bit_rows) into this digraph, which must have no edges yet,
+  // counting their set bits and the loops among them. Matrices of bits
+  // get rows read straight into their words; other matrices get them
+  // through a buffer, a block of rows at a time, and only keep bits on
+  // or above the diagonal when upper_only is set. Returns false if
+  // read fails
+  template<typename Reader>
+  bool read_bit_rows_(Reader& read, bool upper_only, size_type& bits, size_type& loops){
+    using word_type = bit_detail::word_type;
+    // rows read at a time into buffers
+    constexpr size_type block {1024};
+
+    const size_type n {num_verts_};
+    const size_type words {(n + BitMatrix::word_bits - 1) / BitMatrix::word_bits};
+    // bits past the last vertex must stay zero, whatever was read
+    const word_type last_mask {n % BitMatrix::word_bits == 0 ? ~word_type{0} : (word_type{1} << n % BitMatrix::word_bits) - 1};
+    bits  = 0;
+    loops = 0;
+
+    std::vector<word_type> buffer (bit_rows_ ? 0 : std::min(n, block) * words);
+    for (size_type first {0}; first < n; first += block){
+      const size_type count {std::min(block, n - first)};
+      word_type* rows {};
+      if constexpr (bit_rows_){
+        rows = data_.data() + first * words;
+      }
+      else{
+        rows = buffer.data();
+      }
+      if (!read(first, count, rows)){
+        return false;
+      }
+
+      for (size_type r {0}; r < count; ++r){
+        const size_type u {first + r};
+        const BitMatrix::Row row {rows + r * words, n};
+        row.words()[words - 1] &= last_mask;
+        bits  += row.count();
+        loops += row.test(u);
+        if constexpr (!bit_rows_){
+          row.for_each_set([&](size_type v){
+            if (!upper_only || u <= v){
+              data_.at(u, v) = true;
+            }
+          });
+        }
+      }
+    }
+
+    return true;
+  }
 public:
   // const references to the number of vertices and edges, respectively
   const size_type& num_verts;
@@ -31,6 +128,43 @@ public:
   {
     data_ = false;
   }
+  // copy and move constructors, which bind references to this digraph
+  Digraph_(const Digraph_& d)
+    : data_{d.data_}, num_verts_{d.num_verts_}, num_edges_{d.num_edges_}, num_verts{num_verts_}, num_edges{num_edges_}
+  {}
+  Digraph_(Digraph_&& d)
+    : data_{std::move(d.data_)}, num_verts_{d.num_verts_}, num_edges_{d.num_edges_}, num_verts{num_verts_}, num_edges{num_edges_}
+  {}
+  // builds a digraph with num_v vertices and the count edges (u, v)
+  // at edges, which must be sorted and without duplicates, setting
+  // every edge at once. Rows of bits are filled in parallel by
+  // threads of pool, each one owning a range of sources
+  static Digraph_ from_sorted_edges(size_type num_v, const std::pair<size_type, size_type>* edges, size_type count,
+                                    ThreadPool& pool = ThreadPool::shared()){
+    Digraph_ result {num_v};
+    result.set_sorted_(edges, count, pool);
+    result.num_edges_ = count;
+
+    return result;
+  }
+  // builds a digraph with num_v vertices, whose edges leaving each
+  // vertex u are the set bits of row u, as rows of (num_v + 63) / 64
+  // words, such as those of a BitMatrix. Rows are obtained through
+  // read(first, count, rows), which must store rows first to
+  // first + count - 1 at rows, one after the other, and return whether
+  // it could. Returns nothing if read fails
+  template<typename Reader>
+  static std::optional<Digraph_> from_bit_rows(size_type num_v, Reader read){
+    Digraph_ result {num_v};
+    size_type bits {};
+    size_type loops {};
+    if (!result.read_bit_rows_(read, false, bits, loops)){
+      return {};
+    }
+    result.num_edges_ = bits;
+
+    return result;
+  }
   // determines whether there is an edge from u to v
   bool has_edge(size_type u, size_type v) const{
     return data_.const_at(u, v);
@@ -65,84 +199,296 @@ public:
       return false;
     }
   }
+  // returns the first vertex v, not smaller than from, such that there
+  // is an edge from u to v. Returns num_verts if there is none
+  size_type next_neighbor(size_type u, size_type from) const{
+    if constexpr (bit_rows_){
+      return data_.row(u).find_next(from);
+    }
+    else{
+      for (size_type v {from}; v < num_verts_; ++v){
+        if (has_edge(u, v)){
+          return v;
+        }
+      }
+
+      return num_verts_;
+    }
+  }
+  // row of bits whose set bits are the neighbors of u, so that whole
+  // neighborhoods can be combined a word at a time. Only provided when
+  // digraph is represented with a matrix of bits
+  template<bool bits = bit_rows_, typename = std::enable_if_t<bits>>
+  BitMatrix::ConstRow neighbor_row(size_type u) const{
+    return data_.row(u);
+  }
+  // calls function(v) for each edge from u to v, in increasing order
+  // of v
+  template<typename Function>
+  void for_each_neighbor(size_type u, Function function) const{
+    if constexpr (bit_rows_){
+      data_.row(u).for_each_set(function);
+    }
+    else{
+      for (size_type v {0}; v < num_verts_; ++v){
+        if (has_edge(u, v)){
+          function(v);
+        }
+      }
+    }
+  }
+  // number of edges leaving u
+  size_type out_degree(size_type u) const{
+    if constexpr (bit_rows_){
+      return data_.row(u).count();
+    }
+    else{
+      size_type degree {0};
+      for_each_neighbor(u, [&degree](size_type){ ++degree; });
+
+      return degree;
+    }
+  }
 };
 // alias for avoiding an ugly syntax which would be needed when using
 // Digraph_ as function argument
 using Digraph = Digraph_<>;
-// performs a depth first search in D starting at vertex start. When a
-// vertex is visited, visitor is executed using visited vertex as
-// argument
-template<typename Function>
-void depth_first_search(const Digraph& D, Digraph::size_type start, Function visitor){
+// hooks of a depth first search. Visitors derive from DfsVisitor and
+// hide the hooks they need; every hook returns whether the search
+// should go on, so returning false stops it right away. Edges (u, v)
+// are classified when examined from u: tree edges lead to newly
+// discovered vertices, back edges to vertices still on the stack,
+// forward edges to finished descendants of u and cross edges to any
+// other finished vertex. In undirected graphs each edge is examined
+// from both endpoints
+struct DfsVisitor{
+  using size_type = std::size_t;
+  // a search from v, which is the root of a new tree, begins
+  bool start_vertex(size_type){
+    return true;
+  }
+  // pre-order: v has just been found
+  bool discover_vertex(size_type){
+    return true;
+  }
+  // post-order: every vertex reachable from v has been found
+  bool finish_vertex(size_type){
+    return true;
+  }
+  bool tree_edge(size_type, size_type){
+    return true;
+  }
+  bool back_edge(size_type, size_type){
+    return true;
+  }
+  bool forward_edge(size_type, size_type){
+    return true;
+  }
+  bool cross_edge(size_type, size_type){
+    return true;
+  }
+};
+// helpers of graph traversals
+namespace graph_detail{
+  // whether graphs of type G provide contiguous neighbors(u) ranges
+  template<typename G, typename = void>
+  struct has_neighbor_span : std::false_type{};
+  template<typename G>
+  struct has_neighbor_span<G, std::void_t<decltype(std::declval<const G&>().neighbors(0))>> : std::true_type{};
+  // whether graphs of type G provide neighbor_row(u), a row of bits
+  template<typename G, typename = void>
+  struct has_neighbor_rows : std::false_type{};
+  template<typename G>
+  struct has_neighbor_rows<G, std::void_t<decltype(std::declval<const G&>().neighbor_row(0))>> : std::true_type{};
+  // returns the next neighbor of u from cursor on, and advances cursor
+  // past it, so that scanning the neighbors of u with the same cursor
+  // goes through them once. Cursors are positions in neighbors(u) when
+  // G provides it, and vertices otherwise, in which case rows of bits
+  // are scanned a word at a time. Returns num_verts when there are no
+  // more neighbors
+  template<typename G>
+  typename G::size_type next_neighbor(const G& g, typename G::size_type u, typename G::size_type& cursor){
+    if constexpr (has_neighbor_span<G>::value){
+      const auto neighbors {g.neighbors(u)};
+
+      return cursor < neighbors.size() ? static_cast<typename G::size_type>(neighbors[cursor++]) : g.num_verts;
+    }
+    else{
+      const auto v {g.next_neighbor(u, cursor)};
+      cursor = v + 1;
+
+      return v;
+    }
+  }
+  // number of edges leaving u, which for undirected graphs is the
+  // degree of u
+  template<typename G>
+  typename G::size_type out_degree(const G& g, typename G::size_type u){
+    if constexpr (G::directed){
+      return g.out_degree(u);
+    }
+    else{
+      return g.degree(u);
+    }
+  }
   // we are going to use some colors to represent vertex status: white
   // vertices have not been found yet; gray vertices have been found
-  // and are to be visited; black vertices have been visited
-  enum class Color{white, gray, black};
-  // creates a vector to store each vertex status; initially, no
-  // vertex has been found
-  std::vector<Color> color {D.num_verts, Color::white};
-  // stack to control the order in which vertices should be visited
-  std::stack<Digraph::size_type> dfs {};
-  // procedure to be executed when a vertex is found
-  auto start_visit {[&dfs, &color](const auto i) {
-                      // it is put in the stack
-                      dfs.push(i);
-                      // we mark it as found but not visited yet; it
-                      // will be visited after all its descendants
-                      // have been visited
-                      color[i] = Color::gray;
-                    }};
-  // procedure to explore vertices that were not found yet
-  auto neighbor_to_visit {[&D, &color](const auto i) {
-                            // for each vertex ...
-                            for (Digraph::size_type j {0}; j < D.num_verts; ++j){
-                              // if vertex is reachable from i and has
-                              // not been found yet, returns it
-                              if (color[j] == Color::white && D.has_edge(i, j)){
-                                return j;
-                              }
-                            }
-                            // As D.num_verts is not a valid index, we
-                            // return it to indicate that every
-                            // neighbor of i has already been found
-                            return D.num_verts;
-                          }};
-  // when every descendant of a vertex has been visited, we visit it
-  auto finish_visit {[&visitor, &color](const auto i) {
-                       // call visitor
-                       visitor(i);
-                       // mark as visited
-                       color[i] = Color::black;
-                     }};
-  // we start by finding vertex start
-  start_visit(start);
-  // while there is vertices to be visited, explore its neighborhood
-  while (!dfs.empty()){
-    // selects a neighbor to explore
-    auto neighbor {neighbor_to_visit(dfs.top())};
-    // neighbor is a valid vertex, so it must be explored
-    if (neighbor < D.num_verts){
-      start_visit(neighbor);
-    }
-    // neighbor is not a valid index, which indicates that the vertex
-    // at the top of statk had all its descendants visited, so it is
-    // time to visit it, then discard it
-    else{
-      // visits it
-      finish_visit(dfs.top());
-      // discards it
-      dfs.pop();
+  // and are on the stack; black vertices have been finished
+  enum class DfsColor{white, gray, black};
+  // status of depth first searches, kept from one search to the next
+  // when searching from several vertices
+  template<typename size_type>
+  struct DfsState{
+    std::vector<DfsColor> color;
+    // order in which vertices were found, which tells forward from
+    // cross edges
+    std::vector<size_type> discovery;
+    size_type time;
+    // stack of vertices being explored, each one with the cursor
+    // where the scan of its neighbors resumes
+    struct Frame{
+      size_type vertex;
+      size_type cursor;
+    };
+    std::vector<Frame> stack;
+
+    DfsState(size_type num_verts) : color(num_verts, DfsColor::white), discovery(num_verts), time{0}, stack{}
+    {}
+  };
+  // searches D from start, which has not been found yet, calling the
+  // hooks of visitor. Returns false if a hook stopped the search
+  template<typename G, typename Visitor>
+  bool search_from(const G& D, typename G::size_type start, Visitor& visitor, DfsState<typename G::size_type>& state){
+    using size_type = typename G::size_type;
+
+    auto& color {state.color};
+    auto& stack {state.stack};
+    // procedure to be executed when a vertex is found
+    auto discover {[&](size_type v){
+                     color[v]     = DfsColor::gray;
+                     state.discovery[v] = state.time++;
+                     stack.push_back({v, 0});
+
+                     return visitor.discover_vertex(v);
+                   }};
+
+    if (!discover(start)){
+      return false;
+    }
+    // while there are vertices on the stack, explore the neighborhood
+    // of the top one
+    while (!stack.empty()){
+      const size_type u {stack.back().vertex};
+      const size_type v {next_neighbor(D, u, stack.back().cursor)};
+      // edge (u, v) is classified by the status of v
+      if (v < D.num_verts){
+        bool go_on {true};
+        switch (color[v]){
+        case DfsColor::white:
+          go_on = visitor.tree_edge(u, v) && discover(v);
+          break;
+        case DfsColor::gray:
+          go_on = visitor.back_edge(u, v);
+          break;
+        case DfsColor::black:
+          go_on = state.discovery[u] < state.discovery[v] ? visitor.forward_edge(u, v) : visitor.cross_edge(u, v);
+          break;
+        }
+        if (!go_on){
+          return false;
+        }
+      }
+      // every neighbor of u has been found, so u is finished
+      else{
+        color[u] = DfsColor::black;
+        stack.pop_back();
+
+        if (!visitor.finish_vertex(u)){
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+  // visitor calling function for each finished vertex
+  template<typename Function>
+  struct PostOrderVisitor : DfsVisitor{
+    Function& function;
+
+    PostOrderVisitor(Function& f) : function{f}
+    {}
+
+    bool finish_vertex(size_type v){
+      function(v);
+
+      return true;
+    }
+  };
+}
+// performs a depth first search in D starting at vertex start. visitor
+// is either a DfsVisitor, whose hooks are called as the search goes,
+// or a function, which is called with each vertex when it is finished
+// (that is, in post-order). Returns false if a hook stopped the
+// search. D may be any graph providing num_verts and next_neighbor (or
+// neighbors), whatever its representation. Each vertex on the stack
+// keeps a cursor where the scan of its neighbors resumes, so the
+// search takes time linear in the size of the representation
+template<typename DigraphType, typename Visitor>
+bool depth_first_search(const DigraphType& D, typename DigraphType::size_type start, Visitor&& visitor){
+  if constexpr (!std::is_base_of_v<DfsVisitor, std::decay_t<Visitor>>){
+    graph_detail::PostOrderVisitor<std::remove_reference_t<Visitor>> post_order {visitor};
+
+    return depth_first_search(D, start, post_order);
+  }
+  else{
+    graph_detail::DfsState<typename DigraphType::size_type> state {D.num_verts};
+
+    return graph_detail::search_from(D, start, visitor, state);
+  }
+}
+// performs depth first searches in D from every vertex not found by
+// previous searches, in increasing order, so that every vertex is
+// found once. Hooks are called as in a search from a single vertex,
+// and start_vertex(v) is called before each search, from v; edges
+// leading to trees of previous searches are cross edges
+template<typename DigraphType, typename Visitor>
+bool depth_first_search(const DigraphType& D, Visitor&& visitor){
+  if constexpr (!std::is_base_of_v<DfsVisitor, std::decay_t<Visitor>>){
+    graph_detail::PostOrderVisitor<std::remove_reference_t<Visitor>> post_order {visitor};
+
+    return depth_first_search(D, post_order);
+  }
+  else{
+    using size_type = typename DigraphType::size_type;
+
+    graph_detail::DfsState<size_type> state {D.num_verts};
+    for (size_type v {0}; v < D.num_verts; ++v){
+      if (state.color[v] == graph_detail::DfsColor::white
+          && !(visitor.start_vertex(v) && graph_detail::search_from(D, v, visitor, state))){
+        return false;
+      }
     }
+
+    return true;
   }
 }
-// a class to represent an undirected graph
-class Graph : public Digraph_<UpperTriangularMatrix>{
+// a class to represent an undirected graph. With an upper triangular
+// matrix, only edges {u, v} with u <= v are stored; with any other
+// (square) matrix, both directions of each edge are stored, so the
+// whole neighborhood of a vertex is found in its row
+template<template<typename Type> typename MatrixType = BitSquareMatrix>
+class Graph_ : public Digraph_<MatrixType>{
 private:
   // alias for superclass
-  using Digraph = Digraph_<UpperTriangularMatrix>;
+  using Digraph = Digraph_<MatrixType>;
+  // whether only the upper triangle is represented
+  static constexpr bool triangular_ {std::is_same_v<MatrixType<bool>, UpperTriangularMatrix<bool>>};
 public:
   // we use the same size_type as superclass
   using size_type = typename Digraph::size_type;
+  // edges have no direction
+  static constexpr bool directed {false};
 private:
   // ensures u <= v, which allows us to use a compact representation
   // of the graph
@@ -164,22 +510,148 @@ private:
 
     return (this->*method) (u, v);
   }
+  // sets both directions of edge {u, v} to value
+  void set_both_(size_type u, size_type v, bool value){
+    this->data_.at(u, v) = value;
+    this->data_.at(v, u) = value;
+  }
 public:
   // builds an undirected graph with num_v vertices
-  Graph(size_type num_v) : Digraph{num_v}
+  Graph_(size_type num_v) : Digraph{num_v}
   {}
+  // builds an undirected graph with num_v vertices and the count
+  // edges {u, v} at edges, given as pairs (u, v) with u <= v, sorted
+  // and without duplicates, setting every edge at once. With matrices
+  // of bits, the entries (u, v) are set in parallel by source, and then
+  // the entries (v, u) by blocks of 64 sources, which only write their
+  // own word of each row, so threads never share words
+  static Graph_ from_sorted_edges(size_type num_v, const std::pair<size_type, size_type>* edges, size_type count,
+                                  ThreadPool& pool = ThreadPool::shared()){
+    Graph_ result {num_v};
+    result.set_sorted_(edges, count, pool);
+
+    if constexpr (Digraph::bit_rows_){
+      const size_type words {(num_v + BitMatrix::word_bits - 1) / BitMatrix::word_bits};
+      pool.parallel_for(0, words, [&result, edges, count](size_type first, size_type last){
+        const auto source {[](const std::pair<size_type, size_type>& e, size_type u){ return e.first < u; }};
+        const auto* e    {std::lower_bound(edges, edges + count, first * BitMatrix::word_bits, source)};
+        const auto* end  {std::lower_bound(e, edges + count, last * BitMatrix::word_bits, source)};
+        for (; e != end; ++e){
+          result.data_.row(e->second).set(e->first);
+        }
+      });
+    }
+    else if constexpr (!triangular_){
+      for (size_type k {0}; k < count; ++k){
+        result.data_.at(edges[k].second, edges[k].first) = true;
+      }
+    }
+    result.num_edges_ = count;
+
+    return result;
+  }
+  // builds an undirected graph with num_v vertices from the rows of
+  // bits of its vertices, read as Digraph_::from_bit_rows does. Rows
+  // must be symmetric: bit v of row u is set whenever bit u of row v
+  // is, and each such pair of bits is a single edge
+  template<typename Reader>
+  static std::optional<Graph_> from_bit_rows(size_type num_v, Reader read){
+    Graph_ result {num_v};
+    size_type bits {};
+    size_type loops {};
+    if (!result.read_bit_rows_(read, triangular_, bits, loops)){
+      return {};
+    }
+    result.num_edges_ = (bits + loops) / 2;
+
+    return result;
+  }
   // determines whether there is an edge between u and v
   bool has_edge(size_type u, size_type v) const{
-    return adjust_and_call_(&Digraph::has_edge, u, v);
+    if constexpr (triangular_){
+      return adjust_and_call_(&Digraph::has_edge, u, v);
+    }
+    else{
+      return Digraph::has_edge(u, v);
+    }
   }
-  // adds edge between u and v
+  // adds edge between u and v. Returns false if edge is already present
   bool add_edge(size_type u, size_type v){
-    return adjust_and_call_(&Digraph::add_edge, u, v);
+    if constexpr (triangular_){
+      return adjust_and_call_(&Digraph::add_edge, u, v);
+    }
+    else{
+      if (has_edge(u, v)){
+        return false;
+      }
+
+      set_both_(u, v, true);
+      ++this->num_edges_;
+
+      return true;
+    }
   }
-  // removes edge between u and v
+  // removes edge between u and v. Returns false if edge does not exist
   bool remove_edge(size_type u, size_type v){
-    return adjust_and_call_(&Digraph::remove_edge, u, v);
+    if constexpr (triangular_){
+      return adjust_and_call_(&Digraph::remove_edge, u, v);
+    }
+    else{
+      if (!has_edge(u, v)){
+        return false;
+      }
+
+      set_both_(u, v, false);
+      --this->num_edges_;
+
+      return true;
+    }
+  }
+  // returns the first vertex v, not smaller than from, such that there
+  // is an edge between u and v. Returns num_verts if there is none
+  size_type next_neighbor(size_type u, size_type from) const{
+    if constexpr (triangular_){
+      for (size_type v {from}; v < this->num_verts; ++v){
+        if (has_edge(u, v)){
+          return v;
+        }
+      }
+
+      return this->num_verts;
+    }
+    else{
+      return Digraph::next_neighbor(u, from);
+    }
+  }
+  // calls function(v) for each edge between u and v, in increasing
+  // order of v
+  template<typename Function>
+  void for_each_neighbor(size_type u, Function function) const{
+    if constexpr (triangular_){
+      for (size_type v {0}; v < this->num_verts; ++v){
+        if (has_edge(u, v)){
+          function(v);
+        }
+      }
+    }
+    else{
+      Digraph::for_each_neighbor(u, function);
+    }
+  }
+  // number of edges incident to u
+  size_type degree(size_type u) const{
+    if constexpr (triangular_){
+      size_type degree {0};
+      for_each_neighbor(u, [&degree](size_type){ ++degree; });
+
+      return degree;
+    }
+    else{
+      return Digraph::out_degree(u);
+    }
   }
 };
+// alias for the usual undirected graph
+using Graph = Graph_<>;
 
 #endif
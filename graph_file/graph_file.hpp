@@ -0,0 +1,529 @@
+// another way to achieve what #pragma once does
+#ifndef graph_file_hpp
+#define graph_file_hpp
+// weights are located in rows by counting bits
+#include <algorithm>
+// header fields have fixed widths
+#include <cstdint>
+// we compare magic strings
+#include <cstring>
+// graphs are written and read through file streams
+#include <fstream>
+// loading or opening a file may fail
+#include <optional>
+// files are named by strings
+#include <string>
+// weight types are checked against the file
+#include <type_traits>
+// endpoints of edges are swapped into order
+#include <utility>
+// edges and weights are gathered in vectors
+#include <vector>
+// files are opened and memory mapped through POSIX calls
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+// adjacency is stored as rows of bits
+#include <bit_matrix.hpp>
+// graphs and digraphs are saved and loaded
+#include <graph.hpp>
+// weights are described as the elements of matrix files are
+#include <matrix_file.hpp>
+// weighted graphs are saved and loaded along with their weights
+#include <weighted_graph.hpp>
+// on-disk format of a graph, version 1: this 64 byte header, followed
+// (at adjacency_offset bytes from the start of the file) by the row of
+// bits of each vertex, whose bit v is set when there is an edge to v,
+// exactly as rows of a BitMatrix are laid out in memory. Rows of
+// undirected graphs are symmetric. Weighted graphs add a weights
+// section (at weights_offset) holding, for each vertex u, the position
+// of its first weight, as num_verts + 1 uint64_t, and then (at the
+// next multiple of 64) the weight of each edge {u, v}, u <= v, by
+// increasing u and then v. Sections start at multiples of 64 so that
+// mapped rows and weights are as aligned as cache lines. Fields are
+// stored in the byte order of the machine that wrote the file, which
+// byte_order tells
+struct GraphFileHeader{
+  using word_type = bit_detail::word_type;
+  // properties of graphs
+  enum Flags : std::uint32_t {directed_graph = 1};
+  // identifies graph files
+  static constexpr char graph_magic[8] {'G', 'R', 'A', 'P', 'H', '\0', '\0', '\0'};
+  static constexpr std::uint32_t current_version {1};
+  static constexpr std::uint32_t native_byte_order {0x01020304};
+
+  char          magic[8];
+  std::uint32_t version;
+  std::uint32_t byte_order;
+  std::uint32_t flags;
+  // type of weights, as the type of elements of matrix files: its kind
+  // and its size in bytes. Both are zero in graphs without weights
+  std::uint32_t weight_kind;
+  std::uint32_t weight_size;
+  std::uint32_t reserved;
+  // number of vertices and edges
+  std::uint64_t num_verts;
+  std::uint64_t num_edges;
+  // position of the rows of bits, and of the weights section, which is
+  // zero in graphs without weights
+  std::uint64_t adjacency_offset;
+  std::uint64_t weights_offset;
+  // smallest multiple of 64 not smaller than offset
+  static constexpr std::uint64_t align(std::uint64_t offset){
+    return (offset + 63) / 64 * 64;
+  }
+  // words of each row of bits
+  std::uint64_t words_per_row() const{
+    return (num_verts + BitMatrix::word_bits - 1) / BitMatrix::word_bits;
+  }
+  // position of the first weight
+  std::uint64_t weight_values_offset() const{
+    return align(weights_offset + (num_verts + 1) * sizeof(std::uint64_t));
+  }
+  // header of a graph with n vertices and e edges, weighing Weight
+  // (void for graphs without weights)
+  template<typename Weight>
+  static GraphFileHeader make(bool directed, std::uint64_t n, std::uint64_t e){
+    GraphFileHeader header {};
+    std::memcpy(header.magic, graph_magic, sizeof(magic));
+    header.version          = current_version;
+    header.byte_order       = native_byte_order;
+    header.flags            = directed ? std::uint32_t{directed_graph} : std::uint32_t{0};
+    header.num_verts        = n;
+    header.num_edges        = e;
+    header.adjacency_offset = sizeof(GraphFileHeader);
+    if constexpr (!std::is_void_v<Weight>){
+      header.weight_kind    = MatrixFileHeader::kind_of<Weight>();
+      header.weight_size    = sizeof(Weight);
+      header.weights_offset = align(header.adjacency_offset + n * header.words_per_row() * sizeof(word_type));
+    }
+
+    return header;
+  }
+  // whether this is the header of a graph (directed or not) weighing
+  // Weight, whose sections fit in a file of file_size bytes
+  template<typename Weight>
+  bool valid(bool directed, std::uint64_t file_size) const{
+    if (std::memcmp(magic, graph_magic, sizeof(magic)) != 0 || version != current_version
+        || byte_order != native_byte_order || ((flags & directed_graph) != 0) != directed){
+      return false;
+    }
+    if constexpr (std::is_void_v<Weight>){
+      if (weight_kind != 0 || weight_size != 0){
+        return false;
+      }
+    }
+    else if (weight_kind != MatrixFileHeader::kind_of<Weight>() || weight_size != sizeof(Weight)){
+      return false;
+    }
+    // count elements of size bytes fit at offset, checking for
+    // overflows
+    const auto fits {[file_size](std::uint64_t offset, std::uint64_t count, std::uint64_t size){
+      return offset % 64 == 0 && offset <= file_size && count <= (file_size - offset) / size;
+    }};
+    // rows of more vertices would not fit in any file, and their sizes
+    // could overflow
+    if (adjacency_offset < sizeof(GraphFileHeader) || num_verts > (std::uint64_t{1} << 32)
+        || !fits(adjacency_offset, num_verts * words_per_row(), sizeof(word_type))){
+      return false;
+    }
+    if constexpr (!std::is_void_v<Weight>){
+      return weights_offset >= adjacency_offset + num_verts * words_per_row() * sizeof(word_type)
+             && fits(weights_offset, num_verts + 1, sizeof(std::uint64_t))
+             && fits(weight_values_offset(), num_edges, sizeof(Weight));
+    }
+
+    return true;
+  }
+};
+static_assert(sizeof(GraphFileHeader) == 64, "graph file header must take 64 bytes");
+// helpers of graph files
+namespace graph_file_detail{
+  using size_type = std::size_t;
+  using word_type = bit_detail::word_type;
+  // what graph files need to know of each kind of graph: whether it is
+  // directed, what its weights are (void without weights), and where
+  // its edges are
+  template<typename GraphType>
+  struct Traits;
+  template<template<typename Type> typename MatrixType>
+  struct Traits<Digraph_<MatrixType>>{
+    static constexpr bool directed {true};
+    using Weight = void;
+
+    static const Digraph_<MatrixType>& structure(const Digraph_<MatrixType>& d){
+      return d;
+    }
+  };
+  template<template<typename Type> typename MatrixType>
+  struct Traits<Graph_<MatrixType>>{
+    static constexpr bool directed {false};
+    using Weight = void;
+
+    static const Graph_<MatrixType>& structure(const Graph_<MatrixType>& g){
+      return g;
+    }
+  };
+  template<typename WeightType>
+  struct Traits<WeightedGraph<WeightType>>{
+    static constexpr bool directed {false};
+    using Weight = WeightType;
+
+    static const Graph& structure(const WeightedGraph<WeightType>& g){
+      return g.graph();
+    }
+  };
+  // writes zeros up to position offset of file
+  inline void pad(std::ofstream& file, std::uint64_t offset){
+    static constexpr char zeros[64] {};
+    const auto position {static_cast<std::uint64_t>(file.tellp())};
+    if (position < offset){
+      file.write(zeros, static_cast<std::streamsize>(offset - position));
+    }
+  }
+  // number of bits of row set at positions from first to last - 1
+  inline size_type count_between(BitMatrix::ConstRow row, size_type first, size_type last){
+    const word_type* words {row.words()};
+    const size_type w_0 {first / BitMatrix::word_bits};
+    const size_type w_1 {last / BitMatrix::word_bits};
+    const word_type low  {~word_type{0} << (first % BitMatrix::word_bits)};
+    const word_type high {(word_type{1} << (last % BitMatrix::word_bits)) - 1};
+
+    if (w_0 == w_1){
+      return bit_detail::popcount(words[w_0] & low & high);
+    }
+    size_type total {bit_detail::popcount(words[w_0] & low)};
+    for (size_type w {w_0 + 1}; w < w_1; ++w){
+      total += bit_detail::popcount(words[w]);
+    }
+    if (high != 0){
+      total += bit_detail::popcount(words[w_1] & high);
+    }
+
+    return total;
+  }
+}
+// writes g, which may be a Digraph_, a Graph_ or a WeightedGraph, to
+// a graph file at path. Returns false if the file could not be
+// written
+template<typename GraphType>
+bool save_snapshot(const GraphType& g, const std::string& path){
+  using namespace graph_file_detail;
+  using Traits = graph_file_detail::Traits<GraphType>;
+  using Weight = typename Traits::Weight;
+
+  const auto& structure {Traits::structure(g)};
+  const size_type n {structure.num_verts};
+  const auto header {GraphFileHeader::make<Weight>(Traits::directed, n, g.num_edges)};
+  const size_type words {header.words_per_row()};
+
+  std::ofstream file {path, std::ios::binary | std::ios::trunc};
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  // rows of bits are written as they are in memory, and other rows are
+  // gathered first
+  std::vector<word_type> buffer (words);
+  for (size_type u {0}; u < n && file; ++u){
+    const word_type* row {buffer.data()};
+    if constexpr (graph_detail::has_neighbor_rows<std::decay_t<decltype(structure)>>::value){
+      row = structure.neighbor_row(u).words();
+    }
+    else{
+      std::fill(buffer.begin(), buffer.end(), word_type{0});
+      structure.for_each_neighbor(u, [&buffer](size_type v){
+        buffer[v / BitMatrix::word_bits] |= word_type{1} << (v % BitMatrix::word_bits);
+      });
+    }
+    file.write(reinterpret_cast<const char*>(row), static_cast<std::streamsize>(words * sizeof(word_type)));
+  }
+
+  if constexpr (!std::is_void_v<Weight>){
+    std::vector<std::uint64_t> start (n + 1, 0);
+    std::vector<Weight> weights {};
+    weights.reserve(g.num_edges);
+    for (size_type u {0}; u < n; ++u){
+      structure.for_each_neighbor(u, [&](size_type v){
+        if (u <= v){
+          weights.push_back(g.edge_weight(u, v));
+        }
+      });
+      start[u + 1] = weights.size();
+    }
+
+    pad(file, header.weights_offset);
+    file.write(reinterpret_cast<const char*>(start.data()), static_cast<std::streamsize>(start.size() * sizeof(std::uint64_t)));
+    pad(file, header.weight_values_offset());
+    file.write(reinterpret_cast<const char*>(weights.data()), static_cast<std::streamsize>(weights.size() * sizeof(Weight)));
+  }
+
+  return static_cast<bool>(file.flush());
+}
+// reads a graph of GraphType (a Digraph_, a Graph_ or a WeightedGraph)
+// from the graph file at path into memory. Rows of bits are read
+// straight into graphs stored as matrices of bits. Nothing is returned
+// if the file cannot be read, or does not hold a graph of GraphType,
+// or its edges do not match its header
+template<typename GraphType>
+std::optional<GraphType> load_snapshot(const std::string& path){
+  using namespace graph_file_detail;
+  using Traits = graph_file_detail::Traits<GraphType>;
+  using Weight = typename Traits::Weight;
+
+  std::ifstream file {path, std::ios::binary | std::ios::ate};
+  if (!file){
+    return {};
+  }
+  const std::uint64_t file_size {static_cast<std::uint64_t>(file.tellg())};
+
+  GraphFileHeader header {};
+  if (file_size < sizeof(header) || !file.seekg(0).read(reinterpret_cast<char*>(&header), sizeof(header))
+      || !header.valid<Weight>(Traits::directed, file_size)){
+    return {};
+  }
+
+  const size_type n {header.num_verts};
+  const size_type words {header.words_per_row()};
+  const auto read {[&](size_type first, size_type count, word_type* rows){
+    return static_cast<bool>(file.seekg(header.adjacency_offset + first * words * sizeof(word_type))
+                                 .read(reinterpret_cast<char*>(rows), count * words * sizeof(word_type)));
+  }};
+
+  if constexpr (std::is_void_v<Weight>){
+    auto g {GraphType::from_bit_rows(n, read)};
+    if (!g || g->num_edges != header.num_edges){
+      return {};
+    }
+
+    return g;
+  }
+  else{
+    const auto g {Graph::from_bit_rows(n, read)};
+    if (!g || g->num_edges != header.num_edges){
+      return {};
+    }
+    // edges {u, v}, u <= v, in the order of their weights
+    std::vector<std::pair<size_type, size_type>> edges {};
+    edges.reserve(g->num_edges);
+    for (size_type u {0}; u < n; ++u){
+      g->for_each_neighbor(u, [&](size_type v){
+        if (u <= v){
+          edges.push_back({u, v});
+        }
+      });
+    }
+    std::vector<Weight> weights (edges.size());
+    if (!file.seekg(header.weight_values_offset()).read(reinterpret_cast<char*>(weights.data()), weights.size() * sizeof(Weight))){
+      return {};
+    }
+
+    return WeightedGraph<Weight>::from_sorted_edges(n, edges, weights);
+  }
+}
+// read-only graph backed by a memory mapped graph file, holding a
+// graph of GraphType (a Digraph_, a Graph_ or a WeightedGraph).
+// Opening a file only maps it, so it takes constant time whatever the
+// size of the graph, and the operating system reads pages in lazily,
+// when rows are first accessed. Mapped graphs provide the neighbors of
+// each vertex, so traversals and other algorithms take them as they
+// take any other graph; mapped weighted graphs also provide weights.
+// As the file is never read whole, the bits past the last vertex of
+// each row are not known to be zero, as they are in a BitMatrix: they
+// are masked out whenever rows are read, so rows are not handed out as
+// BitMatrix rows
+template<typename GraphType>
+class MappedGraph{
+  using Traits = graph_file_detail::Traits<GraphType>;
+public:
+  // types of indices and weights
+  using size_type = std::size_t;
+  using Weight    = typename Traits::Weight;
+  // mapped graphs are directed whenever GraphType is
+  static constexpr bool directed {Traits::directed};
+private:
+  using word_type = bit_detail::word_type;
+  // pointer type of weights, which graphs without weights do not use
+  using weight_pointer = const std::conditional_t<std::is_void_v<Weight>, char, Weight>*;
+  // start and size of mapping
+  void*     mapping_;
+  size_type mapping_size_;
+  // rows of bits, position of the first weight of each vertex, and
+  // weights
+  const word_type*     rows_;
+  const std::uint64_t* start_;
+  weight_pointer       weights_;
+  size_type words_per_row_;
+  // number of vertices and edges
+  size_type num_verts_;
+  size_type num_edges_;
+  // row of bits of u, as stored in the file
+  BitMatrix::ConstRow row_(size_type u) const{
+    return {rows_ + u * words_per_row_, num_verts_};
+  }
+  // word w of the row of u, without the bits past the last vertex
+  word_type word_(size_type u, size_type w) const{
+    const size_type used {num_verts_ - w * BitMatrix::word_bits};
+    const word_type word {rows_[u * words_per_row_ + w]};
+
+    return used < BitMatrix::word_bits ? word & ((word_type{1} << used) - 1) : word;
+  }
+  // takes ownership of a mapping holding a valid header
+  MappedGraph(void* mapping, size_type mapping_size, const GraphFileHeader& header)
+    : mapping_{mapping}, mapping_size_{mapping_size},
+      rows_{reinterpret_cast<const word_type*>(static_cast<const char*>(mapping) + header.adjacency_offset)},
+      start_{nullptr}, weights_{nullptr}, words_per_row_{header.words_per_row()},
+      num_verts_{header.num_verts}, num_edges_{header.num_edges},
+      num_verts{num_verts_}, num_edges{num_edges_}
+  {
+    if constexpr (!std::is_void_v<Weight>){
+      start_   = reinterpret_cast<const std::uint64_t*>(static_cast<const char*>(mapping) + header.weights_offset);
+      weights_ = reinterpret_cast<weight_pointer>(static_cast<const char*>(mapping) + header.weight_values_offset());
+    }
+  }
+  // releases mapping, if any
+  void unmap_(){
+#ifdef __linux__
+    if (mapping_ != nullptr){
+      munmap(mapping_, mapping_size_);
+    }
+#endif
+    mapping_ = nullptr;
+  }
+  // takes the mapping of g, leaving it empty
+  void take_(MappedGraph& g){
+    mapping_       = g.mapping_;
+    mapping_size_  = g.mapping_size_;
+    rows_          = g.rows_;
+    start_         = g.start_;
+    weights_       = g.weights_;
+    words_per_row_ = g.words_per_row_;
+    num_verts_     = g.num_verts_;
+    num_edges_     = g.num_edges_;
+
+    g.mapping_       = nullptr;
+    g.words_per_row_ = 0;
+    g.num_verts_     = 0;
+    g.num_edges_     = 0;
+  }
+public:
+  // const references to the number of vertices and edges, respectively
+  const size_type& num_verts;
+  const size_type& num_edges;
+  // maps the graph file at path. Nothing is returned if the file
+  // cannot be mapped, or does not hold a graph of GraphType. Edges are
+  // not checked against the header, so that opening takes constant
+  // time. Mapping is only supported on Linux; elsewhere, use
+  // load_snapshot
+  static std::optional<MappedGraph> open(const std::string& path){
+#ifdef __linux__
+    const int descriptor {::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+    if (descriptor < 0){
+      return {};
+    }
+
+    struct stat status {};
+    if (fstat(descriptor, &status) != 0 || static_cast<std::uint64_t>(status.st_size) < sizeof(GraphFileHeader)){
+      close(descriptor);
+      return {};
+    }
+
+    const size_type size {static_cast<size_type>(status.st_size)};
+    void* mapping {mmap(nullptr, size, PROT_READ, MAP_SHARED, descriptor, 0)};
+    // the mapping stays valid once the file is closed
+    close(descriptor);
+    if (mapping == MAP_FAILED){
+      return {};
+    }
+
+    const auto& header {*static_cast<const GraphFileHeader*>(mapping)};
+    if (!header.valid<Weight>(directed, size)){
+      munmap(mapping, size);
+      return {};
+    }
+
+    return MappedGraph{mapping, size, header};
+#else
+    static_cast<void>(path);
+
+    return {};
+#endif
+  }
+  // mappings are not shared, but moved
+  MappedGraph(const MappedGraph&) = delete;
+  MappedGraph& operator=(const MappedGraph&) = delete;
+  MappedGraph(MappedGraph&& g)
+    : num_verts{num_verts_}, num_edges{num_edges_}
+  {
+    take_(g);
+  }
+  MappedGraph& operator=(MappedGraph&& g){
+    if (this != &g){
+      unmap_();
+      take_(g);
+    }
+
+    return *this;
+  }
+  ~MappedGraph(){
+    unmap_();
+  }
+  // determines whether there is an edge from u to v
+  bool has_edge(size_type u, size_type v) const{
+    return row_(u).test(v);
+  }
+  // returns the first vertex v, not smaller than from, such that there
+  // is an edge from u to v. Returns num_verts if there is none. Bits
+  // past the last vertex can only be found after every vertex
+  size_type next_neighbor(size_type u, size_type from) const{
+    return std::min(row_(u).find_next(from), num_verts_);
+  }
+  // calls function(v) for each edge from u to v, in increasing order
+  // of v
+  template<typename Function>
+  void for_each_neighbor(size_type u, Function function) const{
+    for (size_type w {0}; w < words_per_row_; ++w){
+      for (word_type word {word_(u, w)}; word != 0; word &= word - 1){
+        function(w * BitMatrix::word_bits + bit_detail::lowest_set(word));
+      }
+    }
+  }
+  // number of edges leaving u, which for undirected graphs is the
+  // degree of u
+  size_type out_degree(size_type u) const{
+    size_type total {0};
+    for (size_type w {0}; w < words_per_row_; ++w){
+      total += bit_detail::popcount(word_(u, w));
+    }
+
+    return total;
+  }
+  size_type degree(size_type u) const{
+    return out_degree(u);
+  }
+  // returns weight of edge between u and v, which is found by counting
+  // the edges of the smaller endpoint before the larger one. In case
+  // such an edge does not exist, returns default initialization value
+  // of Weight. Only provided by mapped weighted graphs. Opening a file
+  // does not read its starts of rows, nor whether its rows are
+  // symmetric, so a corrupt file could point anywhere: weights outside
+  // the row of u, or outside the weights section, are never read, and
+  // the default value is returned instead
+  template<typename W = Weight, typename = std::enable_if_t<!std::is_void_v<W>>>
+  W edge_weight(size_type u, size_type v) const{
+    if (!has_edge(u, v)){
+      return {};
+    }
+    if (u > v){
+      std::swap(u, v);
+    }
+    if (start_[u] > start_[u + 1] || start_[u + 1] > num_edges_){
+      return {};
+    }
+    const std::uint64_t index {start_[u] + graph_file_detail::count_between(row_(u), u, v)};
+
+    return index < start_[u + 1] ? weights_[index] : W{};
+  }
+};
+
+#endif
@@ -0,0 +1,343 @@
+// another way to achieve what #pragma once does
+#ifndef graph_loader_hpp
+#define graph_loader_hpp
+// numbers are parsed with from_chars, which neither allocates nor
+// depends on locales
+#include <charconv>
+// files are read through streams when they cannot be mapped
+#include <fstream>
+// parsing may fail
+#include <optional>
+// errors are described by strings, and text is seen through views
+#include <string>
+#include <string_view>
+// per chunk results are kept in vectors
+#include <vector>
+// files are memory mapped through POSIX calls
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+// weights are loaded into matrices and weighted graphs
+#include <matrix.hpp>
+#include <weighted_graph.hpp>
+// large files are parsed in parallel
+#include <thread_pool.hpp>
+// position (both 1-based) and description of the first error found
+// while loading a file. Errors not related to a position in the text,
+// such as files that cannot be opened, have line 0
+struct ParseError{
+  std::size_t line;
+  std::size_t column;
+  std::string message;
+};
+// loaders of weighted graph files: a number of vertices n, followed by
+// the n x n weight matrix, linewise. Weights are separated by any
+// whitespace, and a zero weight means there is no edge
+namespace graph_loader_detail{
+  using size_type = std::size_t;
+  // text of at least this many bytes is split in chunks parsed in
+  // parallel
+  constexpr size_type chunk_size {size_type{1} << 20};
+
+  inline bool is_space(char c){
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+  }
+  // line and column of position offset of text
+  inline void locate(std::string_view text, size_type offset, ParseError& error){
+    error.line   = 1;
+    error.column = 1;
+    for (size_type k {0}; k < offset && k < text.size(); ++k){
+      if (text[k] == '\n'){
+        ++error.line;
+        error.column = 1;
+      }
+      else{
+        ++error.column;
+      }
+    }
+  }
+  // reports an error at position offset of text, if asked to
+  inline void fail(std::string_view text, size_type offset, std::string message, ParseError* error){
+    if (error != nullptr){
+      locate(text, offset, *error);
+      error->message = std::move(message);
+    }
+  }
+  // position of the first token at or after offset
+  inline size_type skip_spaces(std::string_view text, size_type offset){
+    while (offset < text.size() && is_space(text[offset])){
+      ++offset;
+    }
+
+    return offset;
+  }
+  // position right after the token starting at offset
+  inline size_type token_end(std::string_view text, size_type offset){
+    while (offset < text.size() && !is_space(text[offset])){
+      ++offset;
+    }
+
+    return offset;
+  }
+  // number of tokens in text[first, last)
+  inline size_type count_tokens(std::string_view text, size_type first, size_type last){
+    size_type count {0};
+    bool in_token {false};
+
+    for (size_type k {first}; k < last; ++k){
+      const bool space {is_space(text[k])};
+      count += in_token && space;
+      in_token = !space;
+    }
+
+    return count + in_token;
+  }
+  // parses the token text[first, last) into value. Returns an empty
+  // string on success and a description of the problem otherwise
+  template<typename Value>
+  std::string parse_token(std::string_view text, size_type first, size_type last, Value& value){
+    const auto [end, status] {std::from_chars(text.data() + first, text.data() + last, value)};
+
+    if (status == std::errc::result_out_of_range){
+      return "number out of range";
+    }
+    if (status != std::errc{} || end != text.data() + last){
+      return "invalid number '" + std::string{text.substr(first, last - first)} + "'";
+    }
+
+    return {};
+  }
+  // parses the weights in text[body, end) into m, whose n * n
+  // elements receive consecutive weights. Chunks of text end at line
+  // boundaries, so no weight is split; they are first counted, so
+  // each chunk knows where its weights go, and then parsed, all in
+  // parallel. Only the first error, in text order, is reported
+  template<typename Weight>
+  bool parse_weights(std::string_view text, size_type body, Matrix<Weight>& m, ParseError* error, ThreadPool& pool){
+    const size_type n {m.num_rows};
+    const size_type expected {n * n};
+    // chunk boundaries, right after new lines
+    std::vector<size_type> bound {body};
+    for (size_type k {body + chunk_size}; k < text.size(); k += chunk_size){
+      const size_type line_end {text.find('\n', std::max(k, bound.back()))};
+      if (line_end == std::string_view::npos){
+        break;
+      }
+      bound.push_back(line_end + 1);
+    }
+    bound.push_back(text.size());
+    const size_type chunks {bound.size() - 1};
+    // index of first weight of each chunk
+    std::vector<size_type> first_index (chunks + 1, 0);
+    pool.parallel_for(0, chunks, [&](size_type first, size_type last){
+      for (size_type c {first}; c < last; ++c){
+        first_index[c + 1] = count_tokens(text, bound[c], bound[c + 1]);
+      }
+    });
+    for (size_type c {0}; c < chunks; ++c){
+      first_index[c + 1] += first_index[c];
+    }
+    // position and description of first error of each chunk
+    std::vector<size_type>    error_offset (chunks, text.size());
+    std::vector<std::string>  error_message (chunks);
+    pool.parallel_for(0, chunks, [&](size_type first, size_type last){
+      for (size_type c {first}; c < last; ++c){
+        size_type index {first_index[c]};
+        for (size_type k {skip_spaces(text, bound[c])}; k < bound[c + 1]; k = skip_spaces(text, k)){
+          const size_type end {token_end(text, k)};
+          if (index >= expected){
+            error_offset[c]  = k;
+            error_message[c] = "expected " + std::to_string(expected) + " weights, found more";
+            break;
+          }
+          Weight w {};
+          std::string problem {parse_token(text, k, end, w)};
+          if (!problem.empty()){
+            error_offset[c]  = k;
+            error_message[c] = std::move(problem);
+            break;
+          }
+          m.at(index / n, index % n) = w;
+          ++index;
+          k = end;
+        }
+      }
+    });
+
+    for (size_type c {0}; c < chunks; ++c){
+      if (!error_message[c].empty()){
+        fail(text, error_offset[c], std::move(error_message[c]), error);
+        return false;
+      }
+    }
+    if (first_index[chunks] < expected){
+      fail(text, text.size(), "expected " + std::to_string(expected) + " weights, found " + std::to_string(first_index[chunks]), error);
+      return false;
+    }
+
+    return true;
+  }
+  // position of the token holding weight (i, j) of a text which has
+  // been parsed successfully. Only used to report errors
+  inline size_type weight_offset(std::string_view text, size_type n, size_type i, size_type j){
+    // the first token is the number of vertices
+    size_type k {token_end(text, skip_spaces(text, 0))};
+    for (size_type index {0}; index <= i * n + j; ++index){
+      k = skip_spaces(text, k);
+      if (index < i * n + j){
+        k = token_end(text, k);
+      }
+    }
+
+    return k;
+  }
+  // calls f with the whole text of file at path, which is memory
+  // mapped when possible. Returns false if the file cannot be read
+  template<typename Function>
+  bool with_file_text(const std::string& path, Function f){
+#ifdef __linux__
+    const int descriptor {::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+    if (descriptor < 0){
+      return false;
+    }
+    struct stat status {};
+    if (fstat(descriptor, &status) != 0){
+      close(descriptor);
+      return false;
+    }
+    const size_type size {static_cast<size_type>(status.st_size)};
+    void* mapping {size > 0 ? mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0) : MAP_FAILED};
+    close(descriptor);
+    if (mapping != MAP_FAILED){
+      // pages are read once, front to back
+      madvise(mapping, size, MADV_SEQUENTIAL);
+      f(std::string_view{static_cast<const char*>(mapping), size});
+      munmap(mapping, size);
+
+      return true;
+    }
+#endif
+    // empty files and files which cannot be mapped are read
+    std::ifstream file {path, std::ios::binary};
+    if (!file){
+      return false;
+    }
+    const std::string text {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    f(std::string_view{text});
+
+    return true;
+  }
+}
+// parses a weight matrix from text. Returns nothing, filling error (if
+// given) with the position and cause of the first problem, when text
+// does not hold a number of vertices n followed by exactly n * n
+// weights
+template<typename Weight = int>
+std::optional<Matrix<Weight>> parse_weight_matrix(std::string_view text, ParseError* error = nullptr,
+                                                  ThreadPool& pool = ThreadPool::shared()){
+  using namespace graph_loader_detail;
+
+  const size_type first {skip_spaces(text, 0)};
+  const size_type last  {token_end(text, first)};
+  if (first == text.size()){
+    fail(text, first, "expected number of vertices", error);
+    return {};
+  }
+
+  size_type n {};
+  std::string problem {parse_token(text, first, last, n)};
+  if (!problem.empty()){
+    fail(text, first, std::move(problem), error);
+    return {};
+  }
+
+  // each weight takes at least one character, which bounds n before
+  // anything is allocated
+  if (n > 0 && (text.size() - last) / n < n){
+    fail(text, first, "too many vertices for the size of the text", error);
+    return {};
+  }
+
+  Matrix<Weight> m {n, n};
+  if (!parse_weights(text, last, m, error, pool)){
+    return {};
+  }
+
+  return m;
+}
+// parses a weighted graph from text, whose weight matrix must be
+// symmetric with a zero diagonal. Returns nothing, filling error (if
+// given), otherwise
+template<typename Weight = int>
+std::optional<WeightedGraph<Weight>> parse_weighted_graph(std::string_view text, ParseError* error = nullptr,
+                                                          ThreadPool& pool = ThreadPool::shared()){
+  using namespace graph_loader_detail;
+
+  const auto m {parse_weight_matrix<Weight>(text, error, pool)};
+  if (!m){
+    return {};
+  }
+
+  const size_type n {m->num_rows};
+  // edges {u, v}, u < v, in the order the matrix lists them
+  std::vector<std::pair<size_type, size_type>> edges {};
+  for (size_type u {0}; u < n; ++u){
+    if (m->const_at(u, u) != Weight{}){
+      fail(text, weight_offset(text, n, u, u), "vertex " + std::to_string(u) + " has a loop", error);
+      return {};
+    }
+    for (size_type v {u + 1}; v < n; ++v){
+      if (m->const_at(u, v) != m->const_at(v, u)){
+        fail(text, weight_offset(text, n, v, u), "weight differs from its symmetric", error);
+        return {};
+      }
+      if (m->const_at(u, v) != Weight{}){
+        edges.push_back({u, v});
+      }
+    }
+  }
+  std::vector<Weight> weights (edges.size());
+  for (size_type k {0}; k < edges.size(); ++k){
+    weights[k] = m->const_at(edges[k].first, edges[k].second);
+  }
+
+  return WeightedGraph<Weight>::from_sorted_edges(n, edges, weights, pool);
+}
+// loaders of files, which are memory mapped (when possible) and then
+// parsed. Files that cannot be read are reported as errors at line 0
+template<typename Weight = int>
+std::optional<Matrix<Weight>> load_weight_matrix(const std::string& path, ParseError* error = nullptr,
+                                                 ThreadPool& pool = ThreadPool::shared()){
+  std::optional<Matrix<Weight>> result {};
+
+  if (!graph_loader_detail::with_file_text(path, [&](std::string_view text){ result = parse_weight_matrix<Weight>(text, error, pool); })
+      && error != nullptr){
+    *error = {0, 0, "cannot read " + path};
+  }
+
+  return result;
+}
+template<typename Weight = int>
+std::optional<WeightedGraph<Weight>> load_weighted_graph(const std::string& path, ParseError* error = nullptr,
+                                                         ThreadPool& pool = ThreadPool::shared()){
+  std::optional<WeightedGraph<Weight>> result {};
+
+  const auto parse {[&](std::string_view text){
+    // graphs are not assignable, so they are moved into result
+    if (auto graph {parse_weighted_graph<Weight>(text, error, pool)}){
+      result.emplace(std::move(*graph));
+    }
+  }};
+
+  if (!graph_loader_detail::with_file_text(path, parse)
+      && error != nullptr){
+    *error = {0, 0, "cannot read " + path};
+  }
+
+  return result;
+}
+
+#endif
@@ -0,0 +1,311 @@
+// another way to achieve what #pragma once does
+#ifndef lu_decomposition_hpp
+#define lu_decomposition_hpp
+// absolute values when choosing pivots
+#include <cmath>
+// inverses may not exist
+#include <optional>
+// pivots are kept in a vector
+#include <vector>
+// we factorize square matrices, using the blocked product kernels
+#include <matrix.hpp>
+// trailing updates are done in parallel
+#include <thread_pool.hpp>
+// LU factorization with partial pivoting, PA = LU, of a square matrix
+// of floating point Type: L is unit lower triangular and U is upper
+// triangular, and both are stored in the same matrix (the unit
+// diagonal of L is not stored). The factorization is blocked and
+// right-looking: a panel of block_size columns is factorized, the
+// corresponding rows of U are solved for, and the trailing matrix
+// receives a rank-block_size update through the matrix product
+// kernels, split by rows among threads
+template<typename Type, typename Storage = PackedRows>
+class LUDecomposition{
+  static_assert(std::is_floating_point_v<Type>, "LU factorization needs a floating point type");
+public:
+  using size_type = std::size_t;
+  using Data      = SquareMatrix<Type, Storage>;
+  // number of columns of each panel
+  static constexpr size_type block_size {64};
+private:
+  // L and U factors
+  Data lu_;
+  // row k was exchanged with row pivots_[k] (which is not above it)
+  // when column k was eliminated
+  std::vector<size_type> pivots_;
+  // whether some pivot is zero
+  bool singular_;
+  // number of exchanged rows is even
+  bool even_;
+  // factorizes columns [k_0, k_1) of rows [k_0, n), exchanging whole
+  // rows when pivoting
+  void factorize_panel_(size_type k_0, size_type k_1, ThreadPool& pool){
+    const size_type n {lu_.num_rows};
+
+    for (size_type k {k_0}; k < k_1; ++k){
+      // largest element (in absolute value) on or below diagonal
+      size_type pivot {k};
+      for (size_type i {k + 1}; i < n; ++i){
+        if (std::abs(lu_.const_at(i, k)) > std::abs(lu_.const_at(pivot, k))){
+          pivot = i;
+        }
+      }
+      pivots_[k] = pivot;
+
+      if (pivot != k){
+        lu_.row(k).swap(lu_.row(pivot));
+        even_ = !even_;
+      }
+
+      const Type diagonal {lu_.const_at(k, k)};
+      if (diagonal == Type{}){
+        singular_ = true;
+        continue;
+      }
+      // eliminates column k below diagonal, updating the rest of panel
+      const Type* u_k {&lu_.at(k, 0)};
+      pool.parallel_for(k + 1, n, [this, k, k_1, diagonal, u_k](size_type first, size_type last){
+        for (size_type i {first}; i < last; ++i){
+          Type* a_i {&lu_.at(i, 0)};
+          const Type l_ik {a_i[k] / diagonal};
+          a_i[k] = l_ik;
+          for (size_type j {k + 1}; j < k_1; ++j){
+            a_i[j] -= l_ik * u_k[j];
+          }
+        }
+      }, 256);
+    }
+  }
+  // solves L_11 U_12 = A_12 for the rows [k_0, k_1) of U right of the
+  // panel, in place. Columns are split among threads
+  void solve_block_row_(size_type k_0, size_type k_1, ThreadPool& pool){
+    const size_type n {lu_.num_rows};
+
+    pool.parallel_for(k_1, n, [this, k_0, k_1](size_type first, size_type last){
+      for (size_type i {k_0 + 1}; i < k_1; ++i){
+        Type* a_i {&lu_.at(i, 0)};
+        for (size_type p {k_0}; p < i; ++p){
+          const Type  l_ip {a_i[p]};
+          const Type* u_p  {&lu_.at(p, 0)};
+          for (size_type j {first}; j < last; ++j){
+            a_i[j] -= l_ip * u_p[j];
+          }
+        }
+      }
+    }, 256);
+  }
+  // copies the negated block of factors in rows [i_0, i_1) and
+  // columns [k_0, k_1) into buffer, linewise. As products only
+  // accumulate, blocks to be subtracted are negated first
+  void negate_block_(size_type i_0, size_type i_1, size_type k_0, size_type k_1, std::vector<Type>& buffer) const{
+    const size_type kb {k_1 - k_0};
+
+    buffer.resize((i_1 - i_0) * kb);
+    for (size_type i {i_0}; i < i_1; ++i){
+      for (size_type p {0}; p < kb; ++p){
+        buffer[(i - i_0) * kb + p] = -lu_.const_at(i, k_0 + p);
+      }
+    }
+  }
+  // A_22 -= L_21 U_12, for the trailing matrix below and right of
+  // block [k_0, k_1)
+  void update_trailing_(size_type k_0, size_type k_1, ThreadPool& pool, std::vector<Type>& l_21){
+    const size_type n  {lu_.num_rows};
+    const size_type kb {k_1 - k_0};
+    const size_type m  {n - k_1};
+
+    negate_block_(k_1, n, k_0, k_1, l_21);
+
+    const size_type stride {lu_.stride()};
+    Type* u_12 {&lu_.at(k_0, k_1)};
+    Type* a_22 {&lu_.at(k_1, k_1)};
+
+    pool.parallel_for(0, m, [&](size_type first, size_type last){
+      matrix_detail::gemm(last - first, m, kb,
+                          l_21.data() + first * kb, kb,
+                          u_12, stride,
+                          a_22 + first * stride, stride);
+    }, block_size);
+  }
+public:
+  // factorizes a, which is moved (or copied) into the decomposition
+  explicit LUDecomposition(Data a, ThreadPool& pool = ThreadPool::shared())
+    : lu_{std::move(a)}, pivots_(lu_.num_rows), singular_{false}, even_{true}
+  {
+    const size_type n {lu_.num_rows};
+    std::vector<Type> buffer {};
+
+    for (size_type k_0 {0}; k_0 < n; k_0 += block_size){
+      const size_type k_1 {std::min(n, k_0 + block_size)};
+
+      factorize_panel_(k_0, k_1, pool);
+
+      if (k_1 < n){
+        solve_block_row_(k_0, k_1, pool);
+        update_trailing_(k_0, k_1, pool, buffer);
+      }
+    }
+  }
+  // dimension of factorized matrix
+  size_type size() const{
+    return lu_.num_rows;
+  }
+  // whether factorized matrix is singular
+  bool singular() const{
+    return singular_;
+  }
+  // L and U factors, stored together
+  const Data& factors() const{
+    return lu_;
+  }
+  // row exchanges, in the order they were made
+  const std::vector<size_type>& pivots() const{
+    return pivots_;
+  }
+  // determinant: product of the diagonal of U, negated for an odd
+  // number of row exchanges
+  Type determinant() const{
+    Type result {even_ ? Type{1} : Type{-1}};
+
+    for (size_type k {0}; k < size(); ++k){
+      result *= lu_.const_at(k, k);
+    }
+
+    return result;
+  }
+  // solves A X = B in place, B having size() rows and any number of
+  // columns. Returns false (doing nothing) if A is singular or
+  // dimensions disagree. Substitutions are blocked as the
+  // factorization is: the rows of a block of block_size rows are solved
+  // for, and then subtracted from the remaining rows through the matrix
+  // product kernels. Columns of B are split among threads
+  template<typename StorageB>
+  bool solve(Matrix<Type, StorageB>& b, ThreadPool& pool = ThreadPool::shared()) const{
+    const size_type n {size()};
+
+    if (singular_ || b.num_rows != n){
+      return false;
+    }
+
+    const size_type m      {b.num_cols};
+    const size_type stride {b.stride()};
+    std::vector<Type> buffer {};
+    // applies row exchanges ...
+    for (size_type k {0}; k < n; ++k){
+      if (pivots_[k] != k){
+        b.row(k).swap(b.row(pivots_[k]));
+      }
+    }
+    // ... then forward substitution with L, from the first block down
+    // ...
+    for (size_type k_0 {0}; k_0 < n; k_0 += block_size){
+      const size_type k_1 {std::min(n, k_0 + block_size)};
+      negate_block_(k_1, n, k_0, k_1, buffer);
+
+      pool.parallel_for(0, m, [&](size_type first, size_type last){
+        for (size_type i {k_0 + 1}; i < k_1; ++i){
+          Type* b_i {&b.at(i, 0)};
+          for (size_type p {k_0}; p < i; ++p){
+            const Type  l_ip {lu_.const_at(i, p)};
+            const Type* b_p  {&b.at(p, 0)};
+            for (size_type j {first}; j < last; ++j){
+              b_i[j] -= l_ip * b_p[j];
+            }
+          }
+        }
+        if (k_1 < n){
+          matrix_detail::gemm(n - k_1, last - first, k_1 - k_0,
+                              buffer.data(), k_1 - k_0,
+                              &b.at(k_0, first), stride,
+                              &b.at(k_1, first), stride);
+        }
+      }, block_size);
+    }
+    // ... and back substitution with U, from the last block up
+    for (size_type k_1 {n}; k_1 > 0;){
+      const size_type k_0 {(k_1 - 1) / block_size * block_size};
+      negate_block_(0, k_0, k_0, k_1, buffer);
+
+      pool.parallel_for(0, m, [&](size_type first, size_type last){
+        for (size_type i {k_1}; i-- > k_0;){
+          Type* b_i {&b.at(i, 0)};
+          for (size_type p {i + 1}; p < k_1; ++p){
+            const Type  u_ip {lu_.const_at(i, p)};
+            const Type* b_p  {&b.at(p, 0)};
+            for (size_type j {first}; j < last; ++j){
+              b_i[j] -= u_ip * b_p[j];
+            }
+          }
+          const Type u_ii {lu_.const_at(i, i)};
+          for (size_type j {first}; j < last; ++j){
+            b_i[j] /= u_ii;
+          }
+        }
+        if (k_0 > 0){
+          matrix_detail::gemm(k_0, last - first, k_1 - k_0,
+                              buffer.data(), k_1 - k_0,
+                              &b.at(k_0, first), stride,
+                              &b.at(0, first), stride);
+        }
+      }, block_size);
+      k_1 = k_0;
+    }
+
+    return true;
+  }
+  // solves A x = b in place. Returns false (doing nothing) if A is
+  // singular or dimensions disagree
+  bool solve(std::vector<Type>& b, ThreadPool& pool = ThreadPool::shared()) const{
+    if (singular_ || b.size() != size()){
+      return false;
+    }
+
+    Matrix<Type> column {size(), 1};
+    for (size_type i {0}; i < size(); ++i){
+      column.at(i, 0) = b[i];
+    }
+
+    solve(column, pool);
+
+    for (size_type i {0}; i < size(); ++i){
+      b[i] = column.at(i, 0);
+    }
+
+    return true;
+  }
+  // returns the inverse of A, unless A is singular. The identity is
+  // solved for, its columns split among threads of pool
+  std::optional<SquareMatrix<Type>> inverse(ThreadPool& pool = ThreadPool::shared()) const{
+    if (singular_){
+      return {};
+    }
+
+    SquareMatrix<Type> result {size()};
+    result = Type{};
+    for (size_type i {0}; i < size(); ++i){
+      result.at(i, i) = Type{1};
+    }
+
+    solve(result, pool);
+
+    return result;
+  }
+};
+// determinant of a, computed through its LU factorization
+template<typename Type, typename Storage>
+Type determinant(const SquareMatrix<Type, Storage>& a, ThreadPool& pool = ThreadPool::shared()){
+  return LUDecomposition<Type, Storage>{a, pool}.determinant();
+}
+// inverse of a, unless it is singular
+template<typename Type, typename Storage>
+std::optional<SquareMatrix<Type>> inverse(const SquareMatrix<Type, Storage>& a, ThreadPool& pool = ThreadPool::shared()){
+  return LUDecomposition<Type, Storage>{a, pool}.inverse(pool);
+}
+// solves a x = b in place. Returns false (doing nothing) if a is
+// singular or dimensions disagree
+template<typename Type, typename Storage, typename RightHandSide>
+bool solve(const SquareMatrix<Type, Storage>& a, RightHandSide& b, ThreadPool& pool = ThreadPool::shared()){
+  return LUDecomposition<Type, Storage>{a, pool}.solve(b, pool);
+}
+
+#endif
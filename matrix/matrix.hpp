@@ -3,72 +3,876 @@
 #define matrix_hpp
 // we are going to use swap
 #include <algorithm>
+// huge pages are requested through mmap on Linux
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+// for comparing addresses of distinct views
+#include <functional>
+// size_t is used by the multiplication kernels
+#include <cstddef>
+// fixed width integer types used by multiplication kernels
+#include <cstdint>
 // for defining how to print a matrix
 #include <iostream>
+// results of parallel reductions are gathered under a mutex
+#include <mutex>
+// aligned allocation
+#include <new>
+// multiplication may have no result when dimensions disagree
+#include <optional>
+// type traits select the multiplication kernel of each Type
+#include <type_traits>
+// declval is used to detect expression operands
+#include <utility>
 // we are going to store our matrices using vector
 #include <vector>
-// class to represent a general matrix
+// element-wise maps and reductions run in parallel
+#include <thread_pool.hpp>
+// SIMD intrinsics, available only when compiling for a target that
+// supports them (see ENABLE_NATIVE_ARCH)
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#endif
+// expression templates. Arithmetic on matrices (see operators at the
+// end of this file) does not compute anything: it builds a tree of
+// lightweight nodes describing the computation, which is only
+// evaluated, position by position and in a single pass, when it is
+// assigned to a matrix, row or column. This way, an expression such
+// as a + b * 2 - d creates no temporary matrix. Every node provides
+// the number of rows and columns of its result, whether its operands
+// have agreeing dimensions, the element at each position, and
+// whether it reads from a range of addresses, so that assignments can
+// tell when their target is also a source
+namespace matrix_detail{
+  // we use the same size_type as Matrix
+  using size_type = std::size_t;
+  // determines whether the nonempty address ranges [a_begin, a_end)
+  // and [b_begin, b_end) intersect
+  inline bool intersect(const void* a_begin, const void* a_end, const void* b_begin, const void* b_end){
+    const std::less<const void*> less {};
+
+    return less(a_begin, a_end) && less(b_begin, b_end) && less(a_begin, b_end) && less(b_begin, a_end);
+  }
+  // whether the elements of matrix m lie in [begin, end)
+  template<typename MatrixType>
+  bool stored_in(const MatrixType& m, const void* begin, const void* end){
+    return intersect(m.data(), m.data() + m.num_rows * m.stride(), begin, end);
+  }
+  // leaf node referring to a whole matrix
+  template<typename MatrixType>
+  class MatrixOperand{
+    const MatrixType& matrix_;
+  public:
+    using value_type = typename MatrixType::value_type;
+
+    MatrixOperand(const MatrixType& matrix) : matrix_{matrix}
+    {}
+
+    size_type rows() const{
+      return matrix_.num_rows;
+    }
+    size_type cols() const{
+      return matrix_.num_cols;
+    }
+    bool conformable() const{
+      return true;
+    }
+    value_type element(size_type i, size_type j) const{
+      return matrix_.const_at(i, j);
+    }
+    bool reads(const void* begin, const void* end) const{
+      return stored_in(matrix_, begin, end);
+    }
+  };
+  // leaf node holding a (cheap to copy) view
+  template<typename ViewType>
+  class ViewOperand{
+    ViewType view_;
+  public:
+    using value_type = typename ViewType::value_type;
+
+    ViewOperand(const ViewType& view) : view_{view}
+    {}
+
+    size_type rows() const{
+      return view_.num_rows;
+    }
+    size_type cols() const{
+      return view_.num_cols;
+    }
+    bool conformable() const{
+      return true;
+    }
+    value_type element(size_type i, size_type j) const{
+      return view_.const_at(i, j);
+    }
+    bool reads(const void* begin, const void* end) const{
+      if (view_.num_rows == 0 || view_.num_cols == 0){
+        return false;
+      }
+
+      return intersect(view_.data(), &view_.at(view_.num_rows - 1, view_.num_cols - 1) + 1, begin, end);
+    }
+  };
+  // leaf node referring to a row of a matrix, seen as a 1 x n matrix
+  template<typename MatrixType>
+  class RowOperand{
+    const MatrixType& parent_;
+    size_type         row_index_;
+  public:
+    using value_type = typename MatrixType::value_type;
+
+    RowOperand(const MatrixType& parent, size_type row_index)
+      : parent_{parent}, row_index_{row_index}
+    {}
+
+    size_type rows() const{
+      return 1;
+    }
+    size_type cols() const{
+      return parent_.num_cols;
+    }
+    bool conformable() const{
+      return true;
+    }
+    value_type element(size_type, size_type j) const{
+      return parent_.const_at(row_index_, j);
+    }
+    // rows and columns are checked as their whole matrices
+    bool reads(const void* begin, const void* end) const{
+      return stored_in(parent_, begin, end);
+    }
+  };
+  // leaf node referring to a column of a matrix, seen as a n x 1
+  // matrix
+  template<typename MatrixType>
+  class ColOperand{
+    const MatrixType& parent_;
+    size_type         col_index_;
+  public:
+    using value_type = typename MatrixType::value_type;
+
+    ColOperand(const MatrixType& parent, size_type col_index)
+      : parent_{parent}, col_index_{col_index}
+    {}
+
+    size_type rows() const{
+      return parent_.num_rows;
+    }
+    size_type cols() const{
+      return 1;
+    }
+    bool conformable() const{
+      return true;
+    }
+    value_type element(size_type i, size_type) const{
+      return parent_.const_at(i, col_index_);
+    }
+    bool reads(const void* begin, const void* end) const{
+      return stored_in(parent_, begin, end);
+    }
+  };
+  // node combining elements at the same position of two expressions
+  // of equal dimensions. Nodes are small, so they are held by value
+  template<typename Left, typename Right, typename Operation>
+  class BinaryExpression{
+    Left      left_;
+    Right     right_;
+    Operation operation_;
+  public:
+    using value_type = typename Left::value_type;
+
+    BinaryExpression(Left left, Right right, Operation operation)
+      : left_{left}, right_{right}, operation_{operation}
+    {}
+
+    size_type rows() const{
+      return left_.rows();
+    }
+    size_type cols() const{
+      return left_.cols();
+    }
+    bool conformable() const{
+      return left_.conformable() && right_.conformable()
+        && left_.rows() == right_.rows() && left_.cols() == right_.cols();
+    }
+    value_type element(size_type i, size_type j) const{
+      return operation_(left_.element(i, j), right_.element(i, j));
+    }
+    bool reads(const void* begin, const void* end) const{
+      return left_.reads(begin, end) || right_.reads(begin, end);
+    }
+    // an expression is an operand of larger expressions
+    friend BinaryExpression make_operand(const BinaryExpression& e){
+      return e;
+    }
+  };
+  // node applying a function to each element of an expression
+  template<typename Operand, typename Function>
+  class UnaryExpression{
+    Operand  operand_;
+    Function function_;
+  public:
+    using value_type = std::decay_t<std::invoke_result_t<const Function&, typename Operand::value_type>>;
+
+    UnaryExpression(Operand operand, Function function)
+      : operand_{operand}, function_{function}
+    {}
+
+    size_type rows() const{
+      return operand_.rows();
+    }
+    size_type cols() const{
+      return operand_.cols();
+    }
+    bool conformable() const{
+      return operand_.conformable();
+    }
+    value_type element(size_type i, size_type j) const{
+      return function_(operand_.element(i, j));
+    }
+    bool reads(const void* begin, const void* end) const{
+      return operand_.reads(begin, end);
+    }
+
+    friend UnaryExpression make_operand(const UnaryExpression& e){
+      return e;
+    }
+  };
+  // element-wise operations
+  struct Plus{
+    template<typename Type>
+    Type operator()(const Type& a, const Type& b) const{
+      return a + b;
+    }
+  };
+  struct Minus{
+    template<typename Type>
+    Type operator()(const Type& a, const Type& b) const{
+      return a - b;
+    }
+  };
+  struct Times{
+    template<typename Type>
+    Type operator()(const Type& a, const Type& b) const{
+      return a * b;
+    }
+  };
+  struct Negate{
+    template<typename Type>
+    Type operator()(const Type& a) const{
+      return -a;
+    }
+  };
+  // multiplication by a scalar, on either side
+  template<typename Type>
+  struct ScaleLeft{
+    Type scalar;
+
+    Type operator()(const Type& a) const{
+      return scalar * a;
+    }
+  };
+  template<typename Type>
+  struct ScaleRight{
+    Type scalar;
+
+    Type operator()(const Type& a) const{
+      return a * scalar;
+    }
+  };
+  // Matrix, its rows and columns, and expressions provide a
+  // make_operand friend, so any of them can appear in an expression
+  template<typename T, typename = void>
+  struct is_operand : std::false_type{};
+  template<typename T>
+  struct is_operand<T, std::void_t<decltype(make_operand(std::declval<const T&>()))>> : std::true_type{};
+  template<typename T>
+  constexpr bool is_operand_v {is_operand<T>::value};
+  // node type corresponding to an operand
+  template<typename T>
+  using operand_t = decltype(make_operand(std::declval<const T&>()));
+  // copies the value of expression e into each position of target,
+  // accessed by (i, j) through at. Row by row, the innermost loop
+  // walks consecutive positions, which compilers can vectorize
+  template<typename Target, typename Expression>
+  void evaluate(Target& target, const Expression& e){
+    const size_type rows {e.rows()};
+    const size_type cols {e.cols()};
+
+    for (size_type i {0}; i < rows; ++i){
+      for (size_type j {0}; j < cols; ++j){
+        target.at(i, j) = e.element(i, j);
+      }
+    }
+  }
+}
+// allocator of memory aligned to alignment bytes, so that aligned
+// (SIMD) loads can be used on the first element of each row
+template<typename Type, std::size_t alignment = 64>
+class AlignedAllocator{
+public:
+  using value_type = Type;
+  // allocators of other types use the same alignment
+  template<typename Other>
+  struct rebind{
+    using other = AlignedAllocator<Other, alignment>;
+  };
+
+  AlignedAllocator() = default;
+  template<typename Other>
+  AlignedAllocator(const AlignedAllocator<Other, alignment>&)
+  {}
+
+  Type* allocate(std::size_t n){
+    return static_cast<Type*>(::operator new(n * sizeof(Type), std::align_val_t{alignment}));
+  }
+  void deallocate(Type* p, std::size_t){
+    ::operator delete(p, std::align_val_t{alignment});
+  }
+  // any allocator can free memory of any other
+  template<typename Other>
+  bool operator==(const AlignedAllocator<Other, alignment>&) const{
+    return true;
+  }
+  template<typename Other>
+  bool operator!=(const AlignedAllocator<Other, alignment>&) const{
+    return false;
+  }
+};
+// allocator backed by huge (2 MiB) pages, which cut the number of TLB
+// misses when traversing very large matrices. If the system has no
+// huge pages reserved, transparent huge pages are requested instead;
+// on systems other than Linux, this is just an aligned allocator
+template<typename Type>
+class HugePageAllocator{
+  // size of a huge page
+  static constexpr std::size_t page_size_ {std::size_t{2} << 20};
+  // mappings are made of whole huge pages
+  static std::size_t mapping_size_(std::size_t n){
+    return (n * sizeof(Type) + page_size_ - 1) / page_size_ * page_size_;
+  }
+public:
+  using value_type = Type;
+
+  HugePageAllocator() = default;
+  template<typename Other>
+  HugePageAllocator(const HugePageAllocator<Other>&)
+  {}
+
+  Type* allocate(std::size_t n){
+#ifdef __linux__
+    const std::size_t size {mapping_size_(n)};
+    // explicitly reserved huge pages ...
+    void* p {mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0)};
+    // ... or regular pages the kernel may merge into huge pages
+    if (p == MAP_FAILED){
+      p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (p == MAP_FAILED){
+        throw std::bad_alloc{};
+      }
+      madvise(p, size, MADV_HUGEPAGE);
+    }
+
+    return static_cast<Type*>(p);
+#else
+    return static_cast<Type*>(::operator new(n * sizeof(Type), std::align_val_t{page_size_}));
+#endif
+  }
+  void deallocate(Type* p, std::size_t n){
+#ifdef __linux__
+    munmap(p, mapping_size_(n));
+#else
+    ::operator delete(p, std::align_val_t{page_size_});
+#endif
+  }
+
+  template<typename Other>
+  bool operator==(const HugePageAllocator<Other>&) const{
+    return true;
+  }
+  template<typename Other>
+  bool operator!=(const HugePageAllocator<Other>&) const{
+    return false;
+  }
+};
+// storage policies of Matrix. A policy tells which allocator holds
+// the elements, and how many elements apart consecutive rows are
+// stored (the row stride, or leading dimension) for a given number of
+// columns. The default policy stores rows contiguously
+struct PackedRows{
+  template<typename Type>
+  using allocator = std::allocator<Type>;
+
+  template<typename Type>
+  static std::size_t stride(std::size_t cols){
+    return cols;
+  }
+};
+// rows start at multiples of alignment bytes, so row-wise SIMD loops
+// use aligned loads. Rows spanning a multiple of 4 KiB are padded by
+// one more alignment unit, as otherwise elements in the same column
+// of consecutive rows would compete for the same cache sets
+template<std::size_t alignment = 64>
+struct AlignedRows{
+  template<typename Type>
+  using allocator = AlignedAllocator<Type, alignment>;
+
+  template<typename Type>
+  static std::size_t stride(std::size_t cols){
+    // types not dividing alignment cannot be padded to it
+    if (alignment % sizeof(Type) != 0){
+      return cols;
+    }
+
+    const std::size_t unit {alignment / sizeof(Type)};
+    std::size_t stride {(cols + unit - 1) / unit * unit};
+
+    if (stride > 0 && stride * sizeof(Type) % 4096 == 0){
+      stride += unit;
+    }
+
+    return stride;
+  }
+};
+// aligned rows in huge pages, for very large matrices
+struct HugePageRows : AlignedRows<64>{
+  template<typename Type>
+  using allocator = HugePageAllocator<Type>;
+};
+// non-owning view of a block of a matrix whose rows are stored
+// linewise, consecutive rows being stride elements apart. A view of
+// const Type is read-only. Views are cheap to create and pass by
+// value, so blocked algorithms may work on sub-blocks of a matrix
+// without copying them. As happens with rows and columns, assigning
+// to a view assigns to the elements it refers to
 template<typename Type>
+class MatrixView{
+public:
+  // type of elements, without const qualification
+  using value_type = std::remove_const_t<Type>;
+  using size_type  = std::size_t;
+  using reference  = Type&;
+private:
+  // first element of view, its dimensions and distance between its
+  // consecutive rows
+  Type*     data_;
+  size_type rows_;
+  size_type cols_;
+  size_type stride_;
+  // converts rectangular to linear index
+  size_type index(size_type i, size_type j) const{
+    return stride_ * i + j;
+  }
+public:
+  // const references to number of rows and number of columns
+  const size_type& num_rows;
+  const size_type& num_cols;
+  // view of rows x cols elements starting at data + offset
+  MatrixView(Type* data, size_type offset, size_type rows, size_type cols, size_type stride)
+    : data_{data + offset}, rows_{rows}, cols_{cols}, stride_{stride}, num_rows{rows_}, num_cols{cols_}
+  {}
+  // copy constructor: copies refer to the same elements
+  MatrixView(const MatrixView& v)
+    : MatrixView{v.data_, 0, v.rows_, v.cols_, v.stride_}
+  {}
+  // a mutable view can be seen as an immutable one
+  template<typename Other,
+           typename = std::enable_if_t<std::is_same_v<const Other, Type> && !std::is_same_v<Other, Type>>>
+  MatrixView(const MatrixView<Other>& v)
+    : MatrixView{v.data(), 0, v.num_rows, v.num_cols, v.stride()}
+  {}
+  // pointer to the first element of view
+  Type* data() const{
+    return data_;
+  }
+  // distance between consecutive rows
+  size_type stride() const{
+    return stride_;
+  }
+  // provides access to element at position (i, j)
+  reference at(size_type i, size_type j) const{
+    return data_[index(i, j)];
+  }
+  // returns a copy of element at position (i, j)
+  value_type const_at(size_type i, size_type j) const{
+    return data_[index(i, j)];
+  }
+  // view of the rows x cols block whose upper left corner is (i, j)
+  MatrixView block(size_type i, size_type j, size_type rows, size_type cols) const{
+    return {data_, index(i, j), rows, cols, stride_};
+  }
+  // assigns e to each position of view
+  const MatrixView& operator=(const value_type& e) const{
+    for (size_type i {0}; i < rows_; ++i){
+      std::fill(data_ + index(i, 0), data_ + index(i, cols_), e);
+    }
+
+    return *this;
+  }
+  // position-wise assignment between views. Does nothing if v has
+  // other dimensions
+  const MatrixView& operator=(const MatrixView& v) const{
+    return assign_(v);
+  }
+  // position-wise assignment from an expression (including views and
+  // matrices). Does nothing if e has other dimensions
+  template<typename Expression,
+           typename = std::enable_if_t<matrix_detail::is_operand_v<Expression>
+                                       && !std::is_same_v<Expression, MatrixView>>>
+  const MatrixView& operator=(const Expression& e) const{
+    return assign_(e);
+  }
+  // a view is an operand of expressions. The operand holds a copy of
+  // the view, which is as cheap as a reference to it
+  friend matrix_detail::ViewOperand<MatrixView> make_operand(const MatrixView& v){
+    return {v};
+  }
+private:
+  // evaluating in place is only safe when e does not read elements of
+  // view: otherwise, as happens when assigning a block to an
+  // overlapping one, positions would be read after being overwritten.
+  // In that case e is evaluated into a buffer first
+  template<typename Expression>
+  const MatrixView& assign_(const Expression& e) const{
+    const auto operand {make_operand(e)};
+
+    if (!operand.conformable() || operand.rows() != rows_ || operand.cols() != cols_){
+      return *this;
+    }
+    if (rows_ > 0 && cols_ > 0 && operand.reads(data_, data_ + index(rows_ - 1, cols_))){
+      std::vector<value_type> buffer (rows_ * cols_);
+      const MatrixView<value_type> copy {buffer.data(), 0, rows_, cols_, cols_};
+      matrix_detail::evaluate(copy, operand);
+      matrix_detail::evaluate(*this, make_operand(copy));
+    }
+    else{
+      matrix_detail::evaluate(*this, operand);
+    }
+
+    return *this;
+  }
+};
+// helpers of element-wise maps and reductions
+namespace matrix_detail{
+  // default transformation of reduced elements
+  struct Identity{
+    template<typename Type>
+    const Type& operator()(const Type& x) const{
+      return x;
+    }
+  };
+  // reduces transform(data[k]), for k in the nonempty range [first,
+  // last), with op. Eight independent accumulators let compilers
+  // vectorize the loop, which is why op must be associative and
+  // commutative, as in std::reduce
+  template<typename Result, typename Data, typename Op, typename Transform>
+  Result fold(const Data& data, std::size_t first, std::size_t last, Op& op, Transform& transform){
+    if (last - first < 16){
+      Result result = transform(data[first]);
+      for (std::size_t k {first + 1}; k < last; ++k){
+        result = op(result, transform(data[k]));
+      }
+
+      return result;
+    }
+
+    Result partial[8] {transform(data[first]),     transform(data[first + 1]),
+                       transform(data[first + 2]), transform(data[first + 3]),
+                       transform(data[first + 4]), transform(data[first + 5]),
+                       transform(data[first + 6]), transform(data[first + 7])};
+    std::size_t k {first + 8};
+    for (; k + 8 <= last; k += 8){
+      for (std::size_t t {0}; t < 8; ++t){
+        partial[t] = op(partial[t], transform(data[k + t]));
+      }
+    }
+    for (; k < last; ++k){
+      partial[0] = op(partial[0], transform(data[k]));
+    }
+
+    for (std::size_t t {1}; t < 8; ++t){
+      partial[0] = op(partial[0], partial[t]);
+    }
+
+    return partial[0];
+  }
+  // results of the chunks of a parallel loop, kept with the first
+  // index of each chunk so they are combined in a deterministic order
+  template<typename Result>
+  class ChunkResults{
+    std::vector<std::pair<std::size_t, Result>> results_;
+    std::mutex mutex_;
+  public:
+    void add(std::size_t first, Result result){
+      std::lock_guard<std::mutex> lock {mutex_};
+      results_.emplace_back(first, std::move(result));
+    }
+    // results, sorted by chunk
+    std::vector<std::pair<std::size_t, Result>>& sorted(){
+      std::sort(results_.begin(), results_.end(), [](const auto& a, const auto& b){ return a.first < b.first; });
+
+      return results_;
+    }
+  };
+}
+// class to represent a general matrix. Storage is a policy (such as
+// PackedRows, AlignedRows or HugePageRows) determining how elements
+// are allocated and laid out
+template<typename Type, typename Storage = PackedRows>
 class Matrix{
 private:
   // alias to our data type
-  using Data = std::vector<Type>;
+  using Data = std::vector<Type, typename Storage::template allocator<Type>>;
 public:
   // we are going to use the same size_type as Data
   using size_type = typename Data::size_type;
   // the same goes for reference
   using reference = typename Data::reference;
+  // type of elements
+  using value_type = Type;
 private:
   // private data: elements stored linewise, number of rows and number
-  // of colors
+  // of colors, and distance between consecutive rows, which may be
+  // larger than the number of columns when rows are padded
   Data      data_;
   size_type rows_;
   size_type cols_;
+  size_type stride_;
   // converts rectangular to linear index
   size_type index(size_type i, size_type j) const{
-    return cols_ * i + j;
+    return stride_ * i + j;
+  }
+  // blocks having at most this many rows and columns are transposed
+  // by plain loops; larger ones are split in halves. This way, at
+  // some level of recursion blocks fit in each level of cache,
+  // whatever their sizes are
+  static constexpr size_type transpose_block_ {32};
+  // exchanges elements at linear positions a and b. Calling swap
+  // unqualified lets vector<bool> references use their own overload
+  void swap_elements_(size_type a, size_type b){
+    using std::swap;
+    swap(data_[a], data_[b]);
+  }
+  // exchanges block [i_0, i_1) x [j_0, j_1) with the transpose of
+  // block [j_0, j_1) x [i_0, i_1). Blocks must not overlap
+  void swap_transposed_blocks_(size_type i_0, size_type i_1, size_type j_0, size_type j_1){
+    // small blocks are swapped element by element
+    if (i_1 - i_0 <= transpose_block_ && j_1 - j_0 <= transpose_block_){
+      for (size_type i {i_0}; i < i_1; ++i){
+        for (size_type j {j_0}; j < j_1; ++j){
+          swap_elements_(index(i, j), index(j, i));
+        }
+      }
+    }
+    // otherwise, the larger dimension is split in halves
+    else if (i_1 - i_0 >= j_1 - j_0){
+      const size_type middle {i_0 + (i_1 - i_0) / 2};
+      swap_transposed_blocks_(i_0, middle, j_0, j_1);
+      swap_transposed_blocks_(middle, i_1, j_0, j_1);
+    }
+    else{
+      const size_type middle {j_0 + (j_1 - j_0) / 2};
+      swap_transposed_blocks_(i_0, i_1, j_0, middle);
+      swap_transposed_blocks_(i_0, i_1, middle, j_1);
+    }
+  }
+  // transposes square block [b_0, b_1) x [b_0, b_1) lying on the main
+  // diagonal
+  void transpose_diagonal_block_(size_type b_0, size_type b_1){
+    if (b_1 - b_0 <= transpose_block_){
+      for (size_type i {b_0}; i < b_1; ++i){
+        for (size_type j {i + 1}; j < b_1; ++j){
+          swap_elements_(index(i, j), index(j, i));
+        }
+      }
+    }
+    // a diagonal block is made of two smaller diagonal blocks and a
+    // pair of off-diagonal blocks, which are exchanged
+    else{
+      const size_type middle {b_0 + (b_1 - b_0) / 2};
+      transpose_diagonal_block_(b_0, middle);
+      transpose_diagonal_block_(middle, b_1);
+      swap_transposed_blocks_(b_0, middle, middle, b_1);
+    }
+  }
+  // moves rows in place so that they become stride elements apart
+  void move_rows_(size_type stride){
+    // rows get closer, so they are moved from first to last ...
+    if (stride < stride_){
+      for (size_type i {1}; i < rows_; ++i){
+        std::move(data_.begin() + i * stride_, data_.begin() + i * stride_ + cols_, data_.begin() + i * stride);
+      }
+      data_.resize(rows_ * stride);
+    }
+    // ... or farther, so they are moved from last to first
+    else if (stride > stride_){
+      data_.resize(rows_ * stride);
+      for (size_type i {rows_}; i-- > 1;){
+        std::move_backward(data_.begin() + i * stride_, data_.begin() + i * stride_ + cols_, data_.begin() + i * stride + cols_);
+      }
+    }
+
+    stride_ = stride;
+  }
+  // calls f(first, last) in parallel for ranges of linear positions
+  // of data_ which cover every element exactly once: chunks of the
+  // whole of data_ when rows are contiguous, and of each row
+  // otherwise
+  template<typename Function>
+  void for_each_range_(ThreadPool& pool, Function f) const{
+    // chunks of fewer elements would not pay for their scheduling
+    constexpr size_type grain {4096};
+
+    if (stride_ == cols_){
+      pool.parallel_for(0, rows_ * cols_, f, grain);
+    }
+    else if (cols_ > 0){
+      pool.parallel_for(0, rows_, [this, &f](size_type first, size_type last){
+        for (size_type i {first}; i < last; ++i){
+          f(index(i, 0), index(i, 0) + cols_);
+        }
+      }, std::max<size_type>(1, grain / cols_));
+    }
+  }
+  // transposes a rectangular matrix, whose rows must be contiguous,
+  // in place. Element (i, j), at linear position i * cols_ + j,
+  // belongs to position j * rows_ + i of the transpose. Following this permutation from some position
+  // eventually leads back to it, so we carry elements along each
+  // cycle, and mark visited positions in a bitmap
+  void transpose_cycles_(){
+    const size_type size {rows_ * cols_};
+    // first and last positions never move
+    if (size < 3){
+      return;
+    }
+
+    std::vector<bool> visited (size, false);
+
+    for (size_type start {1}; start < size - 1; ++start){
+      // each cycle is followed only once
+      if (visited[start]){
+        continue;
+      }
+
+      Type carried = std::move(data_[start]);
+      size_type position {start};
+
+      do{
+        // target position of element currently at position
+        const size_type target {(position % cols_) * rows_ + position / cols_};
+        // carried element is put in place, and displaced one is
+        // carried to its own target
+        Type displaced = std::move(data_[target]);
+        data_[target] = std::move(carried);
+        carried = std::move(displaced);
+
+        visited[target] = true;
+        position = target;
+      } while (position != start);
+    }
   }
 public:
   // const references to number of rows and number of columns
   const size_type& num_rows;
   const size_type& num_cols;
-  // builds a matrix with a certain number of rows and columns
+  // builds a matrix with a certain number of rows and columns, whose
+  // row stride is chosen by Storage
   Matrix(size_type rows, size_type cols)
-    : data_{}, rows_{rows}, cols_{cols}, num_rows{rows_}, num_cols{cols_}
+    : Matrix{rows, cols, Storage::template stride<Type>(cols)}
+  {}
+  // builds a matrix with a certain number of rows and columns, and
+  // consecutive rows stride elements apart (at least cols)
+  Matrix(size_type rows, size_type cols, size_type stride)
+    : data_{}, rows_{rows}, cols_{cols}, stride_{std::max(stride, cols)}, num_rows{rows_}, num_cols{cols_}
   {
     // allocates data to the elements
-    data_.resize(rows_ * cols_);
+    data_.resize(rows_ * stride_);
   }
   // copy constructor
   Matrix(const Matrix& m)
-    : data_{m.data_}, rows_{m.rows_}, cols_{m.cols_}, num_rows{rows_}, num_cols{cols_}
+    : data_{m.data_}, rows_{m.rows_}, cols_{m.cols_}, stride_{m.stride_}, num_rows{rows_}, num_cols{cols_}
   {}
   // copy assignment
   Matrix& operator=(const Matrix& m){
-    data_ = m.data_;
-    rows_ = m.rows_;
-    cols_ = m.cols_;
+    data_   = m.data_;
+    rows_   = m.rows_;
+    cols_   = m.cols_;
+    stride_ = m.stride_;
 
     return *this;
   }
   // move constructor
   Matrix(Matrix&& m)
-    : data_{std::move(m.data_)}, rows_{std::move(m.rows_)}, cols_{std::move(m.cols_)}, num_rows{rows_}, num_cols{cols_}
+    : data_{std::move(m.data_)}, rows_{std::move(m.rows_)}, cols_{std::move(m.cols_)}, stride_{std::move(m.stride_)},
+      num_rows{rows_}, num_cols{cols_}
   {
-    m.rows_ = 0;
-    m.cols_ = 0;
+    m.rows_   = 0;
+    m.cols_   = 0;
+    m.stride_ = 0;
   }
   // move assignment
   Matrix& operator=(Matrix&& m){
-    data_ = std::move(m.data_);
-    rows_ = std::move(m.rows_);
-    cols_ = std::move(m.cols_);
+    data_   = std::move(m.data_);
+    rows_   = std::move(m.rows_);
+    cols_   = std::move(m.cols_);
+    stride_ = std::move(m.stride_);
+
+    m.rows_   = 0;
+    m.cols_   = 0;
+    m.stride_ = 0;
 
-    m.rows_ = 0;
-    m.cols_ = 0;
+    return *this;
+  }
+  // evaluates expression e into a new matrix of the same dimensions.
+  // Operands of e with disagreeing dimensions yield an empty matrix
+  template<typename Expression,
+           typename = std::enable_if_t<matrix_detail::is_operand_v<Expression>
+                                       && !std::is_base_of_v<Matrix, Expression>>>
+  Matrix(const Expression& e)
+    : Matrix{0, 0}
+  {
+    assign(e);
+  }
+  // evaluates expression e into this matrix, which takes the
+  // dimensions of e. Returns false (doing nothing) if operands of e
+  // have disagreeing dimensions
+  template<typename Expression>
+  bool assign(const Expression& e){
+    const auto operand {make_operand(e)};
+
+    if (!operand.conformable()){
+      return false;
+    }
+    // when dimensions change, e is evaluated into a new matrix, as it
+    // may refer to this one
+    if (operand.rows() != rows_ || operand.cols() != cols_){
+      Matrix result {operand.rows(), operand.cols()};
+      matrix_detail::evaluate(result, operand);
+      *this = std::move(result);
+    }
+    // otherwise, each position depends only on the same position of
+    // the operands, so evaluation may overwrite this matrix
+    else{
+      matrix_detail::evaluate(*this, operand);
+    }
+
+    return true;
+  }
+  // assignment from an expression; see assign
+  template<typename Expression,
+           typename = std::enable_if_t<matrix_detail::is_operand_v<Expression>
+                                       && !std::is_base_of_v<Matrix, Expression>>>
+  Matrix& operator=(const Expression& e){
+    assign(e);
 
     return *this;
   }
+  // a matrix is an operand of expressions
+  friend matrix_detail::MatrixOperand<Matrix> make_operand(const Matrix& m){
+    return {m};
+  }
   // provides access to element at position (i, j)
   reference at(size_type i, size_type j){
     return data_[index(i, j)];
@@ -77,6 +881,33 @@ public:
   Type const_at(size_type i, size_type j) const{
     return data_[index(i, j)];
   }
+  // pointer to the first element of our linewise storage. Elements
+  // (i, j) and (i, j + 1) are adjacent, and consecutive rows are
+  // stride() elements apart
+  Type* data(){
+    return data_.data();
+  }
+  const Type* data() const{
+    return data_.data();
+  }
+  // distance between consecutive rows
+  size_type stride() const{
+    return stride_;
+  }
+  // view of the whole matrix
+  MatrixView<Type> view(){
+    return {data(), 0, rows_, cols_, stride_};
+  }
+  MatrixView<const Type> view() const{
+    return {data(), 0, rows_, cols_, stride_};
+  }
+  // view of the rows x cols block whose upper left corner is (i, j)
+  MatrixView<Type> block(size_type i, size_type j, size_type rows, size_type cols){
+    return {data(), index(i, j), rows, cols, stride_};
+  }
+  MatrixView<const Type> block(size_type i, size_type j, size_type rows, size_type cols) const{
+    return {data(), index(i, j), rows, cols, stride_};
+  }
   // prints matrix
   void print(std::ostream& out = std::cout){
     for (size_type i {0}; i < num_rows; i++){
@@ -86,48 +917,140 @@ public:
       out << '\n';
     }
   }
-  // transforms matrix into its transpose. This destructive operation
-  // is done inplace
-  void transpose(){
-    // if matrix is square, no extra memory is needed to build its transpose
-    if (num_rows == num_cols){
-      for (size_type i {0}; i < num_rows; i++){
-        for (size_type j {i + 1}; j < num_cols; j++){
-          std::swap(at(i, j), at(j, i));
-        }
+  // element-wise operations, run in parallel by the threads of
+  // pool. Elements are split in chunks of whole rows, or in chunks of
+  // contiguous elements when rows are not padded. Reductions combine
+  // transform(x) for every element x with op, starting from init;
+  // like std::reduce, they assume op is associative and commutative
+  //
+  // replaces each element x by f(x)
+  template<typename Function>
+  Matrix& map(Function f, ThreadPool& pool = ThreadPool::shared()){
+    const auto apply {[this, &f](size_type first, size_type last){
+      for (size_type k {first}; k < last; ++k){
+        data_[k] = f(data_[k]);
       }
+    }};
+    // bits of a vector<bool> share words, which threads cannot write
+    // at the same time
+    if constexpr (std::is_same_v<Type, bool>){
+      apply(0, data_.size());
     }
-    // if matrix is not square, some extra memory is needed to build
-    // its transpose
     else{
-      // auxiliar memory to temporarily hold the transpose
-      Matrix<Type> t {num_cols, num_rows};
-      // builds transpose
-      for (size_type i {0}; i < num_rows; i++){
-        for (size_type j {0}; j < num_cols; j++){
-          t.at(j, i) = at(i, j);
-        }
-      }
-      // exchanges matrix data with t data, which is about to die
-      std::swap(data_, t.data_);
+      for_each_range_(pool, apply);
     }
-    // exchanges number of rows and columns
-    std::swap(rows_, cols_);
+
+    return *this;
   }
-  // nested class to represent a row of matrix
-  class Row{
+  // reduction of every element
+  template<typename Result, typename Op, typename Transform = matrix_detail::Identity>
+  Result reduce(Result init, Op op, Transform transform = {}, ThreadPool& pool = ThreadPool::shared()) const{
+    matrix_detail::ChunkResults<Result> partials {};
+
+    for_each_range_(pool, [&](size_type first, size_type last){
+      partials.add(first, matrix_detail::fold<Result>(data_, first, last, op, transform));
+    });
+
+    for (auto& [first, partial] : partials.sorted()){
+      init = op(init, partial);
+    }
+
+    return init;
+  }
+  // reduction of each row
+  template<typename Result, typename Op, typename Transform = matrix_detail::Identity>
+  std::vector<Result> row_reduce(Result init, Op op, Transform transform = {}, ThreadPool& pool = ThreadPool::shared()) const{
+    std::vector<Result> result (rows_, init);
+
+    if (cols_ > 0){
+      pool.parallel_for(0, rows_, [&](size_type first, size_type last){
+        for (size_type i {first}; i < last; ++i){
+          result[i] = op(result[i], matrix_detail::fold<Result>(data_, index(i, 0), index(i, 0) + cols_, op, transform));
+        }
+      }, std::max<size_type>(1, 4096 / std::max<size_type>(cols_, 1)));
+    }
+
+    return result;
+  }
+  // reduction of each column. Rather than striding down columns, each
+  // chunk of rows is accumulated row by row into a vector of partial
+  // results, which is read and written sequentially
+  template<typename Result, typename Op, typename Transform = matrix_detail::Identity>
+  std::vector<Result> col_reduce(Result init, Op op, Transform transform = {}, ThreadPool& pool = ThreadPool::shared()) const{
+    std::vector<Result> result (cols_, init);
+    matrix_detail::ChunkResults<std::vector<Result>> partials {};
+
+    if (cols_ > 0){
+      pool.parallel_for(0, rows_, [&](size_type first, size_type last){
+        std::vector<Result> partial (cols_);
+        for (size_type j {0}; j < cols_; ++j){
+          partial[j] = transform(data_[index(first, j)]);
+        }
+        for (size_type i {first + 1}; i < last; ++i){
+          const size_type row {index(i, 0)};
+          for (size_type j {0}; j < cols_; ++j){
+            partial[j] = op(partial[j], transform(data_[row + j]));
+          }
+        }
+        partials.add(first, std::move(partial));
+      }, std::max<size_type>(1, 4096 / std::max<size_type>(cols_, 1)));
+    }
+
+    for (auto& [first, partial] : partials.sorted()){
+      for (size_type j {0}; j < cols_; ++j){
+        result[j] = op(result[j], partial[j]);
+      }
+    }
+
+    return result;
+  }
+  // transforms matrix into its transpose. This destructive operation
+  // is done inplace
+  void transpose(){
+    // if matrix is square, elements are swapped across the main
+    // diagonal, one pair of blocks at a time
+    if (num_rows == num_cols){
+      transpose_diagonal_block_(0, num_rows);
+    }
+    // if matrix is not square, elements are moved along the cycles of
+    // the transposition permutation, which needs a single bit of
+    // extra memory per element. Padded rows are brought together
+    // before, and padded again (to the stride of the new number of
+    // columns) after
+    else{
+      move_rows_(cols_);
+      transpose_cycles_();
+      std::swap(rows_, cols_);
+      stride_ = cols_;
+      move_rows_(Storage::template stride<Type>(cols_));
+
+      return;
+    }
+    // exchanges number of rows and columns
+    std::swap(rows_, cols_);
+  }
+  // nested class to represent a row of matrix
+  class Row{
     // matrix reference and row index
-    Matrix<Type>& parent_;
+    Matrix&   parent_;
     size_type     row_index_;
   public:
     // simple constructor
-    Row(Matrix<Type>& parent, size_type row_index)
+    Row(Matrix& parent, size_type row_index)
       : parent_{parent}, row_index_{row_index}
     {}
+    // number of positions of row
+    size_type size() const{
+      return parent_.num_cols;
+    }
     // access to position j of row using [] notation
     reference operator[](size_type j){
       return parent_.at(row_index_, j);
     }
+    // returns a copy of position j of row
+    Type operator[](size_type j) const{
+      return parent_.const_at(row_index_, j);
+    }
     // assigns e to each row position
     Row& operator=(const Type& e){
       for (size_type j {0}; j < parent_.num_cols; j++){
@@ -144,27 +1067,54 @@ public:
 
       return *this;
     }
+    // position-wise assignment from a 1 x num_cols expression. Does
+    // nothing if e has other dimensions
+    template<typename Expression,
+             typename = std::enable_if_t<matrix_detail::is_operand_v<Expression>>>
+    Row& operator=(const Expression& e){
+      const auto operand {make_operand(e)};
+
+      if (operand.conformable() && operand.rows() == 1 && operand.cols() == parent_.num_cols){
+        for (size_type j {0}; j < parent_.num_cols; j++){
+          (*this)[j] = operand.element(0, j);
+        }
+      }
+
+      return *this;
+    }
     // exchanges row contents
     void swap(Row&& row){
       for (size_type j {0}; j < parent_.num_cols; j++){
         std::swap((*this)[j], row[j]);
       }
     }
+    // a row is an operand of expressions
+    friend matrix_detail::RowOperand<Matrix> make_operand(const Row& row){
+      return {row.parent_, row.row_index_};
+    }
   };
   // class to represent a column of a matrix
   class Col{
     // matrix reference and column index
-    Matrix<Type>& parent_;
+    Matrix&   parent_;
     size_type     col_index_;
   public:
     // simple constructor
-    Col(Matrix<Type>& parent, size_type col_index)
+    Col(Matrix& parent, size_type col_index)
       : parent_{parent}, col_index_{col_index}
     {}
+    // number of positions of column
+    size_type size() const{
+      return parent_.num_rows;
+    }
     // access to position i of column using [] notation
     reference operator[](size_type i){
       return parent_.at(i, col_index_);
     }
+    // returns a copy of position i of column
+    Type operator[](size_type i) const{
+      return parent_.const_at(i, col_index_);
+    }
     // assigns e to each column position
     Col& operator=(const Type& e){
       for (size_type i {0}; i < parent_.num_rows; i++){
@@ -181,12 +1131,31 @@ public:
 
       return *this;
     }
+    // position-wise assignment from a num_rows x 1 expression. Does
+    // nothing if e has other dimensions
+    template<typename Expression,
+             typename = std::enable_if_t<matrix_detail::is_operand_v<Expression>>>
+    Col& operator=(const Expression& e){
+      const auto operand {make_operand(e)};
+
+      if (operand.conformable() && operand.rows() == parent_.num_rows && operand.cols() == 1){
+        for (size_type i {0}; i < parent_.num_rows; i++){
+          (*this)[i] = operand.element(i, 0);
+        }
+      }
+
+      return *this;
+    }
     // exchanges column contents
     void swap(Col&& col){
       for (size_type i {0}; i < parent_.num_rows; i++){
         std::swap((*this)[i], col[i]);
       }
     }
+    // a column is an operand of expressions
+    friend matrix_detail::ColOperand<Matrix> make_operand(const Col& col){
+      return {col.parent_, col.col_index_};
+    }
   };
   // returns representation of row i
   Row row(size_type i){
@@ -206,10 +1175,10 @@ public:
   }
 };
 // class to represent a square matrix
-template<typename Type>
-class SquareMatrix : public Matrix<Type>{
+template<typename Type, typename Storage = PackedRows>
+class SquareMatrix : public Matrix<Type, Storage>{
   // alias to superclass
-  using Mat = Matrix<Type>;
+  using Mat = Matrix<Type, Storage>;
 public:
   // we are going to use the same size_type as superclass
   using size_type = typename Mat::size_type;
@@ -219,6 +1188,20 @@ public:
   SquareMatrix& operator=(const Type& e){
     Mat::operator=(e);
 
+    return *this;
+  }
+  // evaluates expression e into this matrix. Does nothing if e does
+  // not have the same dimensions as this matrix
+  template<typename Expression,
+           typename = std::enable_if_t<matrix_detail::is_operand_v<Expression>
+                                       && !std::is_base_of_v<Mat, Expression>>>
+  SquareMatrix& operator=(const Expression& e){
+    const auto operand {make_operand(e)};
+
+    if (operand.rows() == this->num_rows && operand.cols() == this->num_cols){
+      Mat::assign(e);
+    }
+
     return *this;
   }
 };
@@ -324,6 +1307,13 @@ public:
   UpperTriangularMatrix(size_type n)
     : n_{n}, half_rows_{set_half_rows_(n_)}, data_{half_rows_, n_ + 1}, num_rows{n_}, num_cols{n_}
   {}
+  // copy and move constructors, which bind references to this matrix
+  UpperTriangularMatrix(const UpperTriangularMatrix& m)
+    : n_{m.n_}, half_rows_{m.half_rows_}, data_{m.data_}, num_rows{n_}, num_cols{n_}
+  {}
+  UpperTriangularMatrix(UpperTriangularMatrix&& m)
+    : n_{m.n_}, half_rows_{m.half_rows_}, data_{std::move(m.data_)}, num_rows{n_}, num_cols{n_}
+  {}
   // aliases to mutable and const references
   using reference       = reference_base<ThisType>;
   using const_reference = reference_base<const ThisType>;
@@ -335,6 +1325,22 @@ public:
   const_reference const_at(size_type i, size_type j) const{
     return {*this, i, j};
   }
+  // packed storage of row i, which holds positions (i, i) to
+  // (i, n - 1) next to each other. Following index_, rows in the upper
+  // half are stored left to right, starting at the diagonal, while
+  // rows in the lower half are stored right to left, so that they
+  // start at (i, n - 1) and end at the diagonal. Numeric kernels use
+  // this to stream through rows without going through references
+  Type* row_data(size_type i){
+    return data_.data() + data_.stride() * (row_reversed(i) ? (n_ - 1) - i : i) + (row_reversed(i) ? 0 : 1 + i);
+  }
+  const Type* row_data(size_type i) const{
+    return data_.data() + data_.stride() * (row_reversed(i) ? (n_ - 1) - i : i) + (row_reversed(i) ? 0 : 1 + i);
+  }
+  // whether row i is stored right to left
+  bool row_reversed(size_type i) const{
+    return i >= half_rows_;
+  }
   // assigns e to every upper triangle position of this matrix
   UpperTriangularMatrix& operator=(Type&& e){
     data_ = e;
@@ -351,19 +1357,1083 @@ class LowerTriangularMatrix{
   // our data
   Data data_;
 public:
-  // we use the same size_type and reference as Data
-  using size_type = typename Data::size_type;
-  using reference = typename Data::reference;
+  // we use the same size_type and references as Data
+  using size_type       = typename Data::size_type;
+  using reference       = typename Data::reference;
+  using const_reference = typename Data::const_reference;
   // const references to number of rows and columns
-  size_type& num_rows;
-  size_type& num_cols;
+  const size_type& num_rows;
+  const size_type& num_cols;
   // simple constructor
   LowerTriangularMatrix(size_type n) : data_{n}, num_rows{data_.num_rows}, num_cols{data_.num_cols}
   {}
+  // copy and move constructors, which bind references to this matrix
+  LowerTriangularMatrix(const LowerTriangularMatrix& m) : data_{m.data_}, num_rows{data_.num_rows}, num_cols{data_.num_cols}
+  {}
+  LowerTriangularMatrix(LowerTriangularMatrix&& m) : data_{std::move(m.data_)}, num_rows{data_.num_rows}, num_cols{data_.num_cols}
+  {}
   // returns reference to position (i, j)
   reference at(size_type i, size_type j){
     return data_.at(j, i);
   }
+  // returns immutable reference to position (i, j)
+  const_reference const_at(size_type i, size_type j) const{
+    return data_.const_at(j, i);
+  }
+  // upper triangular matrix holding our transpose. Row j of it is
+  // column j of this matrix, which is what numeric kernels need
+  const Data& transposed() const{
+    return data_;
+  }
 };
+// a class to represent a symmetric matrix. Only the upper triangle is
+// stored, packed as in an upper triangular matrix, so (i, j) and
+// (j, i) refer to the same element
+template<typename Type>
+class SymmetricMatrix{
+  // our upper triangle
+  using Data = UpperTriangularMatrix<Type>;
+  Data data_;
+public:
+  // we use the same size_type and references as Data
+  using size_type       = typename Data::size_type;
+  using reference       = typename Data::reference;
+  using const_reference = typename Data::const_reference;
+  // const references to number of rows and columns
+  const size_type& num_rows;
+  const size_type& num_cols;
+  // simple constructor
+  SymmetricMatrix(size_type n) : data_{n}, num_rows{data_.num_rows}, num_cols{data_.num_cols}
+  {}
+  // builds a symmetric matrix from a square matrix m. Returns nothing
+  // if m is not symmetric
+  template<typename Storage>
+  static std::optional<SymmetricMatrix> from(const Matrix<Type, Storage>& m){
+    if (m.num_rows != m.num_cols){
+      return {};
+    }
+
+    SymmetricMatrix result {m.num_rows};
+    for (size_type i {0}; i < m.num_rows; ++i){
+      for (size_type j {i}; j < m.num_cols; ++j){
+        if (m.const_at(i, j) != m.const_at(j, i)){
+          return {};
+        }
+        result.at(i, j) = m.const_at(i, j);
+      }
+    }
+
+    return result;
+  }
+  // copy and move constructors, which bind references to this matrix
+  SymmetricMatrix(const SymmetricMatrix& m) : data_{m.data_}, num_rows{data_.num_rows}, num_cols{data_.num_cols}
+  {}
+  SymmetricMatrix(SymmetricMatrix&& m) : data_{std::move(m.data_)}, num_rows{data_.num_rows}, num_cols{data_.num_cols}
+  {}
+  // returns reference to position (i, j), which is also position
+  // (j, i)
+  reference at(size_type i, size_type j){
+    return i <= j ? data_.at(i, j) : data_.at(j, i);
+  }
+  // returns immutable reference to position (i, j)
+  const_reference const_at(size_type i, size_type j) const{
+    return i <= j ? data_.const_at(i, j) : data_.const_at(j, i);
+  }
+  // assigns e to every position of this matrix
+  SymmetricMatrix& operator=(Type e){
+    data_ = std::move(e);
+
+    return *this;
+  }
+  // upper triangular matrix holding our elements, which is what
+  // numeric kernels use
+  const Data& upper() const{
+    return data_;
+  }
+  Data& upper(){
+    return data_;
+  }
+};
+
+// arithmetic on matrices, rows, columns and expressions. Each operator
+// only builds an expression node; see matrix_detail above
+template<typename Left, typename Right,
+         typename = std::enable_if_t<matrix_detail::is_operand_v<Left> && matrix_detail::is_operand_v<Right>>>
+auto operator+(const Left& left, const Right& right){
+  using Node = matrix_detail::BinaryExpression<matrix_detail::operand_t<Left>, matrix_detail::operand_t<Right>, matrix_detail::Plus>;
+
+  return Node{make_operand(left), make_operand(right), {}};
+}
+template<typename Left, typename Right,
+         typename = std::enable_if_t<matrix_detail::is_operand_v<Left> && matrix_detail::is_operand_v<Right>>>
+auto operator-(const Left& left, const Right& right){
+  using Node = matrix_detail::BinaryExpression<matrix_detail::operand_t<Left>, matrix_detail::operand_t<Right>, matrix_detail::Minus>;
+
+  return Node{make_operand(left), make_operand(right), {}};
+}
+// element-wise (Hadamard) product. Operator * is reserved for scaling,
+// as it would be ambiguous with the matrix product
+template<typename Left, typename Right,
+         typename = std::enable_if_t<matrix_detail::is_operand_v<Left> && matrix_detail::is_operand_v<Right>>>
+auto hadamard(const Left& left, const Right& right){
+  using Node = matrix_detail::BinaryExpression<matrix_detail::operand_t<Left>, matrix_detail::operand_t<Right>, matrix_detail::Times>;
+
+  return Node{make_operand(left), make_operand(right), {}};
+}
+// applies function to each element of operand
+template<typename Operand, typename Function,
+         typename = std::enable_if_t<matrix_detail::is_operand_v<Operand>>>
+auto map(const Operand& operand, Function function){
+  using Node = matrix_detail::UnaryExpression<matrix_detail::operand_t<Operand>, Function>;
+
+  return Node{make_operand(operand), function};
+}
+template<typename Operand,
+         typename = std::enable_if_t<matrix_detail::is_operand_v<Operand>>>
+auto operator-(const Operand& operand){
+  using Node = matrix_detail::UnaryExpression<matrix_detail::operand_t<Operand>, matrix_detail::Negate>;
+
+  return Node{make_operand(operand), {}};
+}
+// multiplication by a scalar, on either side
+template<typename Operand, typename Scalar,
+         std::enable_if_t<matrix_detail::is_operand_v<Operand> && !matrix_detail::is_operand_v<Scalar>, int> = 0>
+auto operator*(const Operand& operand, const Scalar& scalar){
+  using Type = typename matrix_detail::operand_t<Operand>::value_type;
+  using Node = matrix_detail::UnaryExpression<matrix_detail::operand_t<Operand>, matrix_detail::ScaleRight<Type>>;
+
+  return Node{make_operand(operand), {static_cast<Type>(scalar)}};
+}
+template<typename Scalar, typename Operand,
+         std::enable_if_t<!matrix_detail::is_operand_v<Scalar> && matrix_detail::is_operand_v<Operand>, int> = 0>
+auto operator*(const Scalar& scalar, const Operand& operand){
+  using Type = typename matrix_detail::operand_t<Operand>::value_type;
+  using Node = matrix_detail::UnaryExpression<matrix_detail::operand_t<Operand>, matrix_detail::ScaleLeft<Type>>;
+
+  return Node{make_operand(operand), {static_cast<Type>(scalar)}};
+}
+// matrix multiplication. The machinery below is kept in its own
+// namespace, as only multiply (at the end of this section) is meant
+// to be called by users
+namespace matrix_detail{
+  // we use the same size_type as Matrix
+  using size_type = std::size_t;
+  // blocking parameters of the multiplication of some Type. A product
+  // C += A * B is broken into blocks: a kc x nc block of B is packed
+  // to fit in the L3 cache, a mc x kc block of A is packed to fit in
+  // the L2 cache, and a micro-kernel updates a mr x nr tile of C
+  // keeping it in registers while it streams through kc elements of
+  // both packed blocks, which stay in the L1 cache
+  template<typename Type>
+  struct GemmTraits{
+    static constexpr size_type mr {4};
+    static constexpr size_type nr {4};
+    static constexpr size_type kc {256};
+    static constexpr size_type mc {64};
+    static constexpr size_type nc {2048};
+  };
+  // a 6 x 8 tile of doubles takes 12 of the 16 AVX2 registers
+  template<>
+  struct GemmTraits<double>{
+    static constexpr size_type mr {6};
+    static constexpr size_type nr {8};
+    static constexpr size_type kc {256};
+    static constexpr size_type mc {96};
+    static constexpr size_type nc {4080};
+  };
+  // floats and 32 bit integers fit twice as many lanes per register
+  template<>
+  struct GemmTraits<float>{
+    static constexpr size_type mr {6};
+    static constexpr size_type nr {16};
+    static constexpr size_type kc {256};
+    static constexpr size_type mc {144};
+    static constexpr size_type nc {4080};
+  };
+  template<>
+  struct GemmTraits<std::int32_t>{
+    static constexpr size_type mr {6};
+    static constexpr size_type nr {16};
+    static constexpr size_type kc {256};
+    static constexpr size_type mc {144};
+    static constexpr size_type nc {4080};
+  };
+  // portable micro-kernel: computes c += a * b, where a is a packed
+  // mr x kc panel, b is a packed kc x nr panel and c is a mr x nr
+  // tile whose rows are ldc elements apart. As loop bounds are
+  // compile time constants, compilers are able to keep acc in
+  // registers and vectorize the innermost loop
+  template<typename Type, size_type mr, size_type nr>
+  void portable_kernel(size_type kc, const Type* a, const Type* b, Type* c, size_type ldc){
+    Type acc[mr][nr] {};
+
+    for (size_type p {0}; p < kc; ++p){
+      for (size_type i {0}; i < mr; ++i){
+        const Type a_i {a[i]};
+        for (size_type j {0}; j < nr; ++j){
+          acc[i][j] += a_i * b[j];
+        }
+      }
+      a += mr;
+      b += nr;
+    }
+
+    for (size_type i {0}; i < mr; ++i){
+      for (size_type j {0}; j < nr; ++j){
+        c[i * ldc + j] += acc[i][j];
+      }
+    }
+  }
+  // selects the micro-kernel of each Type. Unless the target has SIMD
+  // support, the portable kernel is used
+  template<typename Type>
+  struct MicroKernel{
+    static void run(size_type kc, const Type* a, const Type* b, Type* c, size_type ldc){
+      portable_kernel<Type, GemmTraits<Type>::mr, GemmTraits<Type>::nr>(kc, a, b, c, ldc);
+    }
+  };
+#if defined(__AVX2__) && defined(__FMA__)
+  // 6 x 8 double kernel: each row of the tile is held in two 4-wide
+  // registers, updated by a fused multiply-add with a broadcast
+  // element of a
+  template<>
+  struct MicroKernel<double>{
+    static void run(size_type kc, const double* a, const double* b, double* c, size_type ldc){
+      __m256d acc[6][2];
+      for (size_type i {0}; i < 6; ++i){
+        acc[i][0] = _mm256_setzero_pd();
+        acc[i][1] = _mm256_setzero_pd();
+      }
+
+      for (size_type p {0}; p < kc; ++p){
+        const __m256d b_0 {_mm256_loadu_pd(b)};
+        const __m256d b_1 {_mm256_loadu_pd(b + 4)};
+        for (size_type i {0}; i < 6; ++i){
+          const __m256d a_i {_mm256_broadcast_sd(a + i)};
+          acc[i][0] = _mm256_fmadd_pd(a_i, b_0, acc[i][0]);
+          acc[i][1] = _mm256_fmadd_pd(a_i, b_1, acc[i][1]);
+        }
+        a += 6;
+        b += 8;
+      }
+
+      for (size_type i {0}; i < 6; ++i){
+        double* c_i {c + i * ldc};
+        _mm256_storeu_pd(c_i,     _mm256_add_pd(_mm256_loadu_pd(c_i),     acc[i][0]));
+        _mm256_storeu_pd(c_i + 4, _mm256_add_pd(_mm256_loadu_pd(c_i + 4), acc[i][1]));
+      }
+    }
+  };
+  // 6 x 16 float kernel, same scheme with 8-wide registers
+  template<>
+  struct MicroKernel<float>{
+    static void run(size_type kc, const float* a, const float* b, float* c, size_type ldc){
+      __m256 acc[6][2];
+      for (size_type i {0}; i < 6; ++i){
+        acc[i][0] = _mm256_setzero_ps();
+        acc[i][1] = _mm256_setzero_ps();
+      }
+
+      for (size_type p {0}; p < kc; ++p){
+        const __m256 b_0 {_mm256_loadu_ps(b)};
+        const __m256 b_1 {_mm256_loadu_ps(b + 8)};
+        for (size_type i {0}; i < 6; ++i){
+          const __m256 a_i {_mm256_broadcast_ss(a + i)};
+          acc[i][0] = _mm256_fmadd_ps(a_i, b_0, acc[i][0]);
+          acc[i][1] = _mm256_fmadd_ps(a_i, b_1, acc[i][1]);
+        }
+        a += 6;
+        b += 16;
+      }
+
+      for (size_type i {0}; i < 6; ++i){
+        float* c_i {c + i * ldc};
+        _mm256_storeu_ps(c_i,     _mm256_add_ps(_mm256_loadu_ps(c_i),     acc[i][0]));
+        _mm256_storeu_ps(c_i + 8, _mm256_add_ps(_mm256_loadu_ps(c_i + 8), acc[i][1]));
+      }
+    }
+  };
+  // 6 x 16 32 bit integer kernel. There is no fused multiply-add for
+  // integers, so we multiply and then add
+  template<>
+  struct MicroKernel<std::int32_t>{
+    static void run(size_type kc, const std::int32_t* a, const std::int32_t* b, std::int32_t* c, size_type ldc){
+      __m256i acc[6][2];
+      for (size_type i {0}; i < 6; ++i){
+        acc[i][0] = _mm256_setzero_si256();
+        acc[i][1] = _mm256_setzero_si256();
+      }
+
+      for (size_type p {0}; p < kc; ++p){
+        const __m256i b_0 {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b))};
+        const __m256i b_1 {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + 8))};
+        for (size_type i {0}; i < 6; ++i){
+          const __m256i a_i {_mm256_set1_epi32(a[i])};
+          acc[i][0] = _mm256_add_epi32(acc[i][0], _mm256_mullo_epi32(a_i, b_0));
+          acc[i][1] = _mm256_add_epi32(acc[i][1], _mm256_mullo_epi32(a_i, b_1));
+        }
+        a += 6;
+        b += 16;
+      }
+
+      for (size_type i {0}; i < 6; ++i){
+        __m256i* c_i {reinterpret_cast<__m256i*>(c + i * ldc)};
+        _mm256_storeu_si256(c_i,     _mm256_add_epi32(_mm256_loadu_si256(c_i),     acc[i][0]));
+        _mm256_storeu_si256(c_i + 1, _mm256_add_epi32(_mm256_loadu_si256(c_i + 1), acc[i][1]));
+      }
+    }
+  };
+#endif
+  // copies a mc x kc block of A (rows lda elements apart) into
+  // consecutive mr x kc panels, each one stored column by column. The
+  // last panel is padded with zeros, so the micro-kernel never needs
+  // to check bounds
+  template<typename Type>
+  void pack_a(size_type mc, size_type kc, const Type* a, size_type lda, Type* packed){
+    constexpr size_type mr {GemmTraits<Type>::mr};
+
+    for (size_type i_0 {0}; i_0 < mc; i_0 += mr){
+      const size_type rows {std::min(mr, mc - i_0)};
+      for (size_type p {0}; p < kc; ++p){
+        for (size_type i {0}; i < rows; ++i){
+          packed[i] = a[(i_0 + i) * lda + p];
+        }
+        for (size_type i {rows}; i < mr; ++i){
+          packed[i] = Type{};
+        }
+        packed += mr;
+      }
+    }
+  }
+  // copies a kc x nc block of B (rows ldb elements apart) into
+  // consecutive kc x nr panels, each one stored row by row and padded
+  // with zeros
+  template<typename Type>
+  void pack_b(size_type kc, size_type nc, const Type* b, size_type ldb, Type* packed){
+    constexpr size_type nr {GemmTraits<Type>::nr};
+
+    for (size_type j_0 {0}; j_0 < nc; j_0 += nr){
+      const size_type cols {std::min(nr, nc - j_0)};
+      for (size_type p {0}; p < kc; ++p){
+        const Type* b_p {b + p * ldb + j_0};
+        for (size_type j {0}; j < cols; ++j){
+          packed[j] = b_p[j];
+        }
+        for (size_type j {cols}; j < nr; ++j){
+          packed[j] = Type{};
+        }
+        packed += nr;
+      }
+    }
+  }
+  // updates a mc x nc block of C with the product of packed blocks of
+  // A and B, one mr x nr tile at a time. Tiles crossing the border of
+  // C are computed into a local tile and then partially copied
+  template<typename Type>
+  void macro_kernel(size_type mc, size_type nc, size_type kc,
+                    const Type* a_packed, const Type* b_packed, Type* c, size_type ldc){
+    constexpr size_type mr {GemmTraits<Type>::mr};
+    constexpr size_type nr {GemmTraits<Type>::nr};
+
+    for (size_type j_0 {0}; j_0 < nc; j_0 += nr){
+      const size_type cols {std::min(nr, nc - j_0)};
+      const Type* b_panel {b_packed + j_0 * kc};
+      for (size_type i_0 {0}; i_0 < mc; i_0 += mr){
+        const size_type rows {std::min(mr, mc - i_0)};
+        const Type* a_panel {a_packed + i_0 * kc};
+        Type* c_tile {c + i_0 * ldc + j_0};
+        if (rows == mr && cols == nr){
+          MicroKernel<Type>::run(kc, a_panel, b_panel, c_tile, ldc);
+        }
+        else{
+          Type tile[mr * nr] {};
+          MicroKernel<Type>::run(kc, a_panel, b_panel, tile, nr);
+          for (size_type i {0}; i < rows; ++i){
+            for (size_type j {0}; j < cols; ++j){
+              c_tile[i * ldc + j] += tile[i * nr + j];
+            }
+          }
+        }
+      }
+    }
+  }
+  // packing buffers are kept per thread and only grow, so repeated
+  // multiplications do not allocate
+  template<typename Type>
+  Type* packing_buffer(std::vector<Type>& buffer, size_type size){
+    if (buffer.size() < size){
+      buffer.resize(size);
+    }
+    return buffer.data();
+  }
+  // computes C += A * B, where A is m x k, B is k x n and C is m x n,
+  // each one stored linewise with rows lda, ldb and ldc elements
+  // apart, respectively
+  template<typename Type>
+  void gemm(size_type m, size_type n, size_type k,
+            const Type* a, size_type lda,
+            const Type* b, size_type ldb,
+            Type* c, size_type ldc){
+    using Traits = GemmTraits<Type>;
+
+    thread_local std::vector<Type> a_buffer {};
+    thread_local std::vector<Type> b_buffer {};
+    // panels are padded up to a multiple of mr and nr
+    Type* a_packed {packing_buffer(a_buffer, (Traits::mc + Traits::mr) * Traits::kc)};
+    Type* b_packed {packing_buffer(b_buffer, (Traits::nc + Traits::nr) * Traits::kc)};
+
+    for (size_type j_c {0}; j_c < n; j_c += Traits::nc){
+      const size_type nc {std::min(Traits::nc, n - j_c)};
+      for (size_type p_c {0}; p_c < k; p_c += Traits::kc){
+        const size_type kc {std::min(Traits::kc, k - p_c)};
+        pack_b(kc, nc, b + p_c * ldb + j_c, ldb, b_packed);
+        for (size_type i_c {0}; i_c < m; i_c += Traits::mc){
+          const size_type mc {std::min(Traits::mc, m - i_c)};
+          pack_a(mc, kc, a + i_c * lda + p_c, lda, a_packed);
+          macro_kernel(mc, nc, kc, a_packed, b_packed, c + i_c * ldc + j_c, ldc);
+        }
+      }
+    }
+  }
+  // the packed kernels above need contiguous storage and the usual
+  // arithmetic operations; booleans are stored bitwise by vector
+  template<typename Type>
+  constexpr bool packed_multiplication {std::is_arithmetic_v<Type> && !std::is_same_v<Type, bool>};
+}
+namespace matrix_detail{
+  // plain i-k-j product c = a * b, for types without packed kernels.
+  // This order still traverses b and c linewise
+  template<typename Left, typename Right, typename Target>
+  void multiply_generic(const Left& a, const Right& b, Target&& c){
+    using Type = typename Left::value_type;
+
+    for (size_type i {0}; i < c.num_rows; ++i){
+      for (size_type j {0}; j < c.num_cols; ++j){
+        c.at(i, j) = Type{};
+      }
+    }
+
+    for (size_type i {0}; i < a.num_rows; ++i){
+      for (size_type k {0}; k < a.num_cols; ++k){
+        const Type a_ik {a.const_at(i, k)};
+        for (size_type j {0}; j < b.num_cols; ++j){
+          c.at(i, j) = c.const_at(i, j) + a_ik * b.const_at(k, j);
+        }
+      }
+    }
+  }
+  // determines whether two views share some element
+  template<typename TypeA, typename TypeB>
+  bool overlap(const MatrixView<TypeA>& a, const MatrixView<TypeB>& b){
+    if (a.num_rows == 0 || a.num_cols == 0 || b.num_rows == 0 || b.num_cols == 0){
+      return false;
+    }
+    // address ranges spanned by each view
+    return intersect(a.data(), &a.at(a.num_rows - 1, a.num_cols - 1) + 1,
+                     b.data(), &b.at(b.num_rows - 1, b.num_cols - 1) + 1);
+  }
+}
+// computes the product of views a and b into view c, which must have
+// a.num_rows rows and b.num_cols columns; as no memory is allocated,
+// c can be reused across repeated products. Returns false (leaving c
+// untouched) when dimensions do not agree
+template<typename TypeA, typename TypeB, typename Type,
+         typename = std::enable_if_t<!std::is_const_v<Type>
+                                     && std::is_same_v<std::remove_const_t<TypeA>, Type>
+                                     && std::is_same_v<std::remove_const_t<TypeB>, Type>>>
+bool multiply(const MatrixView<TypeA>& a, const MatrixView<TypeB>& b, const MatrixView<Type>& c){
+  // checks dimensions
+  if (a.num_cols != b.num_rows || c.num_rows != a.num_rows || c.num_cols != b.num_cols){
+    return false;
+  }
+  // c cannot be overwritten while it is still being read, so if it
+  // shares elements with a factor we multiply into a temporary
+  if (matrix_detail::overlap(c, a) || matrix_detail::overlap(c, b)){
+    Matrix<Type> product {a.num_rows, b.num_cols};
+    multiply(a, b, product.view());
+    c = product.view();
+
+    return true;
+  }
+  // arithmetic types use the blocked, packed kernels
+  if constexpr (matrix_detail::packed_multiplication<Type>){
+    c = Type{};
+
+    matrix_detail::gemm(a.num_rows, b.num_cols, a.num_cols,
+                        a.data(), a.stride(),
+                        b.data(), b.stride(),
+                        c.data(), c.stride());
+  }
+  // any other Type gets a plain loop
+  else{
+    matrix_detail::multiply_generic(a, b, c);
+  }
+
+  return true;
+}
+// computes the product of a and b into c, which must have been
+// allocated as a a.num_rows x b.num_cols matrix. Returns false
+// (leaving c untouched) when dimensions do not agree
+template<typename Type, typename StorageA, typename StorageB, typename StorageC>
+bool multiply(const Matrix<Type, StorageA>& a, const Matrix<Type, StorageB>& b, Matrix<Type, StorageC>& c){
+  // matrices of bool have no views, as they are stored bitwise
+  if constexpr (std::is_same_v<Type, bool>){
+    if (a.num_cols != b.num_rows || c.num_rows != a.num_rows || c.num_cols != b.num_cols){
+      return false;
+    }
+
+    if (static_cast<const void*>(&c) == &a || static_cast<const void*>(&c) == &b){
+      Matrix<Type, StorageC> product {a.num_rows, b.num_cols};
+      matrix_detail::multiply_generic(a, b, product);
+      c = std::move(product);
+    }
+    else{
+      matrix_detail::multiply_generic(a, b, c);
+    }
+
+    return true;
+  }
+  else{
+    return multiply(a.view(), b.view(), c.view());
+  }
+}
+// returns the product of a and b, if their dimensions agree
+template<typename Type, typename StorageA, typename StorageB>
+std::optional<Matrix<Type, StorageA>> multiply(const Matrix<Type, StorageA>& a, const Matrix<Type, StorageB>& b){
+  if (a.num_cols != b.num_rows){
+    return {};
+  }
+
+  Matrix<Type, StorageA> c {a.num_rows, b.num_cols};
+  multiply(a, b, c);
+
+  return c;
+}
+
+// out-of-place transposition, used by transpose below
+namespace matrix_detail{
+  // copies the transpose of block [i_0, i_1) x [j_0, j_1) of a into t,
+  // splitting the larger dimension in halves until blocks are small
+  // enough to be handled by plain loops
+  template<typename Source, typename Target>
+  void transpose_block(const Source& a, Target&& t,
+                       size_type i_0, size_type i_1, size_type j_0, size_type j_1){
+    constexpr size_type block {32};
+
+    if (i_1 - i_0 <= block && j_1 - j_0 <= block){
+      for (size_type i {i_0}; i < i_1; ++i){
+        for (size_type j {j_0}; j < j_1; ++j){
+          t.at(j, i) = a.const_at(i, j);
+        }
+      }
+    }
+    else if (i_1 - i_0 >= j_1 - j_0){
+      const size_type middle {i_0 + (i_1 - i_0) / 2};
+      transpose_block(a, t, i_0, middle, j_0, j_1);
+      transpose_block(a, t, middle, i_1, j_0, j_1);
+    }
+    else{
+      const size_type middle {j_0 + (j_1 - j_0) / 2};
+      transpose_block(a, t, i_0, i_1, j_0, middle);
+      transpose_block(a, t, i_0, i_1, middle, j_1);
+    }
+  }
+}
+// writes the transpose of a into t, which must have been allocated as
+// a a.num_cols x a.num_rows matrix. Returns false (leaving t
+// untouched) when dimensions do not agree
+template<typename Type, typename StorageA, typename StorageT>
+bool transpose(const Matrix<Type, StorageA>& a, Matrix<Type, StorageT>& t){
+  if (t.num_rows != a.num_cols || t.num_cols != a.num_rows){
+    return false;
+  }
+  // a square matrix may be transposed into itself
+  if (static_cast<const void*>(&t) == &a){
+    t.transpose();
+
+    return true;
+  }
+
+  matrix_detail::transpose_block(a, t, 0, a.num_rows, 0, a.num_cols);
+
+  return true;
+}
+// writes the transpose of view a into view t, which must have
+// a.num_cols rows and a.num_rows columns, and must not overlap
+// a. Returns false (leaving t untouched) otherwise
+template<typename TypeA, typename Type,
+         typename = std::enable_if_t<!std::is_const_v<Type> && std::is_same_v<std::remove_const_t<TypeA>, Type>>>
+bool transpose(const MatrixView<TypeA>& a, const MatrixView<Type>& t){
+  if (t.num_rows != a.num_cols || t.num_cols != a.num_rows || matrix_detail::overlap(a, t)){
+    return false;
+  }
+
+  matrix_detail::transpose_block(a, t, 0, a.num_rows, 0, a.num_cols);
+
+  return true;
+}
+
+// triangular kernels. They work on the packed storage of
+// UpperTriangularMatrix (and of the transpose behind a
+// LowerTriangularMatrix) directly, so substitutions never expand
+// triangles to dense matrices
+namespace matrix_detail{
+  // dot product of n elements. Independent partial sums let compilers
+  // vectorize the loop without reordering a single sum
+  template<typename Type>
+  Type dot(const Type* a, const Type* b, size_type n){
+    Type partial[8] {};
+    size_type k {0};
+
+    for (; k + 8 <= n; k += 8){
+      for (size_type t {0}; t < 8; ++t){
+        partial[t] += a[k + t] * b[k + t];
+      }
+    }
+    for (; k < n; ++k){
+      partial[0] += a[k] * b[k];
+    }
+
+    Type sum {};
+    for (size_type t {0}; t < 8; ++t){
+      sum += partial[t];
+    }
+
+    return sum;
+  }
+  // y += alpha * x, for n elements
+  template<typename Type>
+  void axpy(Type alpha, const Type* x, Type* y, size_type n){
+    for (size_type k {0}; k < n; ++k){
+      y[k] += alpha * x[k];
+    }
+  }
+  // element (i, j), with i <= j, of upper triangular u
+  template<typename Type>
+  Type triangular_element(const UpperTriangularMatrix<Type>& u, size_type i, size_type j){
+    const Type* row {u.row_data(i)};
+
+    return u.row_reversed(i) ? row[(u.num_rows - 1) - j] : row[j - i];
+  }
+  // whether every diagonal element of u is nonzero
+  template<typename Type>
+  bool invertible(const UpperTriangularMatrix<Type>& u){
+    for (size_type i {0}; i < u.num_rows; ++i){
+      if (triangular_element(u, i, i) == Type{}){
+        return false;
+      }
+    }
+
+    return true;
+  }
+  // copies rows [i_0, i_1) and columns [j_0, j_1) of u (or of its
+  // transpose, if lower) linewise into packed, scaled by scale and
+  // with zeros outside the triangle, so they can be fed to gemm
+  template<typename Type>
+  void pack_triangular(const UpperTriangularMatrix<Type>& u, bool lower,
+                       size_type i_0, size_type i_1, size_type j_0, size_type j_1,
+                       Type scale, Type* packed){
+    for (size_type i {i_0}; i < i_1; ++i){
+      for (size_type j {j_0}; j < j_1; ++j){
+        if (lower){
+          *packed++ = j <= i ? scale * triangular_element(u, j, i) : Type{};
+        }
+        else{
+          *packed++ = i <= j ? scale * triangular_element(u, i, j) : Type{};
+        }
+      }
+    }
+  }
+  // first row of u stored right to left
+  template<typename Type>
+  size_type first_reversed_row(const UpperTriangularMatrix<Type>& u){
+    size_type i {0};
+    while (i < u.num_rows && !u.row_reversed(i)){
+      ++i;
+    }
+
+    return i;
+  }
+  // number of rows of the diagonal blocks of blocked kernels
+  constexpr size_type triangular_block {64};
+  // y = u * x when lower is false, y = u^T * x otherwise. Rows of u in
+  // its upper half go left to right and are used with x (or y) as is;
+  // rows in the lower half go right to left, so they are used with a
+  // reversed copy of the tail of x (or y)
+  template<typename Type>
+  void triangular_vector_product(const UpperTriangularMatrix<Type>& u, bool lower, const Type* x, Type* y){
+    const size_type n {u.num_rows};
+    const size_type half {first_reversed_row(u)};
+    std::vector<Type> reversed (n - half);
+
+    if (!lower){
+      // y_i = u_i . x, for rows i in the lower half ...
+      for (size_type c {0}; c < n - half; ++c){
+        reversed[c] = x[(n - 1) - c];
+      }
+      std::vector<Type> tail (n - half);
+      for (size_type i {half}; i < n; ++i){
+        tail[i - half] = dot(u.row_data(i), reversed.data(), n - i);
+      }
+      // ... and in the upper half, which only read x[i..n), so x and y
+      // may be the same array
+      for (size_type i {0}; i < half; ++i){
+        y[i] = dot(u.row_data(i), x + i, n - i);
+      }
+      std::copy(tail.begin(), tail.end(), y + half);
+    }
+    else{
+      // row j of u scatters x_j times itself to y[j..n)
+      std::vector<Type> result (n);
+      for (size_type j {0}; j < half; ++j){
+        axpy(x[j], u.row_data(j), result.data() + j, n - j);
+      }
+      for (size_type j {half}; j < n; ++j){
+        axpy(x[j], u.row_data(j), reversed.data(), n - j);
+      }
+      for (size_type i {half}; i < n; ++i){
+        result[i] += reversed[(n - 1) - i];
+      }
+      std::copy(result.begin(), result.end(), y);
+    }
+  }
+  // solves u * x = b (u^T * x = b when lower) in place, u being
+  // invertible. Back substitution takes dot products with rows of u;
+  // forward substitution (on u^T) scatters rows of u instead
+  template<typename Type>
+  void triangular_vector_solve(const UpperTriangularMatrix<Type>& u, bool lower, Type* b){
+    const size_type n {u.num_rows};
+    const size_type half {first_reversed_row(u)};
+    // tail of b (and then x) in reverse order, to be used with lower
+    // half rows
+    std::vector<Type> reversed (n - half);
+
+    if (!lower){
+      for (size_type c {0}; c < n - half; ++c){
+        reversed[c] = b[(n - 1) - c];
+      }
+      for (size_type i {n}; i-- > half;){
+        const Type* row {u.row_data(i)};
+        const size_type last {(n - 1) - i};
+        reversed[last] = (reversed[last] - dot(row, reversed.data(), last)) / row[last];
+      }
+      for (size_type c {0}; c < n - half; ++c){
+        b[(n - 1) - c] = reversed[c];
+      }
+      for (size_type i {half}; i-- > 0;){
+        const Type* row {u.row_data(i)};
+        b[i] = (b[i] - dot(row + 1, b + i + 1, (n - 1) - i)) / row[0];
+      }
+    }
+    else{
+      for (size_type j {0}; j < half; ++j){
+        const Type* row {u.row_data(j)};
+        b[j] /= row[0];
+        axpy(-b[j], row + 1, b + j + 1, (n - 1) - j);
+      }
+      // the upper half has updated the tail of b
+      for (size_type c {0}; c < n - half; ++c){
+        reversed[c] = b[(n - 1) - c];
+      }
+      for (size_type j {half}; j < n; ++j){
+        const Type* row {u.row_data(j)};
+        const size_type last {(n - 1) - j};
+        reversed[last] /= row[last];
+        axpy(-reversed[last], row, reversed.data(), last);
+      }
+      for (size_type c {0}; c < n - half; ++c){
+        b[(n - 1) - c] = reversed[c];
+      }
+    }
+  }
+  // c = u * b (u^T * b when lower), for b and c n x m with rows ldb
+  // and ldc elements apart. Each block of rows of u is packed and
+  // multiplied by gemm
+  template<typename Type>
+  void triangular_matrix_product(const UpperTriangularMatrix<Type>& u, bool lower, size_type m,
+                                 const Type* b, size_type ldb, Type* c, size_type ldc){
+    const size_type n {u.num_rows};
+    std::vector<Type> packed {};
+
+    for (size_type i_0 {0}; i_0 < n; i_0 += triangular_block){
+      const size_type i_1 {std::min(n, i_0 + triangular_block)};
+      // columns of this block row which are not zero
+      const size_type j_0 {lower ? 0 : i_0};
+      const size_type j_1 {lower ? i_1 : n};
+
+      for (size_type i {i_0}; i < i_1; ++i){
+        std::fill(c + i * ldc, c + i * ldc + m, Type{});
+      }
+      packed.resize((i_1 - i_0) * (j_1 - j_0));
+      pack_triangular(u, lower, i_0, i_1, j_0, j_1, Type{1}, packed.data());
+      gemm(i_1 - i_0, m, j_1 - j_0, packed.data(), j_1 - j_0, b + j_0 * ldb, ldb, c + i_0 * ldc, ldc);
+    }
+  }
+  // solves u * x = b (u^T * x = b when lower) in place, for b n x m
+  // with rows ldb elements apart and u invertible. Blocks of rows of
+  // b are first updated by gemm with the rows already solved, and
+  // then solved against the diagonal block of u, row by row
+  template<typename Type>
+  void triangular_matrix_solve(const UpperTriangularMatrix<Type>& u, bool lower, size_type m, Type* b, size_type ldb){
+    const size_type n {u.num_rows};
+    const size_type blocks {(n + triangular_block - 1) / triangular_block};
+    std::vector<Type> packed {};
+
+    for (size_type k {0}; k < blocks; ++k){
+      // back substitution goes through blocks bottom up
+      const size_type i_0 {(lower ? k : (blocks - 1) - k) * triangular_block};
+      const size_type i_1 {std::min(n, i_0 + triangular_block)};
+      // rows already solved
+      const size_type j_0 {lower ? 0 : i_1};
+      const size_type j_1 {lower ? i_0 : n};
+
+      if (j_0 < j_1){
+        packed.resize((i_1 - i_0) * (j_1 - j_0));
+        pack_triangular(u, lower, i_0, i_1, j_0, j_1, Type{-1}, packed.data());
+        gemm(i_1 - i_0, m, j_1 - j_0, packed.data(), j_1 - j_0, b + j_0 * ldb, ldb, b + i_0 * ldb, ldb);
+      }
+
+      for (size_type t {0}; t < i_1 - i_0; ++t){
+        const size_type i {lower ? i_0 + t : (i_1 - 1) - t};
+        Type* b_i {b + i * ldb};
+        if (lower){
+          for (size_type j {i_0}; j < i; ++j){
+            axpy(-triangular_element(u, j, i), b + j * ldb, b_i, m);
+          }
+        }
+        else{
+          for (size_type j {i + 1}; j < i_1; ++j){
+            axpy(-triangular_element(u, i, j), b + j * ldb, b_i, m);
+          }
+        }
+        const Type diagonal {triangular_element(u, i, i)};
+        for (size_type k {0}; k < m; ++k){
+          b_i[k] /= diagonal;
+        }
+      }
+    }
+  }
+}
+// triangular matrix-vector product y = u * x. x and y may be the same
+// vector. Returns false (leaving y untouched) when dimensions do not
+// agree
+template<typename Type>
+bool multiply(const UpperTriangularMatrix<Type>& u, const std::vector<Type>& x, std::vector<Type>& y){
+  if (x.size() != u.num_cols || y.size() != u.num_rows){
+    return false;
+  }
+
+  matrix_detail::triangular_vector_product(u, false, x.data(), y.data());
+
+  return true;
+}
+template<typename Type>
+bool multiply(const LowerTriangularMatrix<Type>& l, const std::vector<Type>& x, std::vector<Type>& y){
+  if (x.size() != l.num_cols || y.size() != l.num_rows){
+    return false;
+  }
+
+  matrix_detail::triangular_vector_product(l.transposed(), true, x.data(), y.data());
+
+  return true;
+}
+// triangular times dense product c = u * b. Returns false (leaving c
+// untouched) when dimensions do not agree
+template<typename Type, typename StorageB, typename StorageC>
+bool multiply(const UpperTriangularMatrix<Type>& u, const Matrix<Type, StorageB>& b, Matrix<Type, StorageC>& c){
+  if (b.num_rows != u.num_cols || c.num_rows != u.num_rows || c.num_cols != b.num_cols){
+    return false;
+  }
+  // c must not be read while it is written
+  if (matrix_detail::overlap(b.view(), c.view())){
+    Matrix<Type> product {c.num_rows, c.num_cols};
+    matrix_detail::triangular_matrix_product(u, false, b.num_cols, b.data(), b.stride(), product.data(), product.stride());
+    c.view() = product.view();
+  }
+  else{
+    matrix_detail::triangular_matrix_product(u, false, b.num_cols, b.data(), b.stride(), c.data(), c.stride());
+  }
+
+  return true;
+}
+template<typename Type, typename StorageB, typename StorageC>
+bool multiply(const LowerTriangularMatrix<Type>& l, const Matrix<Type, StorageB>& b, Matrix<Type, StorageC>& c){
+  if (b.num_rows != l.num_cols || c.num_rows != l.num_rows || c.num_cols != b.num_cols){
+    return false;
+  }
+
+  if (matrix_detail::overlap(b.view(), c.view())){
+    Matrix<Type> product {c.num_rows, c.num_cols};
+    matrix_detail::triangular_matrix_product(l.transposed(), true, b.num_cols, b.data(), b.stride(), product.data(), product.stride());
+    c.view() = product.view();
+  }
+  else{
+    matrix_detail::triangular_matrix_product(l.transposed(), true, b.num_cols, b.data(), b.stride(), c.data(), c.stride());
+  }
+
+  return true;
+}
+// triangular solves: overwrite b with the solution x of u * x = b (or
+// l * x = b) by back (or forward) substitution. b may be a vector or
+// a matrix with any number of columns. Return false (leaving b
+// untouched) when dimensions do not agree or the triangular matrix
+// is singular
+template<typename Type>
+bool solve(const UpperTriangularMatrix<Type>& u, std::vector<Type>& b){
+  if (b.size() != u.num_rows || !matrix_detail::invertible(u)){
+    return false;
+  }
+
+  matrix_detail::triangular_vector_solve(u, false, b.data());
+
+  return true;
+}
+template<typename Type>
+bool solve(const LowerTriangularMatrix<Type>& l, std::vector<Type>& b){
+  if (b.size() != l.num_rows || !matrix_detail::invertible(l.transposed())){
+    return false;
+  }
+
+  matrix_detail::triangular_vector_solve(l.transposed(), true, b.data());
+
+  return true;
+}
+template<typename Type, typename Storage>
+bool solve(const UpperTriangularMatrix<Type>& u, Matrix<Type, Storage>& b){
+  if (b.num_rows != u.num_rows || !matrix_detail::invertible(u)){
+    return false;
+  }
+
+  matrix_detail::triangular_matrix_solve(u, false, b.num_cols, b.data(), b.stride());
+
+  return true;
+}
+template<typename Type, typename Storage>
+bool solve(const LowerTriangularMatrix<Type>& l, Matrix<Type, Storage>& b){
+  if (b.num_rows != l.num_rows || !matrix_detail::invertible(l.transposed())){
+    return false;
+  }
+
+  matrix_detail::triangular_matrix_solve(l.transposed(), true, b.num_cols, b.data(), b.stride());
+
+  return true;
+}
+// symmetric kernels. They go through the packed upper triangle of a
+// SymmetricMatrix once, each stored element standing for both (i, j)
+// and (j, i)
+namespace matrix_detail{
+  // returns the dot product of a and x, while adding alpha * a to y,
+  // for n elements, so that a is read once for both
+  template<typename Type>
+  Type dot_axpy(const Type* a, const Type* x, Type alpha, Type* y, size_type n){
+    Type partial[8] {};
+    size_type k {0};
+
+    for (; k + 8 <= n; k += 8){
+      for (size_type t {0}; t < 8; ++t){
+        partial[t] += a[k + t] * x[k + t];
+        y[k + t]   += alpha * a[k + t];
+      }
+    }
+    for (; k < n; ++k){
+      partial[0] += a[k] * x[k];
+      y[k]       += alpha * a[k];
+    }
+
+    Type sum {};
+    for (size_type t {0}; t < 8; ++t){
+      sum += partial[t];
+    }
+
+    return sum;
+  }
+}
+// symmetric matrix-vector product y = s * x. Stored row i holds
+// s(i, j) for j >= i: it contributes s(i, j) * x_j to y_i and, as
+// s(j, i), s(i, j) * x_i to y_j. Rows stored right to left work on
+// reversed copies of the tails of x and y. Returns false (leaving y
+// untouched) when dimensions do not agree
+template<typename Type>
+bool multiply(const SymmetricMatrix<Type>& s, const std::vector<Type>& x, std::vector<Type>& y){
+  using size_type = typename SymmetricMatrix<Type>::size_type;
+
+  if (x.size() != s.num_cols || y.size() != s.num_rows){
+    return false;
+  }
+
+  const auto& u {s.upper()};
+  const size_type n {s.num_rows};
+  const size_type half {matrix_detail::first_reversed_row(u)};
+
+  std::vector<Type> result (n);
+  std::vector<Type> x_reversed (n - half);
+  std::vector<Type> y_reversed (n - half);
+  for (size_type c {0}; c < n - half; ++c){
+    x_reversed[c] = x[(n - 1) - c];
+  }
+
+  for (size_type i {0}; i < half; ++i){
+    const Type* row {u.row_data(i)};
+    result[i] += row[0] * x[i]
+               + matrix_detail::dot_axpy(row + 1, x.data() + i + 1, x[i], result.data() + i + 1, (n - 1) - i);
+  }
+  for (size_type i {half}; i < n; ++i){
+    const Type* row {u.row_data(i)};
+    const size_type last {(n - 1) - i};
+    y_reversed[last] += row[last] * x[i]
+                      + matrix_detail::dot_axpy(row, x_reversed.data(), x[i], y_reversed.data(), last);
+  }
+  for (size_type c {0}; c < n - half; ++c){
+    result[(n - 1) - c] += y_reversed[c];
+  }
+
+  std::copy(result.begin(), result.end(), y.begin());
+
+  return true;
+}
+// symmetric rank-k update c += alpha * a * a^T, where a is n x k.
+// Blocks of a * a^T on or above the diagonal are computed by gemm
+// (against a transposed copy of a) and added to the stored triangle,
+// so about half of the product is computed. Returns false (leaving c
+// untouched) when dimensions do not agree
+template<typename Type, typename Storage>
+bool rank_update(SymmetricMatrix<Type>& c, const Matrix<Type, Storage>& a, Type alpha = Type{1}){
+  using size_type = typename SymmetricMatrix<Type>::size_type;
+
+  if (a.num_rows != c.num_rows){
+    return false;
+  }
+
+  auto& u {c.upper()};
+  const size_type n {a.num_rows};
+  const size_type k {a.num_cols};
+  constexpr size_type block {matrix_detail::triangular_block};
+
+  Matrix<Type> a_transposed {k, n};
+  transpose(a, a_transposed);
+  std::vector<Type> tile (block * block);
+
+  for (size_type i_0 {0}; i_0 < n; i_0 += block){
+    const size_type i_1 {std::min(n, i_0 + block)};
+    for (size_type j_0 {i_0}; j_0 < n; j_0 += block){
+      const size_type j_1 {std::min(n, j_0 + block)};
+      const size_type width {j_1 - j_0};
+
+      std::fill(tile.begin(), tile.end(), Type{});
+      matrix_detail::gemm(i_1 - i_0, width, k, a.data() + i_0 * a.stride(), a.stride(),
+                          a_transposed.data() + j_0, a_transposed.stride(), tile.data(), width);
+
+      for (size_type i {i_0}; i < i_1; ++i){
+        Type* row {u.row_data(i)};
+        const Type* tile_i {tile.data() + (i - i_0) * width};
+        for (size_type j {std::max(i, j_0)}; j < j_1; ++j){
+          (u.row_reversed(i) ? row[(n - 1) - j] : row[j - i]) += alpha * tile_i[j - j_0];
+        }
+      }
+    }
+  }
+
+  return true;
+}
 
 #endif
@@ -0,0 +1,293 @@
+// another way to achieve what #pragma once does
+#ifndef matrix_file_hpp
+#define matrix_file_hpp
+// header fields have fixed widths
+#include <cstdint>
+// we compare magic strings
+#include <cstring>
+// matrices are written and read through file streams
+#include <fstream>
+// loading or opening a file may fail
+#include <optional>
+// files are named by strings
+#include <string>
+// element types are checked against the file
+#include <type_traits>
+// files are opened and memory mapped through POSIX calls
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+// matrices are saved from and loaded into Matrix, and mapped files are
+// seen through MatrixView
+#include <matrix.hpp>
+// on-disk format of a matrix, version 1: this 64 byte header,
+// followed (at data_offset bytes from the start of the file) by
+// num_rows * stride elements, linewise, exactly as they are laid out
+// in memory. Fields are stored in the byte order of the machine that
+// wrote the file, which byte_order tells
+struct MatrixFileHeader{
+  // kinds of elements
+  enum Kind : std::uint32_t {signed_integer = 1, unsigned_integer = 2, floating_point = 3};
+  // identifies matrix files
+  static constexpr char matrix_magic[8] {'M', 'A', 'T', 'R', 'I', 'X', '\0', '\0'};
+  static constexpr std::uint32_t current_version {1};
+  static constexpr std::uint32_t native_byte_order {0x01020304};
+
+  char          magic[8];
+  std::uint32_t version;
+  std::uint32_t byte_order;
+  // type of elements: its kind and its size in bytes
+  std::uint32_t kind;
+  std::uint32_t element_size;
+  // dimensions, and distance between consecutive rows (in elements)
+  std::uint64_t num_rows;
+  std::uint64_t num_cols;
+  std::uint64_t stride;
+  // position of first element, a multiple of 64 so that mapped
+  // elements are as aligned as cache lines
+  std::uint64_t data_offset;
+  std::uint64_t reserved;
+  // kind of Type
+  template<typename Type>
+  static constexpr Kind kind_of(){
+    if constexpr (std::is_floating_point_v<Type>){
+      return floating_point;
+    }
+    else if constexpr (std::is_signed_v<Type>){
+      return signed_integer;
+    }
+    else{
+      return unsigned_integer;
+    }
+  }
+  // header of a rows x cols matrix of Type, rows stride elements apart
+  template<typename Type>
+  static MatrixFileHeader make(std::uint64_t rows, std::uint64_t cols, std::uint64_t stride){
+    MatrixFileHeader header {};
+    std::memcpy(header.magic, matrix_magic, sizeof(magic));
+    header.version      = current_version;
+    header.byte_order   = native_byte_order;
+    header.kind         = kind_of<Type>();
+    header.element_size = sizeof(Type);
+    header.num_rows     = rows;
+    header.num_cols     = cols;
+    header.stride       = stride;
+    header.data_offset  = sizeof(MatrixFileHeader);
+
+    return header;
+  }
+  // whether this is the header of a matrix of Type, whose elements fit
+  // in a file of file_size bytes
+  template<typename Type>
+  bool valid(std::uint64_t file_size) const{
+    if (std::memcmp(magic, matrix_magic, sizeof(magic)) != 0 || version != current_version
+        || byte_order != native_byte_order || kind != kind_of<Type>() || element_size != sizeof(Type)){
+      return false;
+    }
+    if (stride < num_cols || data_offset < sizeof(MatrixFileHeader) || data_offset % 64 != 0 || data_offset > file_size){
+      return false;
+    }
+    // number of elements, checking for overflows
+    const std::uint64_t available {(file_size - data_offset) / sizeof(Type)};
+
+    return stride == 0 || num_rows <= available / stride;
+  }
+};
+static_assert(sizeof(MatrixFileHeader) == 64, "matrix file header must take 64 bytes");
+// writes m to a file at path. Returns false if the file could not be
+// written
+template<typename Type, typename Storage>
+bool save(const Matrix<Type, Storage>& m, const std::string& path){
+  static_assert(std::is_arithmetic_v<Type> && !std::is_same_v<Type, bool>, "only arithmetic elements can be saved");
+
+  const auto header {MatrixFileHeader::make<Type>(m.num_rows, m.num_cols, m.stride())};
+  std::ofstream file {path, std::ios::binary | std::ios::trunc};
+  // elements are written as they are in memory, padding included, in
+  // a single call
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char*>(m.data()), m.num_rows * m.stride() * sizeof(Type));
+
+  return static_cast<bool>(file.flush());
+}
+// reads a matrix of Type from the file at path into memory. Nothing is
+// returned if the file cannot be read, or does not hold a matrix of
+// Type. Rows are read as a whole when the file has the stride of
+// Storage, and one by one otherwise
+template<typename Type, typename Storage = PackedRows>
+std::optional<Matrix<Type, Storage>> load(const std::string& path){
+  std::ifstream file {path, std::ios::binary | std::ios::ate};
+  if (!file){
+    return {};
+  }
+  const std::uint64_t file_size {static_cast<std::uint64_t>(file.tellg())};
+
+  MatrixFileHeader header {};
+  if (file_size < sizeof(header) || !file.seekg(0).read(reinterpret_cast<char*>(&header), sizeof(header))
+      || !header.valid<Type>(file_size)){
+    return {};
+  }
+
+  Matrix<Type, Storage> result {header.num_rows, header.num_cols};
+  file.seekg(header.data_offset);
+
+  if (result.stride() == header.stride){
+    file.read(reinterpret_cast<char*>(result.data()), header.num_rows * header.stride * sizeof(Type));
+  }
+  else{
+    for (std::size_t i {0}; i < header.num_rows && file; ++i){
+      file.seekg(header.data_offset + i * header.stride * sizeof(Type));
+      file.read(reinterpret_cast<char*>(&result.at(i, 0)), header.num_cols * sizeof(Type));
+    }
+  }
+
+  if (!file){
+    return {};
+  }
+
+  return result;
+}
+// read-only matrix backed by a memory mapped matrix file. Opening a
+// file only maps it, so it takes constant time whatever the size of
+// the matrix, and the operating system reads pages in lazily, when
+// elements are first accessed. Mapped matrices are seen through
+// MatrixView<const Type>, so they can be used in products, in
+// expressions, or copied into a Matrix
+template<typename Type>
+class MappedMatrix{
+  static_assert(std::is_arithmetic_v<Type> && !std::is_same_v<Type, bool>, "only arithmetic elements can be mapped");
+public:
+  // types of elements and indices
+  using value_type = Type;
+  using size_type  = std::size_t;
+private:
+  // start and size of mapping, and first element in it
+  void*       mapping_;
+  size_type   mapping_size_;
+  const Type* data_;
+  // dimensions and distance between rows
+  size_type rows_;
+  size_type cols_;
+  size_type stride_;
+  // takes ownership of a mapping holding a valid header
+  MappedMatrix(void* mapping, size_type mapping_size, const MatrixFileHeader& header)
+    : mapping_{mapping}, mapping_size_{mapping_size},
+      data_{reinterpret_cast<const Type*>(static_cast<const char*>(mapping) + header.data_offset)},
+      rows_{header.num_rows}, cols_{header.num_cols}, stride_{header.stride},
+      num_rows{rows_}, num_cols{cols_}
+  {}
+  // releases mapping, if any
+  void unmap_(){
+#ifdef __linux__
+    if (mapping_ != nullptr){
+      munmap(mapping_, mapping_size_);
+    }
+#endif
+    mapping_ = nullptr;
+  }
+public:
+  // const references to number of rows and columns
+  const size_type& num_rows;
+  const size_type& num_cols;
+  // maps the matrix file at path. Nothing is returned if the file
+  // cannot be mapped, or does not hold a matrix of Type. Mapping is
+  // only supported on Linux; elsewhere, use load
+  static std::optional<MappedMatrix> open(const std::string& path){
+#ifdef __linux__
+    const int descriptor {::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+    if (descriptor < 0){
+      return {};
+    }
+
+    struct stat status {};
+    if (fstat(descriptor, &status) != 0 || static_cast<std::uint64_t>(status.st_size) < sizeof(MatrixFileHeader)){
+      close(descriptor);
+      return {};
+    }
+
+    const size_type size {static_cast<size_type>(status.st_size)};
+    void* mapping {mmap(nullptr, size, PROT_READ, MAP_SHARED, descriptor, 0)};
+    // the mapping stays valid once the file is closed
+    close(descriptor);
+    if (mapping == MAP_FAILED){
+      return {};
+    }
+
+    const auto& header {*static_cast<const MatrixFileHeader*>(mapping)};
+    if (!header.valid<Type>(size)){
+      munmap(mapping, size);
+      return {};
+    }
+
+    return MappedMatrix{mapping, size, header};
+#else
+    static_cast<void>(path);
+
+    return {};
+#endif
+  }
+  // mappings are not shared, but moved
+  MappedMatrix(const MappedMatrix&) = delete;
+  MappedMatrix& operator=(const MappedMatrix&) = delete;
+  MappedMatrix(MappedMatrix&& m)
+    : mapping_{m.mapping_}, mapping_size_{m.mapping_size_}, data_{m.data_},
+      rows_{m.rows_}, cols_{m.cols_}, stride_{m.stride_},
+      num_rows{rows_}, num_cols{cols_}
+  {
+    m.mapping_ = nullptr;
+    m.rows_    = 0;
+    m.cols_    = 0;
+    m.stride_  = 0;
+  }
+  MappedMatrix& operator=(MappedMatrix&& m){
+    if (this != &m){
+      unmap_();
+
+      mapping_      = m.mapping_;
+      mapping_size_ = m.mapping_size_;
+      data_         = m.data_;
+      rows_         = m.rows_;
+      cols_         = m.cols_;
+      stride_       = m.stride_;
+
+      m.mapping_ = nullptr;
+      m.rows_    = 0;
+      m.cols_    = 0;
+      m.stride_  = 0;
+    }
+
+    return *this;
+  }
+  ~MappedMatrix(){
+    unmap_();
+  }
+  // returns a copy of element at position (i, j)
+  Type const_at(size_type i, size_type j) const{
+    return data_[stride_ * i + j];
+  }
+  // pointer to the first element. Consecutive rows are stride()
+  // elements apart
+  const Type* data() const{
+    return data_;
+  }
+  // distance between consecutive rows
+  size_type stride() const{
+    return stride_;
+  }
+  // view of the whole matrix
+  MatrixView<const Type> view() const{
+    return {data_, 0, rows_, cols_, stride_};
+  }
+  // view of the rows x cols block whose upper left corner is (i, j)
+  MatrixView<const Type> block(size_type i, size_type j, size_type rows, size_type cols) const{
+    return {data_, stride_ * i + j, rows, cols, stride_};
+  }
+  // a mapped matrix is an operand of expressions
+  friend matrix_detail::ViewOperand<MatrixView<const Type>> make_operand(const MappedMatrix& m){
+    return {m.view()};
+  }
+};
+
+#endif
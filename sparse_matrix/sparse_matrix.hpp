@@ -0,0 +1,514 @@
+// another way to achieve what #pragma once does
+#ifndef sparse_matrix_hpp
+#define sparse_matrix_hpp
+// sorting and binary search of indices
+#include <algorithm>
+// construction from triplets may fail
+#include <optional>
+// nonzero elements and their indices are stored in vectors
+#include <vector>
+// sparse matrices are converted from and to dense ones, and
+// multiplied by them
+#include <matrix.hpp>
+// products are computed in parallel
+#include <thread_pool.hpp>
+// a nonzero element of a sparse matrix, at position (row, col)
+template<typename Type>
+struct Triplet{
+  std::size_t row;
+  std::size_t col;
+  Type        value;
+};
+// compressed storage shared by CSR and CSC matrices. Nonzero elements
+// are grouped in lines (rows for CSR, columns for CSC): the elements
+// of line l are at positions [start_[l], start_[l + 1]) of values_,
+// sorted by their index across the line, which is kept in index_.
+// Here, "major" positions identify lines and "minor" positions
+// identify elements within a line
+template<typename Type>
+class CompressedLines_{
+public:
+  using size_type  = std::size_t;
+  using value_type = Type;
+protected:
+  size_type              majors_;
+  size_type              minors_;
+  std::vector<size_type> start_;
+  std::vector<size_type> index_;
+  std::vector<Type>      values_;
+  // builds an empty matrix
+  CompressedLines_(size_type majors, size_type minors)
+    : majors_{majors}, minors_{minors}, start_(majors + 1, 0), index_{}, values_{}
+  {}
+  // builds lines from (major, minor, value) triplets, with no
+  // bound checks. Elements at the same position are summed, and zeros
+  // are not stored
+  template<typename Major, typename Minor>
+  void build_(const std::vector<Triplet<Type>>& triplets, Major major, Minor minor){
+    // counts elements of each line, then turns counts into starts
+    std::fill(start_.begin(), start_.end(), 0);
+    for (const auto& t : triplets){
+      ++start_[major(t) + 1];
+    }
+    for (size_type l {0}; l < majors_; ++l){
+      start_[l + 1] += start_[l];
+    }
+    // places each element in its line
+    std::vector<size_type> position (start_.begin(), start_.end() - 1);
+    std::vector<std::pair<size_type, Type>> entries (triplets.size());
+    for (const auto& t : triplets){
+      entries[position[major(t)]++] = {minor(t), t.value};
+    }
+    // sorts each line, merging duplicates and dropping zeros
+    index_.clear();
+    values_.clear();
+    index_.reserve(entries.size());
+    values_.reserve(entries.size());
+
+    size_type begin {0};
+    for (size_type l {0}; l < majors_; ++l){
+      const size_type end {start_[l + 1]};
+      std::sort(entries.begin() + begin, entries.begin() + end,
+                [](const auto& a, const auto& b){ return a.first < b.first; });
+
+      start_[l] = index_.size();
+      for (size_type k {begin}; k < end; ++k){
+        if (index_.size() > start_[l] && index_.back() == entries[k].first){
+          values_.back() += entries[k].second;
+        }
+        else{
+          index_.push_back(entries[k].first);
+          values_.push_back(entries[k].second);
+        }
+      }
+      // drops elements summing to zero
+      size_type kept {start_[l]};
+      for (size_type k {start_[l]}; k < index_.size(); ++k){
+        if (values_[k] != Type{}){
+          index_[kept]  = index_[k];
+          values_[kept] = values_[k];
+          ++kept;
+        }
+      }
+      index_.resize(kept);
+      values_.resize(kept);
+
+      begin = end;
+    }
+    start_[majors_] = index_.size();
+  }
+  // returns a copy of the element at line major, position minor
+  Type element_(size_type major, size_type minor) const{
+    const auto first {index_.begin() + start_[major]};
+    const auto last  {index_.begin() + start_[major + 1]};
+    const auto found {std::lower_bound(first, last, minor)};
+
+    if (found != last && *found == minor){
+      return values_[found - index_.begin()];
+    }
+    else{
+      return {};
+    }
+  }
+public:
+  // number of stored (nonzero) elements
+  size_type num_nonzeros() const{
+    return values_.size();
+  }
+};
+template<typename Type>
+class CscMatrix;
+// class to represent a sparse matrix in compressed sparse row
+// format. Only nonzero elements are stored, row by row, so the
+// nonzeros of a row are contiguous
+template<typename Type>
+class CsrMatrix : public CompressedLines_<Type>{
+  // alias to superclass
+  using Lines = CompressedLines_<Type>;
+  // CSC matrices are built from our lines
+  friend class CscMatrix<Type>;
+public:
+  using size_type = typename Lines::size_type;
+  // const references to number of rows and number of columns
+  const size_type& num_rows;
+  const size_type& num_cols;
+  // builds a rows x cols matrix with no nonzero elements
+  CsrMatrix(size_type rows, size_type cols)
+    : Lines{rows, cols}, num_rows{this->majors_}, num_cols{this->minors_}
+  {}
+  // copy constructor
+  CsrMatrix(const CsrMatrix& m)
+    : Lines{m}, num_rows{this->majors_}, num_cols{this->minors_}
+  {}
+  // copy assignment
+  CsrMatrix& operator=(const CsrMatrix& m){
+    Lines::operator=(m);
+
+    return *this;
+  }
+  // move constructor
+  CsrMatrix(CsrMatrix&& m)
+    : Lines{std::move(m)}, num_rows{this->majors_}, num_cols{this->minors_}
+  {}
+  // move assignment
+  CsrMatrix& operator=(CsrMatrix&& m){
+    Lines::operator=(std::move(m));
+
+    return *this;
+  }
+  // builds a matrix holding the nonzero elements of dense matrix m
+  template<typename Storage>
+  explicit CsrMatrix(const Matrix<Type, Storage>& m)
+    : CsrMatrix{m.num_rows, m.num_cols}
+  {
+    for (size_type i {0}; i < m.num_rows; ++i){
+      for (size_type j {0}; j < m.num_cols; ++j){
+        const Type value {m.const_at(i, j)};
+        if (value != Type{}){
+          this->index_.push_back(j);
+          this->values_.push_back(value);
+        }
+      }
+      this->start_[i + 1] = this->values_.size();
+    }
+  }
+  // builds a matrix from its elements, given as triplets in any
+  // order. Elements at the same position are summed. Returns nothing
+  // if some triplet is out of bounds
+  static std::optional<CsrMatrix> from_triplets(size_type rows, size_type cols, const std::vector<Triplet<Type>>& triplets){
+    for (const auto& t : triplets){
+      if (t.row >= rows || t.col >= cols){
+        return {};
+      }
+    }
+
+    CsrMatrix m {rows, cols};
+    m.build_(triplets, [](const auto& t){ return t.row; }, [](const auto& t){ return t.col; });
+
+    return m;
+  }
+  // returns a copy of element at position (i, j)
+  Type const_at(size_type i, size_type j) const{
+    return this->element_(i, j);
+  }
+  // converts to a dense matrix
+  Matrix<Type> to_dense() const{
+    Matrix<Type> m {num_rows, num_cols};
+
+    for (size_type i {0}; i < num_rows; ++i){
+      for (size_type k {this->start_[i]}; k < this->start_[i + 1]; ++k){
+        m.at(i, this->index_[k]) = this->values_[k];
+      }
+    }
+
+    return m;
+  }
+  // the nonzero elements of row i are values()[k], at column
+  // col_index()[k], for k in [row_start()[i], row_start()[i + 1])
+  const std::vector<size_type>& row_start() const{
+    return this->start_;
+  }
+  const std::vector<size_type>& col_index() const{
+    return this->index_;
+  }
+  const std::vector<Type>& values() const{
+    return this->values_;
+  }
+};
+// class to represent a sparse matrix in compressed sparse column
+// format. Only nonzero elements are stored, column by column, so the
+// nonzeros of a column are contiguous
+template<typename Type>
+class CscMatrix : public CompressedLines_<Type>{
+  // alias to superclass
+  using Lines = CompressedLines_<Type>;
+public:
+  using size_type = typename Lines::size_type;
+  // const references to number of rows and number of columns
+  const size_type& num_rows;
+  const size_type& num_cols;
+  // builds a rows x cols matrix with no nonzero elements
+  CscMatrix(size_type rows, size_type cols)
+    : Lines{cols, rows}, num_rows{this->minors_}, num_cols{this->majors_}
+  {}
+  // copy constructor
+  CscMatrix(const CscMatrix& m)
+    : Lines{m}, num_rows{this->minors_}, num_cols{this->majors_}
+  {}
+  // copy assignment
+  CscMatrix& operator=(const CscMatrix& m){
+    Lines::operator=(m);
+
+    return *this;
+  }
+  // move constructor
+  CscMatrix(CscMatrix&& m)
+    : Lines{std::move(m)}, num_rows{this->minors_}, num_cols{this->majors_}
+  {}
+  // move assignment
+  CscMatrix& operator=(CscMatrix&& m){
+    Lines::operator=(std::move(m));
+
+    return *this;
+  }
+  // builds a matrix holding the nonzero elements of dense matrix m
+  template<typename Storage>
+  explicit CscMatrix(const Matrix<Type, Storage>& m)
+    : CscMatrix{m.num_rows, m.num_cols}
+  {
+    for (size_type j {0}; j < m.num_cols; ++j){
+      for (size_type i {0}; i < m.num_rows; ++i){
+        const Type value {m.const_at(i, j)};
+        if (value != Type{}){
+          this->index_.push_back(i);
+          this->values_.push_back(value);
+        }
+      }
+      this->start_[j + 1] = this->values_.size();
+    }
+  }
+  // builds the CSC representation of a CSR matrix: the nonzeros of
+  // each row are distributed to their columns, in row order
+  explicit CscMatrix(const CsrMatrix<Type>& m)
+    : CscMatrix{m.num_rows, m.num_cols}
+  {
+    this->index_.resize(m.num_nonzeros());
+    this->values_.resize(m.num_nonzeros());
+
+    for (auto j : m.index_){
+      ++this->start_[j + 1];
+    }
+    for (size_type j {0}; j < num_cols; ++j){
+      this->start_[j + 1] += this->start_[j];
+    }
+
+    std::vector<size_type> position (this->start_.begin(), this->start_.end() - 1);
+    for (size_type i {0}; i < m.num_rows; ++i){
+      for (size_type k {m.start_[i]}; k < m.start_[i + 1]; ++k){
+        const size_type p {position[m.index_[k]]++};
+        this->index_[p]  = i;
+        this->values_[p] = m.values_[k];
+      }
+    }
+  }
+  // builds a matrix from its elements, given as triplets in any
+  // order. Elements at the same position are summed. Returns nothing
+  // if some triplet is out of bounds
+  static std::optional<CscMatrix> from_triplets(size_type rows, size_type cols, const std::vector<Triplet<Type>>& triplets){
+    for (const auto& t : triplets){
+      if (t.row >= rows || t.col >= cols){
+        return {};
+      }
+    }
+
+    CscMatrix m {rows, cols};
+    m.build_(triplets, [](const auto& t){ return t.col; }, [](const auto& t){ return t.row; });
+
+    return m;
+  }
+  // returns a copy of element at position (i, j)
+  Type const_at(size_type i, size_type j) const{
+    return this->element_(j, i);
+  }
+  // converts to a dense matrix
+  Matrix<Type> to_dense() const{
+    Matrix<Type> m {num_rows, num_cols};
+
+    for (size_type j {0}; j < num_cols; ++j){
+      for (size_type k {this->start_[j]}; k < this->start_[j + 1]; ++k){
+        m.at(this->index_[k], j) = this->values_[k];
+      }
+    }
+
+    return m;
+  }
+  // the nonzero elements of column j are values()[k], at row
+  // row_index()[k], for k in [col_start()[j], col_start()[j + 1])
+  const std::vector<size_type>& col_start() const{
+    return this->start_;
+  }
+  const std::vector<size_type>& row_index() const{
+    return this->index_;
+  }
+  const std::vector<Type>& values() const{
+    return this->values_;
+  }
+};
+// sparse-dense products. Each one returns false (doing nothing) when
+// dimensions do not agree
+// sparse matrix-vector product y = a * x. Rows of a are split among
+// threads of pool, each one computing its own positions of y
+template<typename Type>
+bool multiply(const CsrMatrix<Type>& a, const std::vector<Type>& x, std::vector<Type>& y,
+              ThreadPool& pool = ThreadPool::shared()){
+  using size_type = typename CsrMatrix<Type>::size_type;
+
+  if (x.size() != a.num_cols || y.size() != a.num_rows){
+    return false;
+  }
+  // positions of y cannot be written while other threads may still
+  // read them as positions of x, so x * x goes through a temporary
+  if (&x == &y){
+    std::vector<Type> product (a.num_rows);
+    multiply(a, x, product, pool);
+    y.swap(product);
+
+    return true;
+  }
+
+  const size_type* start  {a.row_start().data()};
+  const size_type* column {a.col_index().data()};
+  const Type*      value  {a.values().data()};
+
+  pool.parallel_for(0, a.num_rows, [&](size_type first, size_type last){
+    for (size_type i {first}; i < last; ++i){
+      Type sum {};
+      for (size_type k {start[i]}; k < start[i + 1]; ++k){
+        sum += value[k] * x[column[k]];
+      }
+      y[i] = sum;
+    }
+  }, 256);
+
+  return true;
+}
+// sparse matrix-vector product y = a * x. Column by column, a
+// scatters its elements to y, so columns are split among threads,
+// each one accumulating into its own partial y, and partial vectors
+// are then summed up, again in parallel
+template<typename Type>
+bool multiply(const CscMatrix<Type>& a, const std::vector<Type>& x, std::vector<Type>& y,
+              ThreadPool& pool = ThreadPool::shared()){
+  using size_type = typename CscMatrix<Type>::size_type;
+
+  if (x.size() != a.num_cols || y.size() != a.num_rows){
+    return false;
+  }
+
+  const size_type* start {a.col_start().data()};
+  const size_type* row   {a.row_index().data()};
+  const Type*      value {a.values().data()};
+  // one partial vector per thread
+  const size_type parts {pool.num_threads()};
+  const size_type chunk {(a.num_cols + parts - 1) / parts};
+  std::vector<std::vector<Type>> partial (parts, std::vector<Type>(a.num_rows));
+
+  pool.parallel_for(0, parts, [&](size_type first, size_type last){
+    for (size_type p {first}; p < last; ++p){
+      const size_type end {std::min(a.num_cols, (p + 1) * chunk)};
+      for (size_type j {p * chunk}; j < end; ++j){
+        const Type x_j {x[j]};
+        for (size_type k {start[j]}; k < start[j + 1]; ++k){
+          partial[p][row[k]] += value[k] * x_j;
+        }
+      }
+    }
+  });
+
+  pool.parallel_for(0, a.num_rows, [&](size_type first, size_type last){
+    for (size_type i {first}; i < last; ++i){
+      Type sum {};
+      for (size_type p {0}; p < parts; ++p){
+        sum += partial[p][i];
+      }
+      y[i] = sum;
+    }
+  }, 1024);
+
+  return true;
+}
+// sparse matrix-dense matrix product c = a * b. Row i of c is the sum
+// of the rows of b selected by the nonzeros of row i of a, scaled by
+// them, so rows of b and c are traversed linewise. Rows of c are
+// split among threads
+template<typename Type, typename TypeB,
+         typename = std::enable_if_t<std::is_same_v<std::remove_const_t<TypeB>, Type>>>
+bool multiply(const CsrMatrix<Type>& a, const MatrixView<TypeB>& b, const MatrixView<Type>& c,
+              ThreadPool& pool = ThreadPool::shared()){
+  using size_type = typename CsrMatrix<Type>::size_type;
+
+  if (b.num_rows != a.num_cols || c.num_rows != a.num_rows || c.num_cols != b.num_cols){
+    return false;
+  }
+  // rows of c are cleared while other threads may still read them as
+  // rows of b, so if c shares elements with b we multiply into a
+  // temporary
+  if (matrix_detail::overlap(c, b)){
+    Matrix<Type> product {c.num_rows, c.num_cols};
+    multiply(a, b, product.view(), pool);
+    c = product.view();
+
+    return true;
+  }
+
+  const size_type n {b.num_cols};
+
+  pool.parallel_for(0, a.num_rows, [&](size_type first, size_type last){
+    for (size_type i {first}; i < last; ++i){
+      Type* c_i {&c.at(i, 0)};
+      std::fill(c_i, c_i + n, Type{});
+      for (size_type k {a.row_start()[i]}; k < a.row_start()[i + 1]; ++k){
+        const Type  a_ik {a.values()[k]};
+        const auto* b_k  {&b.at(a.col_index()[k], 0)};
+        for (size_type j {0}; j < n; ++j){
+          c_i[j] += a_ik * b_k[j];
+        }
+      }
+    }
+  }, 16);
+
+  return true;
+}
+// sparse matrix-dense matrix product c = a * b. Column k of a scales
+// row k of b into the rows of c selected by its nonzeros, so columns
+// of c are split among threads, each one updating its own block of
+// columns
+template<typename Type, typename TypeB,
+         typename = std::enable_if_t<std::is_same_v<std::remove_const_t<TypeB>, Type>>>
+bool multiply(const CscMatrix<Type>& a, const MatrixView<TypeB>& b, const MatrixView<Type>& c,
+              ThreadPool& pool = ThreadPool::shared()){
+  using size_type = typename CscMatrix<Type>::size_type;
+
+  if (b.num_rows != a.num_cols || c.num_rows != a.num_rows || c.num_cols != b.num_cols){
+    return false;
+  }
+  // c is cleared before b is read, so if they share elements we
+  // multiply into a temporary
+  if (matrix_detail::overlap(c, b)){
+    Matrix<Type> product {c.num_rows, c.num_cols};
+    multiply(a, b, product.view(), pool);
+    c = product.view();
+
+    return true;
+  }
+
+  c = Type{};
+
+  pool.parallel_for(0, b.num_cols, [&](size_type first, size_type last){
+    for (size_type k {0}; k < a.num_cols; ++k){
+      const auto* b_k {&b.at(k, 0)};
+      for (size_type p {a.col_start()[k]}; p < a.col_start()[k + 1]; ++p){
+        const Type a_ik {a.values()[p]};
+        Type* c_i {&c.at(a.row_index()[p], 0)};
+        for (size_type j {first}; j < last; ++j){
+          c_i[j] += a_ik * b_k[j];
+        }
+      }
+    }
+  }, 16);
+
+  return true;
+}
+// products with whole dense matrices
+template<typename Type, typename StorageB, typename StorageC>
+bool multiply(const CsrMatrix<Type>& a, const Matrix<Type, StorageB>& b, Matrix<Type, StorageC>& c,
+              ThreadPool& pool = ThreadPool::shared()){
+  return multiply(a, b.view(), c.view(), pool);
+}
+template<typename Type, typename StorageB, typename StorageC>
+bool multiply(const CscMatrix<Type>& a, const Matrix<Type, StorageB>& b, Matrix<Type, StorageC>& c,
+              ThreadPool& pool = ThreadPool::shared()){
+  return multiply(a, b.view(), c.view(), pool);
+}
+
+#endif
@@ -0,0 +1,225 @@
+// another way to achieve what #pragma once does
+#ifndef static_matrix_hpp
+#define static_matrix_hpp
+// elements are stored in an array, whose size is known at compile time
+#include <array>
+// conversion from a matrix may fail when dimensions disagree
+#include <optional>
+// index sequences are used to unroll every loop
+#include <utility>
+// static matrices interoperate with Matrix, SquareMatrix and views
+#include <matrix.hpp>
+// class to represent a matrix with Rows rows and Cols columns. As
+// dimensions are known at compile time, elements are kept in the
+// object itself (no heap allocation), every operation can be
+// evaluated at compile time, and kernels below are fully unrolled
+template<typename Type, std::size_t Rows, std::size_t Cols>
+class StaticMatrix{
+public:
+  // types of elements and indices
+  using value_type = Type;
+  using size_type  = std::size_t;
+  using reference  = Type&;
+private:
+  // elements stored linewise
+  using Data = std::array<Type, Rows * Cols>;
+  Data data_;
+  // converts rectangular to linear index
+  static constexpr size_type index(size_type i, size_type j){
+    return Cols * i + j;
+  }
+  // builds a matrix whose element at linear position k is e[k]
+  template<size_type... k, typename Function>
+  static constexpr StaticMatrix generate_(std::index_sequence<k...>, Function e){
+    return StaticMatrix{e(k)...};
+  }
+public:
+  // number of rows and number of columns
+  static constexpr size_type num_rows {Rows};
+  static constexpr size_type num_cols {Cols};
+  // builds a matrix with value-initialized (e.g., zero) elements
+  constexpr StaticMatrix() : data_{}
+  {}
+  // builds a matrix from its elements, given linewise
+  template<typename... Elements,
+           typename = std::enable_if_t<sizeof...(Elements) == Rows * Cols
+                                       && (std::is_convertible_v<Elements, Type> && ...)>>
+  constexpr StaticMatrix(Elements... elements) : data_{static_cast<Type>(elements)...}
+  {}
+  // builds a matrix whose element (i, j) is e(i, j)
+  template<typename Function>
+  static constexpr StaticMatrix generate(Function e){
+    return generate_(std::make_index_sequence<Rows * Cols>{},
+                     [&e](size_type k) constexpr { return static_cast<Type>(e(k / Cols, k % Cols)); });
+  }
+  // builds an identity matrix
+  static constexpr StaticMatrix identity(){
+    return generate([](size_type i, size_type j) constexpr { return i == j ? Type{1} : Type{}; });
+  }
+  // builds a matrix from any matrix (or view) of the same
+  // dimensions. Returns nothing if dimensions disagree
+  template<typename MatrixType>
+  static std::optional<StaticMatrix> from(const MatrixType& m){
+    if (m.num_rows != Rows || m.num_cols != Cols){
+      return {};
+    }
+
+    return generate([&m](size_type i, size_type j){ return m.const_at(i, j); });
+  }
+  // provides access to element at position (i, j)
+  constexpr reference at(size_type i, size_type j){
+    return data_[index(i, j)];
+  }
+  // returns a copy of element at position (i, j)
+  constexpr Type const_at(size_type i, size_type j) const{
+    return data_[index(i, j)];
+  }
+  // pointer to the first element; rows are num_cols elements apart
+  constexpr Type* data(){
+    return data_.data();
+  }
+  constexpr const Type* data() const{
+    return data_.data();
+  }
+  // view of the whole matrix, which can be used wherever a view of a
+  // Matrix is (in products, transposes, expressions and so on)
+  MatrixView<Type> view(){
+    return {data(), 0, Rows, Cols, Cols};
+  }
+  MatrixView<const Type> view() const{
+    return {data(), 0, Rows, Cols, Cols};
+  }
+  // converts to a heap allocated square matrix. As static matrices
+  // are expression operands, a Matrix can be built from them directly
+  template<typename Storage, bool square = Rows == Cols, typename = std::enable_if_t<square>>
+  explicit operator SquareMatrix<Type, Storage>() const{
+    SquareMatrix<Type, Storage> m {Rows};
+    m = view();
+
+    return m;
+  }
+  // returns the transpose of this matrix
+  constexpr StaticMatrix<Type, Cols, Rows> transposed() const{
+    return StaticMatrix<Type, Cols, Rows>::generate([this](size_type i, size_type j) constexpr { return const_at(j, i); });
+  }
+  // transforms a square matrix into its transpose
+  template<bool square = Rows == Cols, typename = std::enable_if_t<square>>
+  constexpr void transpose(){
+    *this = transposed();
+  }
+  // position-wise comparison
+  constexpr bool operator==(const StaticMatrix& m) const{
+    for (size_type k {0}; k < Rows * Cols; ++k){
+      if (!(data_[k] == m.data_[k])){
+        return false;
+      }
+    }
+
+    return true;
+  }
+  constexpr bool operator!=(const StaticMatrix& m) const{
+    return !(*this == m);
+  }
+  // a static matrix is an operand of expressions
+  friend matrix_detail::ViewOperand<MatrixView<const Type>> make_operand(const StaticMatrix& m){
+    return {m.view()};
+  }
+};
+// unrolled kernels of static matrices
+namespace static_matrix_detail{
+  using size_type = std::size_t;
+  // dot product of row i of a and column j of b, as a single
+  // expression whose terms are known at compile time
+  template<size_type i, size_type j, size_type... k, typename Type, size_type Rows, size_type Inner, size_type Cols>
+  constexpr Type dot(std::index_sequence<k...>, const StaticMatrix<Type, Rows, Inner>& a, const StaticMatrix<Type, Inner, Cols>& b){
+    return (Type{} + ... + (a.const_at(i, k) * b.const_at(k, j)));
+  }
+  // every position of a * b, each one computed by its own unrolled dot
+  // product
+  template<size_type... position, typename Type, size_type Rows, size_type Inner, size_type Cols>
+  constexpr StaticMatrix<Type, Rows, Cols> product(std::index_sequence<position...>, const StaticMatrix<Type, Rows, Inner>& a, const StaticMatrix<Type, Inner, Cols>& b){
+    return {dot<position / Cols, position % Cols>(std::make_index_sequence<Inner>{}, a, b)...};
+  }
+  // matrix m without row 0 and column j
+  template<typename Type, size_type n>
+  constexpr StaticMatrix<Type, n - 1, n - 1> submatrix(const StaticMatrix<Type, n, n>& m, size_type j){
+    return StaticMatrix<Type, n - 1, n - 1>::generate([&m, j](size_type r, size_type c) constexpr {
+      return m.const_at(r + 1, c < j ? c : c + 1);
+    });
+  }
+  template<typename Type, size_type n>
+  constexpr Type determinant(const StaticMatrix<Type, n, n>& m);
+  // cofactor expansion along row 0; the recursion is unrolled, as each
+  // minor has a distinct type
+  template<size_type... j, typename Type, size_type n>
+  constexpr Type cofactor_expansion(std::index_sequence<j...>, const StaticMatrix<Type, n, n>& m){
+    return (Type{} + ... + ((j % 2 == 0 ? m.const_at(0, j) : -m.const_at(0, j)) * static_matrix_detail::determinant(submatrix(m, j))));
+  }
+  // fraction-free (Bareiss) elimination, exact for integer types,
+  // used for matrices too large for cofactor expansion
+  template<typename Type, size_type n>
+  constexpr Type bareiss(StaticMatrix<Type, n, n> m){
+    Type sign {1};
+    Type previous {1};
+
+    for (size_type k {0}; k + 1 < n; ++k){
+      // a zero pivot is replaced by some row below it
+      if (m.const_at(k, k) == Type{}){
+        size_type pivot {k + 1};
+        while (pivot < n && m.const_at(pivot, k) == Type{}){
+          ++pivot;
+        }
+        if (pivot == n){
+          return Type{};
+        }
+        for (size_type j {0}; j < n; ++j){
+          const Type t {m.const_at(k, j)};
+          m.at(k, j) = m.const_at(pivot, j);
+          m.at(pivot, j) = t;
+        }
+        sign = -sign;
+      }
+
+      for (size_type i {k + 1}; i < n; ++i){
+        for (size_type j {k + 1}; j < n; ++j){
+          m.at(i, j) = (m.const_at(i, j) * m.const_at(k, k) - m.const_at(i, k) * m.const_at(k, j)) / previous;
+        }
+      }
+      previous = m.const_at(k, k);
+    }
+
+    return sign * m.const_at(n - 1, n - 1);
+  }
+
+  template<typename Type, size_type n>
+  constexpr Type determinant(const StaticMatrix<Type, n, n>& m){
+    if constexpr (n == 0){
+      return Type{1};
+    }
+    else if constexpr (n == 1){
+      return m.const_at(0, 0);
+    }
+    else if constexpr (n == 2){
+      return m.const_at(0, 0) * m.const_at(1, 1) - m.const_at(0, 1) * m.const_at(1, 0);
+    }
+    else if constexpr (n <= 4){
+      return cofactor_expansion(std::make_index_sequence<n>{}, m);
+    }
+    else{
+      return bareiss(m);
+    }
+  }
+}
+// product of static matrices, whose dimensions are checked at compile
+// time
+template<typename Type, std::size_t Rows, std::size_t Inner, std::size_t Cols>
+constexpr StaticMatrix<Type, Rows, Cols> operator*(const StaticMatrix<Type, Rows, Inner>& a, const StaticMatrix<Type, Inner, Cols>& b){
+  return static_matrix_detail::product(std::make_index_sequence<Rows * Cols>{}, a, b);
+}
+// determinant of a square static matrix
+template<typename Type, std::size_t n>
+constexpr Type determinant(const StaticMatrix<Type, n, n>& m){
+  return static_matrix_detail::determinant(m);
+}
+
+#endif
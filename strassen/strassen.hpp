@@ -0,0 +1,213 @@
+// another way to achieve what #pragma once does
+#ifndef strassen_hpp
+#define strassen_hpp
+// the scratch arena is a vector
+#include <vector>
+// we multiply square matrices, using the blocked classical kernel
+// below the crossover size
+#include <matrix.hpp>
+// the seven products of the first level run in parallel
+#include <thread_pool.hpp>
+// Strassen-Winograd multiplication. A product of m x m matrices (m
+// even) is split into quadrants, and computed with 7 products of
+// quadrants, instead of 8, and 15 additions:
+//
+//   S1 = A21 + A22   T1 = B12 - B11   P1 = A11 * B11   P5 = S1 * T1
+//   S2 = S1 - A11    T2 = B22 - T1    P2 = A12 * B21   P6 = S2 * T2
+//   S3 = A11 - A21   T3 = B22 - B12   P3 = S4 * B22    P7 = S3 * T3
+//   S4 = A12 - S2    T4 = T2 - B21    P4 = A22 * T4
+//
+//   U2 = P1 + P6   U3 = U2 + P7   U4 = U2 + P5
+//   C11 = P1 + P2   C12 = U4 + P3   C21 = U3 - P4   C22 = U3 + P5
+//
+// Products are computed recursively down to the crossover size, where
+// the classical kernel is faster
+namespace strassen_detail{
+  using size_type = std::size_t;
+  // z = x + y and z = x - y, for h x h blocks with rows ldx, ldy and
+  // ldz elements apart
+  template<typename Type>
+  void add(size_type h, const Type* x, size_type ldx, const Type* y, size_type ldy, Type* z, size_type ldz){
+    for (size_type i {0}; i < h; ++i){
+      for (size_type j {0}; j < h; ++j){
+        z[i * ldz + j] = x[i * ldx + j] + y[i * ldy + j];
+      }
+    }
+  }
+  template<typename Type>
+  void subtract(size_type h, const Type* x, size_type ldx, const Type* y, size_type ldy, Type* z, size_type ldz){
+    for (size_type i {0}; i < h; ++i){
+      for (size_type j {0}; j < h; ++j){
+        z[i * ldz + j] = x[i * ldx + j] - y[i * ldy + j];
+      }
+    }
+  }
+  // number of elements of scratch needed to multiply m x m matrices,
+  // when the seven products are run in parallel (and so need separate
+  // scratch) or one after another
+  inline size_type scratch_size(size_type m, size_type crossover, bool parallel){
+    if (m <= crossover){
+      return 0;
+    }
+
+    const size_type h {m / 2};
+    // S1..S4, T1..T4 and P1..P7
+    const size_type own {15 * h * h};
+
+    return own + (parallel ? 7 : 1) * scratch_size(h, crossover, false);
+  }
+  // c = a * b, for m x m blocks. scratch holds scratch_size(m,
+  // crossover, pool != nullptr) elements. With a pool, the seven
+  // products are computed in parallel
+  template<typename Type>
+  void multiply(size_type m, const Type* a, size_type lda, const Type* b, size_type ldb, Type* c, size_type ldc,
+                size_type crossover, Type* scratch, ThreadPool* pool){
+    if (m <= crossover){
+      for (size_type i {0}; i < m; ++i){
+        std::fill(c + i * ldc, c + i * ldc + m, Type{});
+      }
+      matrix_detail::gemm(m, m, m, a, lda, b, ldb, c, ldc);
+
+      return;
+    }
+
+    const size_type h {m / 2};
+    const Type* a_11 {a};
+    const Type* a_12 {a + h};
+    const Type* a_21 {a + h * lda};
+    const Type* a_22 {a + h * lda + h};
+    const Type* b_11 {b};
+    const Type* b_12 {b + h};
+    const Type* b_21 {b + h * ldb};
+    const Type* b_22 {b + h * ldb + h};
+    // our blocks, h elements apart, and then scratch of products
+    Type* block[15];
+    for (size_type k {0}; k < 15; ++k){
+      block[k] = scratch + k * h * h;
+    }
+    Type* const rest {scratch + 15 * h * h};
+    Type* s_1 {block[0]};
+    Type* s_2 {block[1]};
+    Type* s_3 {block[2]};
+    Type* s_4 {block[3]};
+    Type* t_1 {block[4]};
+    Type* t_2 {block[5]};
+    Type* t_3 {block[6]};
+    Type* t_4 {block[7]};
+    Type* p   {block[8]};
+
+    add(h, a_21, lda, a_22, lda, s_1, h);
+    subtract(h, s_1, h, a_11, lda, s_2, h);
+    subtract(h, a_11, lda, a_21, lda, s_3, h);
+    subtract(h, a_12, lda, s_2, h, s_4, h);
+    subtract(h, b_12, ldb, b_11, ldb, t_1, h);
+    subtract(h, b_22, ldb, t_1, h, t_2, h);
+    subtract(h, b_22, ldb, b_12, ldb, t_3, h);
+    subtract(h, t_2, h, b_21, ldb, t_4, h);
+    // factors of each product
+    const Type* left[7]      {a_11, a_12, s_4, a_22, s_1, s_2, s_3};
+    const size_type ld_left[7]  {lda, lda, h, lda, h, h, h};
+    const Type* right[7]     {b_11, b_21, b_22, t_4, t_1, t_2, t_3};
+    const size_type ld_right[7] {ldb, ldb, ldb, h, h, h, h};
+
+    const size_type below {scratch_size(h, crossover, false)};
+    const auto product {[&](size_type k){
+      Type* own_scratch {pool != nullptr ? rest + k * below : rest};
+      multiply(h, left[k], ld_left[k], right[k], ld_right[k], p + k * h * h, h, crossover, own_scratch, nullptr);
+    }};
+
+    if (pool != nullptr){
+      pool->parallel_for(0, 7, [&product](size_type first, size_type last){
+        for (size_type k {first}; k < last; ++k){
+          product(k);
+        }
+      });
+    }
+    else{
+      for (size_type k {0}; k < 7; ++k){
+        product(k);
+      }
+    }
+
+    Type* p_1 {p};
+    Type* p_2 {p + h * h};
+    Type* p_3 {p + 2 * h * h};
+    Type* p_4 {p + 3 * h * h};
+    Type* p_5 {p + 4 * h * h};
+    Type* p_6 {p + 5 * h * h};
+    Type* p_7 {p + 6 * h * h};
+    // U2 = P1 + P6 goes to P6, U3 = U2 + P7 to P7 and U4 = U2 + P5 to
+    // P6
+    add(h, p_1, h, p_2, h, c, ldc);
+    add(h, p_1, h, p_6, h, p_6, h);
+    add(h, p_6, h, p_7, h, p_7, h);
+    add(h, p_6, h, p_5, h, p_6, h);
+    add(h, p_6, h, p_3, h, c + h, ldc);
+    subtract(h, p_7, h, p_4, h, c + h * ldc, ldc);
+    add(h, p_7, h, p_5, h, c + h * ldc + h, ldc);
+  }
+}
+// default crossover: products of matrices of at most this dimension
+// use the classical kernel. The best value depends on the machine,
+// and can be found with strassen_benchmark
+constexpr std::size_t strassen_crossover {2048};
+// computes c = a * b with Strassen-Winograd multiplication, for
+// floating point Type. Scratch is a single arena, sized up front, so
+// the recursion never allocates. Unless n halves evenly down to the
+// crossover, a and b are copied into the arena, padded with zeros.
+// Returns false (leaving c untouched) when dimensions do not agree.
+// a, b and c may be the same matrix
+template<typename Type, typename StorageA, typename StorageB, typename StorageC>
+bool strassen_multiply(const SquareMatrix<Type, StorageA>& a, const SquareMatrix<Type, StorageB>& b, SquareMatrix<Type, StorageC>& c,
+                       std::size_t crossover = strassen_crossover, ThreadPool& pool = ThreadPool::shared()){
+  static_assert(std::is_floating_point_v<Type>, "Strassen multiplication needs a floating point type");
+  using size_type = std::size_t;
+
+  const size_type n {a.num_rows};
+  if (b.num_rows != n || c.num_rows != n){
+    return false;
+  }
+  crossover = std::max<size_type>(crossover, 1);
+  if (n <= crossover){
+    return multiply(a, b, c);
+  }
+  // halves until blocks are no larger than crossover
+  size_type levels {0};
+  size_type base {n};
+  while (base > crossover){
+    base = (base + 1) / 2;
+    ++levels;
+  }
+  const size_type m {base << levels};
+  // products can go straight from a and b into c when no padding is
+  // needed and c is not a factor
+  const bool direct {m == n && static_cast<const void*>(&c) != &a && static_cast<const void*>(&c) != &b};
+  const size_type scratch {strassen_detail::scratch_size(m, crossover, true)};
+
+  if (direct){
+    std::vector<Type> arena (scratch);
+    strassen_detail::multiply(m, a.data(), a.stride(), b.data(), b.stride(), c.data(), c.stride(), crossover, arena.data(), &pool);
+
+    return true;
+  }
+  // otherwise, padded copies of a and b, padded product and scratch
+  // share the arena
+  std::vector<Type> arena (3 * m * m + scratch, Type{});
+  Type* a_padded {arena.data()};
+  Type* b_padded {a_padded + m * m};
+  Type* c_padded {b_padded + m * m};
+  for (size_type i {0}; i < n; ++i){
+    std::copy(a.data() + i * a.stride(), a.data() + i * a.stride() + n, a_padded + i * m);
+    std::copy(b.data() + i * b.stride(), b.data() + i * b.stride() + n, b_padded + i * m);
+  }
+
+  strassen_detail::multiply(m, a_padded, m, b_padded, m, c_padded, m, crossover, c_padded + m * m, &pool);
+
+  for (size_type i {0}; i < n; ++i){
+    std::copy(c_padded + i * m, c_padded + i * m + n, c.data() + i * c.stride());
+  }
+
+  return true;
+}
+
+#endif
@@ -0,0 +1,191 @@
+// another way to achieve what #pragma once does
+#ifndef strongly_connected_components_hpp
+#define strongly_connected_components_hpp
+// successors of components are sorted and deduplicated
+#include <algorithm>
+// vertices are stored as fixed width integers in condensations
+#include <cstdint>
+// topological sorts fail on digraphs with cycles
+#include <optional>
+// results are moved out of visitors
+#include <utility>
+// labels, sizes and orders are kept in vectors
+#include <vector>
+// components are described as connected components are
+#include <connected_components.hpp>
+// condensations are compressed digraphs
+#include <csr_graph.hpp>
+// everything here is built on iterative depth first searches, so
+// deep digraphs do not overflow the call stack
+#include <graph.hpp>
+// helpers of strongly connected components and topological sorts
+namespace scc_detail{
+  using size_type = std::size_t;
+  // marks vertices with no component yet
+  constexpr size_type unassigned {~size_type{0}};
+  // Tarjan's algorithm: vertices are numbered as they are found, and
+  // low[v] is the smallest number of a vertex, still without
+  // component, reachable from the subtree of v through a single back
+  // or cross edge. A vertex whose low is its own number is the first
+  // of its component to have been found, so when it is finished, its
+  // component is every vertex found since, which are on top of stack.
+  // Components are completed sinks first, that is, in reverse
+  // topological order
+  struct TarjanVisitor : DfsVisitor{
+    std::vector<size_type> number;
+    std::vector<size_type> low;
+    std::vector<size_type> parent;
+    // vertices found and still without component
+    std::vector<size_type> stack;
+    // component of each vertex, in order of completion, and size of
+    // each component
+    std::vector<size_type> component;
+    std::vector<size_type> size;
+    size_type count;
+
+    TarjanVisitor(size_type num_verts)
+      : number(num_verts), low(num_verts), parent(num_verts), stack{}, component(num_verts, unassigned), size{}, count{0}
+    {}
+
+    bool discover_vertex(size_type v){
+      number[v] = low[v] = count++;
+      stack.push_back(v);
+
+      return true;
+    }
+    bool tree_edge(size_type u, size_type v){
+      parent[v] = u;
+
+      return true;
+    }
+    bool back_edge(size_type u, size_type v){
+      low[u] = std::min(low[u], number[v]);
+
+      return true;
+    }
+    bool cross_edge(size_type u, size_type v){
+      if (component[v] == unassigned){
+        low[u] = std::min(low[u], number[v]);
+      }
+
+      return true;
+    }
+    bool finish_vertex(size_type v){
+      if (low[v] == number[v]){
+        const size_type c {size.size()};
+        size_type w {};
+        do{
+          w = stack.back();
+          stack.pop_back();
+          component[w] = c;
+        } while (w != v);
+        size.push_back(0);
+      }
+      // roots of searches are their own parents, and are always the
+      // first of their components
+      else{
+        low[parent[v]] = std::min(low[parent[v]], low[v]);
+      }
+
+      return true;
+    }
+  };
+  // records vertices in post-order, stopping at the first back edge,
+  // which closes a cycle
+  struct AcyclicVisitor : DfsVisitor{
+    std::vector<size_type> post_order;
+
+    bool back_edge(size_type, size_type){
+      return false;
+    }
+    bool finish_vertex(size_type v){
+      post_order.push_back(v);
+
+      return true;
+    }
+  };
+}
+// finds the strongly connected components of D, which may be any
+// digraph providing num_verts and next_neighbor (or neighbors).
+// Components are numbered in topological order: when there is an edge
+// from component a to a different component b, a < b
+template<typename DigraphType>
+Components strongly_connected_components(const DigraphType& D){
+  using namespace scc_detail;
+
+  const size_type n {D.num_verts};
+  TarjanVisitor tarjan {n};
+  depth_first_search(D, tarjan);
+  // Tarjan completes components in reverse topological order
+  const size_type count {tarjan.size.size()};
+  Components result {std::move(tarjan.component), std::move(tarjan.size)};
+  for (size_type v {0}; v < n; ++v){
+    result.label[v] = count - 1 - result.label[v];
+    ++result.size[result.label[v]];
+  }
+
+  return result;
+}
+// returns the vertices of D in an order where every edge goes from a
+// vertex to a later one, which is the reverse of a post-order. Returns
+// nothing if D has a cycle, which makes such an order impossible
+template<typename DigraphType>
+std::optional<std::vector<typename DigraphType::size_type>> topological_sort(const DigraphType& D){
+  scc_detail::AcyclicVisitor acyclic {};
+  acyclic.post_order.reserve(D.num_verts);
+
+  if (!depth_first_search(D, acyclic)){
+    return {};
+  }
+  std::reverse(acyclic.post_order.begin(), acyclic.post_order.end());
+
+  return std::move(acyclic.post_order);
+}
+// the condensation of D: a digraph with a vertex for each strongly
+// connected component of D, as found by strongly_connected_components,
+// and an edge from a to b whenever some edge of D goes from component
+// a to a different component b. It is acyclic, and its vertices are
+// already in topological order
+template<typename Index = std::uint32_t, typename DigraphType>
+CsrDigraph_<Index> condensation(const DigraphType& D, const Components& components){
+  using size_type = typename DigraphType::size_type;
+
+  const size_type n {D.num_verts};
+  const size_type count {components.count()};
+  // vertices of each component, contiguously
+  std::vector<size_type> first (count + 1, 0);
+  for (size_type c {0}; c < count; ++c){
+    first[c + 1] = first[c] + components.size[c];
+  }
+  std::vector<size_type> member (n);
+  std::vector<size_type> next {first.begin(), first.end() - 1};
+  for (size_type v {0}; v < n; ++v){
+    member[next[components.label[v]]++] = v;
+  }
+  // successors of each component, sorted and without duplicates
+  std::vector<size_type> start (count + 1, 0);
+  std::vector<Index> successor {};
+  for (size_type c {0}; c < count; ++c){
+    const size_type begin {successor.size()};
+    for (size_type k {first[c]}; k < first[c + 1]; ++k){
+      D.for_each_neighbor(member[k], [&](size_type w){
+        if (components.label[w] != c){
+          successor.push_back(static_cast<Index>(components.label[w]));
+        }
+      });
+    }
+    std::sort(successor.begin() + begin, successor.end());
+    successor.erase(std::unique(successor.begin() + begin, successor.end()), successor.end());
+    start[c + 1] = successor.size();
+  }
+
+  return CsrDigraph_<Index>::from_compressed(std::move(start), std::move(successor));
+}
+// finds the strongly connected components of D and builds its
+// condensation
+template<typename Index = std::uint32_t, typename DigraphType>
+CsrDigraph_<Index> condensation(const DigraphType& D){
+  return condensation<Index>(D, strongly_connected_components(D));
+}
+
+#endif
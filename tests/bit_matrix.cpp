@@ -0,0 +1,102 @@
+#include <cassert>
+
+#include <vector>
+
+#include <bit_matrix.hpp>
+
+void test_bit_matrix(){
+  BitMatrix m {3, 130};
+
+  assert(m.num_rows == 3 && m.num_cols == 130);
+  assert(m.words_per_row() == 3);
+  assert(m.count() == 0);
+
+  m.at(0, 0)   = true;
+  m.at(1, 64)  = true;
+  m.at(2, 129) = true;
+
+  assert(m.at(0, 0) && m.const_at(1, 64) && m.const_at(2, 129));
+  assert(!m.const_at(1, 63) && !m.const_at(2, 128));
+
+  m.at(1, 64) = m.at(1, 63);
+
+  assert(!m.const_at(1, 64));
+  // bits past the last column stay zero
+  m = true;
+
+  assert(m.count() == 3 * 130);
+
+  m = false;
+
+  assert(m.count() == 0);
+}
+
+void test_rows(){
+  BitMatrix m {4, 200};
+
+  for (std::size_t j {0}; j < 200; j += 3){
+    m.at(0, j) = true;
+  }
+  for (std::size_t j {0}; j < 200; j += 5){
+    m.at(1, j) = true;
+  }
+
+  assert(m.row(0).count() == 67);
+  assert(m.row(1).count() == 40);
+  assert(count_and(m.row(0), m.row(1)) == 14);
+  // whole-row operations
+  m.row(2).assign(m.row(0));
+  m.row(2) &= m.row(1);
+
+  assert(m.row(2).count() == 14);
+  assert(m.row(2).test(15) && !m.row(2).test(5));
+
+  m.row(2) |= m.row(1);
+
+  assert(m.row(2).count() == 40);
+
+  m.row(2) ^= m.row(1);
+
+  assert(!m.row(2).any());
+  // finding set bits, across words
+  m.row(3).set(70);
+  m.row(3).set(199);
+
+  assert(m.row(3).find_first() == 70);
+  assert(m.row(3).find_next(70) == 70);
+  assert(m.row(3).find_next(71) == 199);
+  assert(m.row(3).find_next(200) == 200);
+  assert(m.row(2).find_first() == 200);
+
+  std::vector<std::size_t> set {};
+  m.row(3).for_each_set([&set](std::size_t j){ set.push_back(j); });
+
+  assert((set == std::vector<std::size_t>{70, 199}));
+
+  m.row(3).set(70, false);
+
+  assert(m.row(3).find_first() == 199);
+
+  m.row(3).reset();
+
+  assert(!m.row(3).any());
+}
+
+void test_bit_square_matrix(){
+  BitSquareMatrix<> m {70};
+
+  m = true;
+
+  assert(m.num_rows == 70 && m.num_cols == 70);
+  assert(m.count() == 70 * 70);
+}
+
+int main(){
+  test_bit_matrix();
+
+  test_rows();
+
+  test_bit_square_matrix();
+
+  return 0;
+}
@@ -0,0 +1,123 @@
+#include <cassert>
+
+#include <queue>
+
+#include <vector>
+
+#include <breadth_first_search.hpp>
+#include <csr_graph.hpp>
+
+#include "random_graph.hpp"
+// distances from source, computed with a plain queue
+template<typename GraphType>
+std::vector<std::size_t> reference_distances(const GraphType& g, std::size_t source){
+  std::vector<std::size_t> distance (g.num_verts, BfsTree::unreached);
+  std::queue<std::size_t> pending {};
+
+  distance[source] = 0;
+  pending.push(source);
+  while (!pending.empty()){
+    const std::size_t u {pending.front()};
+    pending.pop();
+    g.for_each_neighbor(u, [&](std::size_t v){
+      if (distance[v] == BfsTree::unreached){
+        distance[v] = distance[u] + 1;
+        pending.push(v);
+      }
+    });
+  }
+
+  return distance;
+}
+// every direction finds the right distances, and parents which form
+// a tree of shortest paths
+template<typename GraphType>
+void check_search(const GraphType& g, std::size_t source, ThreadPool& pool){
+  const auto expected {reference_distances(g, source)};
+
+  for (const auto direction : {BfsDirection::optimizing, BfsDirection::top_down, BfsDirection::bottom_up}){
+    const BfsTree tree {breadth_first_search(g, source, direction, pool)};
+    assert(tree.distance == expected);
+    assert(tree.parent[source] == source);
+
+    for (std::size_t v {0}; v < g.num_verts; ++v){
+      assert(tree.reached(v) == (expected[v] != BfsTree::unreached));
+      if (tree.reached(v) && v != source){
+        const std::size_t u {tree.parent[v]};
+        assert(g.has_edge(u, v));
+        assert(tree.distance[u] + 1 == tree.distance[v]);
+      }
+      if (!tree.reached(v)){
+        assert(tree.parent[v] == BfsTree::unreached);
+      }
+    }
+  }
+}
+
+void test_small(ThreadPool& pool){
+  // 0 -> 1 -> 2 -> 3, with a shortcut 0 -> 2, and 4 unreachable
+  Digraph d {5};
+  d.add_edge(0, 1);
+  d.add_edge(1, 2);
+  d.add_edge(2, 3);
+  d.add_edge(0, 2);
+  d.add_edge(4, 0);
+
+  const BfsTree tree {breadth_first_search(d, 0, BfsDirection::optimizing, pool)};
+  assert((tree.distance == std::vector<std::size_t>{0, 1, 1, 2, BfsTree::unreached}));
+  assert((tree.parent == std::vector<std::size_t>{0, 0, 0, 2, BfsTree::unreached}));
+  // a single vertex
+  Graph single {1};
+  const BfsTree alone {breadth_first_search(single, 0, BfsDirection::bottom_up, pool)};
+  assert((alone.distance == std::vector<std::size_t>{0}));
+  assert((alone.parent == std::vector<std::size_t>{0}));
+
+  check_search(d, 4, pool);
+}
+// random graphs with num_verts vertices, each edge present with a
+// probability of density, searched from a few sources on every
+// backend
+void test_random(std::size_t num_verts, double density, ThreadPool& pool){
+  Digraph d {num_verts};
+  Digraph_<SquareMatrix> dense_d {num_verts};
+  Graph g {num_verts};
+  Graph_<UpperTriangularMatrix> triangular_g {num_verts};
+  add_random_edges(num_verts, density, false, d, dense_d, g, triangular_g);
+  const auto csr_d {CsrDigraph::from(d)};
+  const auto csr_g {CsrGraph::from(g)};
+
+  for (std::size_t source {0}; source < num_verts; source += num_verts / 3 + 1){
+    check_search(d, source, pool);
+    check_search(dense_d, source, pool);
+    check_search(csr_d, source, pool);
+    check_search(g, source, pool);
+    check_search(triangular_g, source, pool);
+    check_search(csr_g, source, pool);
+  }
+  // a searcher keeps in-neighbors from one search to the next
+  BreadthFirstSearch<Digraph> search_d {d, pool};
+  BreadthFirstSearch<CsrDigraph> search_csr_d {csr_d, pool};
+  for (std::size_t source {0}; source < num_verts; source += num_verts / 5 + 1){
+    const auto expected {reference_distances(d, source)};
+    assert(search_d.search(source, BfsDirection::bottom_up).distance == expected);
+    assert(search_d.search(source).distance == expected);
+    assert(search_csr_d.search(source, BfsDirection::bottom_up).distance == expected);
+    assert(search_csr_d.search(source).distance == expected);
+  }
+}
+
+int main(){
+  // more threads than cores, so that steps do run concurrently
+  ThreadPool pool {4};
+
+  test_small(pool);
+
+  test_random(1, 0.5, pool);
+  test_random(63, 0.05, pool);
+  test_random(64, 0.02, pool);
+  test_random(200, 0.01, pool);
+  test_random(500, 0.003, pool);
+  test_random(500, 0.05, pool);
+
+  return 0;
+}
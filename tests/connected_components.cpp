@@ -0,0 +1,98 @@
+#include <cassert>
+
+#include <random>
+
+#include <vector>
+
+#include <connected_components.hpp>
+#include <csr_graph.hpp>
+
+#include "random_graph.hpp"
+// components found by depth first searches from each vertex not yet
+// labeled, numbered in the order of their smallest vertices
+template<typename GraphType>
+Components reference_components(const GraphType& g){
+  Components result {std::vector<std::size_t>(g.num_verts, g.num_verts), {}};
+
+  for (std::size_t start {0}; start < g.num_verts; ++start){
+    if (result.label[start] == g.num_verts){
+      const std::size_t label {result.size.size()};
+      result.size.push_back(0);
+      depth_first_search(g, start, [&result, label](std::size_t v){
+        result.label[v] = label;
+        ++result.size[label];
+      });
+    }
+  }
+
+  return result;
+}
+
+template<typename GraphType>
+void check_components(const GraphType& g, ThreadPool& pool){
+  const Components expected {reference_components(g)};
+  const Components found {connected_components(g, pool)};
+
+  assert(found.label == expected.label);
+  assert(found.size == expected.size);
+  assert(found.count() == expected.count());
+}
+
+void test_small(ThreadPool& pool){
+  Graph empty {0};
+  assert(connected_components(empty, pool).count() == 0);
+
+  Graph g {7};
+  g.add_edge(5, 6);
+  g.add_edge(1, 3);
+  g.add_edge(3, 6);
+  g.add_edge(0, 4);
+
+  const Components c {connected_components(g, pool)};
+  assert((c.label == std::vector<std::size_t>{0, 1, 2, 1, 0, 1, 1}));
+  assert((c.size == std::vector<std::size_t>{2, 4, 1}));
+  assert(c.count() == 3);
+}
+// random graphs with num_verts vertices split into num_parts groups,
+// with edges (present with a probability of density) only inside
+// groups, on every backend
+void test_random(std::size_t num_verts, std::size_t num_parts, double density, ThreadPool& pool){
+  std::mt19937 generator {static_cast<unsigned>(num_verts + num_parts)};
+  std::uniform_int_distribution<std::size_t> part {0, num_parts - 1};
+
+  std::vector<std::size_t> group (num_verts);
+  for (auto& p : group){
+    p = part(generator);
+  }
+
+  Graph g {num_verts};
+  Graph_<SquareMatrix> dense_g {num_verts};
+  Graph_<UpperTriangularMatrix> triangular_g {num_verts};
+  for_each_random_pair(num_verts, density, static_cast<unsigned>(num_verts), [&](std::size_t u, std::size_t v){
+    if (u < v && group[u] == group[v]){
+      g.add_edge(u, v);
+      dense_g.add_edge(u, v);
+      triangular_g.add_edge(u, v);
+    }
+  });
+
+  check_components(g, pool);
+  check_components(dense_g, pool);
+  check_components(triangular_g, pool);
+  check_components(CsrGraph::from(g), pool);
+}
+
+int main(){
+  // more threads than cores, so that links do run concurrently
+  ThreadPool pool {4};
+
+  test_small(pool);
+
+  test_random(1, 1, 0.5, pool);
+  test_random(100, 1, 0.05, pool);
+  test_random(300, 5, 0.02, pool);
+  test_random(500, 40, 0.01, pool);
+  test_random(2000, 3, 0.002, pool);
+
+  return 0;
+}
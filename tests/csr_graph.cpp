@@ -0,0 +1,95 @@
+#include <cassert>
+
+#include <vector>
+
+#include <csr_graph.hpp>
+
+template<typename Source, typename Compressed>
+void check_same(const Source& s, const Compressed& c){
+  assert(c.num_verts == s.num_verts);
+  assert(c.num_edges == s.num_edges);
+
+  for (std::size_t u {0}; u < s.num_verts; ++u){
+    std::vector<std::size_t> expected {};
+    s.for_each_neighbor(u, [&expected](std::size_t v){ expected.push_back(v); });
+
+    const auto neighbors {c.neighbors(u)};
+    assert(neighbors.size() == expected.size());
+    for (std::size_t k {0}; k < expected.size(); ++k){
+      assert(neighbors[k] == expected[k]);
+    }
+
+    for (std::size_t v {0}; v < s.num_verts; ++v){
+      assert(c.has_edge(u, v) == s.has_edge(u, v));
+      assert(c.next_neighbor(u, v) == s.next_neighbor(u, v));
+    }
+  }
+}
+// depth first search visits vertices in the same order on any backend
+template<typename Left, typename Right>
+void check_same_search(const Left& l, const Right& r){
+  for (std::size_t start {0}; start < l.num_verts; ++start){
+    std::vector<std::size_t> left_order {};
+    std::vector<std::size_t> right_order {};
+    depth_first_search(l, start, [&left_order](std::size_t v){ left_order.push_back(v); });
+    depth_first_search(r, start, [&right_order](std::size_t v){ right_order.push_back(v); });
+    assert(left_order == right_order);
+  }
+}
+
+void test_digraph(){
+  Digraph d {9};
+  d.add_edge(0, 1);
+  d.add_edge(0, 5);
+  d.add_edge(1, 2);
+  d.add_edge(2, 0);
+  d.add_edge(5, 5);
+  d.add_edge(6, 8);
+  d.add_edge(8, 7);
+
+  const CsrDigraph c {CsrDigraph::from(d)};
+  check_same(d, c);
+  check_same_search(d, c);
+
+  assert(c.out_degree(0) == 2);
+  assert(c.out_degree(3) == 0);
+  assert(c.neighbors(3).empty());
+  assert(c.offsets().size() == 10);
+  assert(c.targets().size() == 7);
+  // matrices of other types are converted too
+  Digraph_<SquareMatrix> s {4};
+  s.add_edge(3, 1);
+  const auto wide {CsrDigraph_<std::size_t>::from(s)};
+  check_same(s, wide);
+  // copies keep their own counts
+  CsrDigraph copy {c};
+  assert(copy.num_edges == 7);
+}
+
+void test_graph(){
+  Graph g {8};
+  g.add_edge(0, 3);
+  g.add_edge(3, 4);
+  g.add_edge(4, 1);
+  g.add_edge(1, 0);
+  g.add_edge(6, 7);
+  g.add_edge(2, 2);
+
+  const CsrGraph c {CsrGraph::from(g)};
+  check_same(g, c);
+  check_same_search(g, c);
+  assert(c.degree(3) == 2);
+  assert(c.degree(5) == 0);
+
+  Graph_<UpperTriangularMatrix> t {8};
+  t.add_edge(5, 1);
+  t.add_edge(1, 7);
+  const CsrGraph from_triangle {CsrGraph::from(t)};
+  check_same(t, from_triangle);
+  check_same_search(t, from_triangle);
+}
+
+int main(){
+  test_digraph();
+  test_graph();
+}
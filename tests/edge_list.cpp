@@ -0,0 +1,146 @@
+#include <cassert>
+
+#include <algorithm>
+
+#include <cstdio>
+
+#include <fstream>
+
+#include <random>
+
+#include <sstream>
+
+#include <vector>
+
+#include <edge_list.hpp>
+// both graphs have the same edges
+template<typename Built, typename Expected>
+void check_same(const Built& built, const Expected& expected){
+  assert(built.num_verts == expected.num_verts);
+  assert(built.num_edges == expected.num_edges);
+
+  for (std::size_t u {0}; u < expected.num_verts; ++u){
+    for (std::size_t v {0}; v < expected.num_verts; ++v){
+      assert(built.has_edge(u, v) == expected.has_edge(u, v));
+    }
+  }
+}
+// builds GraphType from edges, and compares it with a graph built by
+// adding them one by one
+template<typename GraphType, typename Reference = GraphType>
+void check_build(std::size_t num_verts, const std::vector<Edge>& edges, ThreadPool& pool){
+  Reference expected {num_verts};
+  for (const auto& [u, v] : edges){
+    expected.add_edge(u, v);
+  }
+
+  const auto built {build_graph<GraphType>(num_verts, edges, pool)};
+  assert(built);
+  check_same(*built, expected);
+}
+// num_edges random edges, among num_verts vertices, with repetitions
+// and both directions of some of them
+std::vector<Edge> random_edges(std::size_t num_verts, std::size_t num_edges){
+  std::mt19937 generator {static_cast<unsigned>(num_verts + num_edges)};
+  std::uniform_int_distribution<std::size_t> vertex {0, num_verts - 1};
+
+  std::vector<Edge> edges {};
+  while (edges.size() < num_edges){
+    const Edge e {vertex(generator), vertex(generator)};
+    edges.push_back(e);
+    if (vertex(generator) % 4 == 0){
+      edges.push_back(e);
+      edges.push_back({e.second, e.first});
+    }
+  }
+
+  return edges;
+}
+
+void test_build(std::size_t num_verts, std::size_t num_edges, ThreadPool& pool){
+  const auto edges {random_edges(num_verts, num_edges)};
+
+  check_build<Digraph>(num_verts, edges, pool);
+  check_build<Graph>(num_verts, edges, pool);
+  check_build<Digraph_<SquareMatrix>>(num_verts, edges, pool);
+  check_build<Graph_<SquareMatrix>>(num_verts, edges, pool);
+  check_build<Graph_<UpperTriangularMatrix>>(num_verts, edges, pool);
+  check_build<CsrDigraph, Digraph>(num_verts, edges, pool);
+  check_build<CsrGraph, Graph>(num_verts, edges, pool);
+  // compressed graphs keep neighbors sorted
+  const auto csr {build_graph<CsrGraph>(num_verts, edges, pool)};
+  for (std::size_t u {0}; u < num_verts; ++u){
+    const auto neighbors {csr->neighbors(u)};
+    assert(std::is_sorted(neighbors.begin(), neighbors.end()));
+    assert(neighbors.size() == csr->degree(u));
+  }
+}
+
+void test_invalid(ThreadPool& pool){
+  assert(!build_graph<Digraph>(3, {{0, 1}, {1, 3}}, pool));
+  assert(!build_graph<CsrGraph>(3, {{3, 0}}, pool));
+
+  const auto empty {build_graph<Graph>(0, {}, pool)};
+  assert(empty && empty->num_verts == 0 && empty->num_edges == 0);
+}
+
+void test_stream(ThreadPool& pool){
+  std::istringstream text {"0 1\n1 2  2 0\n\n0 1\n"};
+  const auto d {build_graph<Digraph>(3, text, pool)};
+  assert(d && d->num_edges == 3);
+  assert(d->has_edge(0, 1) && d->has_edge(1, 2) && d->has_edge(2, 0));
+
+  std::istringstream odd {"0 1 2"};
+  assert(!read_edge_list(odd));
+  std::istringstream junk {"0 1 x 2"};
+  assert(!read_edge_list(junk));
+  std::istringstream out_of_range {"0 5"};
+  assert(!build_graph<Graph>(3, out_of_range, pool));
+}
+
+void test_file(ThreadPool& pool){
+  const std::string path {"edge_list_test.bin"};
+  const auto edges {random_edges(100, 500)};
+
+  assert(save_edge_list(edges, path));
+  const auto loaded {load_edge_list(path)};
+  assert(loaded && *loaded == edges);
+
+  const auto g {load_graph<Graph>(100, path, pool)};
+  assert(g);
+  check_same(*g, *build_graph<Graph>(100, edges, pool));
+  // 64 bit vertices, and a file whose size is not a whole number of
+  // pairs
+  assert(save_edge_list<std::uint64_t>(edges, path));
+  assert((load_graph<CsrDigraph, std::uint64_t>(100, path, pool)));
+  assert(!load_edge_list<std::uint64_t>("edge_list_test_missing.bin"));
+  assert(!load_edge_list<std::uint64_t>(path + "x"));
+  assert((!load_graph<Digraph, std::uint32_t>(100, path + "x", pool)));
+  {
+    std::ofstream truncated {path, std::ios::binary | std::ios::trunc};
+    truncated.write("abc", 3);
+  }
+  assert(!load_edge_list(path));
+
+  std::remove(path.c_str());
+}
+
+int main(){
+  // more threads than cores, so that edges are sorted and graphs
+  // filled concurrently
+  ThreadPool pool {4};
+
+  test_invalid(pool);
+  test_stream(pool);
+  test_file(pool);
+
+  test_build(1, 3, pool);
+  test_build(70, 200, pool);
+  test_build(300, 5000, pool);
+  // labels of more bits than a digit, so edges take several passes
+  test_build(2100, 10000, pool);
+  // enough edges to be sorted in several chunks, and merged
+  test_build(1000, 400000, pool);
+
+  return 0;
+}
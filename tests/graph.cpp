@@ -1,5 +1,9 @@
 #include <cassert>
 
+#include <utility>
+
+#include <vector>
+
 #include <graph.hpp>
 
 void test_digraph(){
@@ -67,10 +71,161 @@ void test_graph(){
   assert(G.num_edges == 1);
 }
 
+// every representation answers the same queries
+template<typename GraphType>
+void test_neighbors(bool directed){
+  GraphType G {130};
+
+  G.add_edge(5, 0);
+  G.add_edge(5, 64);
+  G.add_edge(5, 129);
+  G.add_edge(7, 5);
+
+  assert(G.num_edges == 4);
+  assert(G.next_neighbor(5, 0) == 0);
+  assert(G.next_neighbor(5, 1) == (directed ? 64 : 7));
+  assert(G.next_neighbor(5, 65) == 129);
+  assert(G.next_neighbor(6, 0) == 130);
+
+  std::vector<std::size_t> neighbors {};
+  G.for_each_neighbor(5, [&neighbors](std::size_t v){ neighbors.push_back(v); });
+
+  if (directed){
+    assert((neighbors == std::vector<std::size_t>{0, 64, 129}));
+  }
+  else{
+    assert((neighbors == std::vector<std::size_t>{0, 7, 64, 129}));
+  }
+
+  G.remove_edge(5, 64);
+
+  assert(G.num_edges == 3);
+  assert(G.next_neighbor(5, 8) == 129);
+}
+
+// records everything a depth first search reports
+struct Recorder : DfsVisitor{
+  std::vector<size_type> roots {};
+  std::vector<size_type> pre_order {};
+  std::vector<size_type> post_order {};
+  std::vector<std::pair<size_type, size_type>> tree {};
+  std::vector<std::pair<size_type, size_type>> back {};
+  std::vector<std::pair<size_type, size_type>> forward {};
+  std::vector<std::pair<size_type, size_type>> cross {};
+  // vertex whose discovery stops the search
+  size_type stop_at {std::size_t(-1)};
+
+  bool start_vertex(size_type v){
+    roots.push_back(v);
+
+    return true;
+  }
+  bool discover_vertex(size_type v){
+    pre_order.push_back(v);
+
+    return v != stop_at;
+  }
+  bool finish_vertex(size_type v){
+    post_order.push_back(v);
+
+    return true;
+  }
+  bool tree_edge(size_type u, size_type v){
+    tree.push_back({u, v});
+
+    return true;
+  }
+  bool back_edge(size_type u, size_type v){
+    back.push_back({u, v});
+
+    return true;
+  }
+  bool forward_edge(size_type u, size_type v){
+    forward.push_back({u, v});
+
+    return true;
+  }
+  bool cross_edge(size_type u, size_type v){
+    cross.push_back({u, v});
+
+    return true;
+  }
+};
+
+void test_depth_first_search(){
+  using Edges = std::vector<std::pair<std::size_t, std::size_t>>;
+
+  Digraph D {5};
+  D.add_edge(0, 1);
+  D.add_edge(1, 2);
+  D.add_edge(2, 0);
+  D.add_edge(0, 2);
+  D.add_edge(1, 3);
+  D.add_edge(3, 2);
+  D.add_edge(4, 3);
+
+  Recorder r {};
+  assert(depth_first_search(D, 0, r));
+  assert((r.pre_order  == std::vector<std::size_t>{0, 1, 2, 3}));
+  assert((r.post_order == std::vector<std::size_t>{2, 3, 1, 0}));
+  assert((r.tree    == Edges{{0, 1}, {1, 2}, {1, 3}}));
+  assert((r.back    == Edges{{2, 0}}));
+  assert((r.forward == Edges{{0, 2}}));
+  assert((r.cross   == Edges{{3, 2}}));
+  // functions are called in post-order
+  std::vector<std::size_t> finished {};
+  assert(depth_first_search(D, 1, [&finished](std::size_t v){ finished.push_back(v); }));
+  assert((finished == std::vector<std::size_t>{0, 2, 3, 1}));
+  // hooks stop the search
+  Recorder stopped {};
+  stopped.stop_at = 2;
+  assert(!depth_first_search(D, 0, stopped));
+  assert((stopped.pre_order == std::vector<std::size_t>{0, 1, 2}));
+  assert(stopped.post_order.empty());
+  // searches from every vertex: 4 is left for a second tree, whose
+  // edge to the first one is a cross edge
+  Recorder forest {};
+  assert(depth_first_search(D, forest));
+  assert((forest.roots      == std::vector<std::size_t>{0, 4}));
+  assert((forest.pre_order  == std::vector<std::size_t>{0, 1, 2, 3, 4}));
+  assert((forest.post_order == std::vector<std::size_t>{2, 3, 1, 0, 4}));
+  assert((forest.cross      == Edges{{3, 2}, {4, 3}}));
+  finished.clear();
+  assert(depth_first_search(D, [&finished](std::size_t v){ finished.push_back(v); }));
+  assert((finished == std::vector<std::size_t>{2, 3, 1, 0, 4}));
+  // a complete digraph: each row is scanned once
+  const std::size_t n {3000};
+  Digraph complete {n};
+  for (std::size_t u {0}; u < n; ++u){
+    for (std::size_t v {0}; v < n; ++v){
+      complete.add_edge(u, v);
+    }
+  }
+  std::size_t count {0};
+  depth_first_search(complete, 0, [&count](std::size_t){ ++count; });
+  assert(count == n);
+}
+
 int main(){
   test_digraph();
 
   test_graph();
 
+  test_neighbors<Digraph>(true);
+  test_neighbors<Digraph_<SquareMatrix>>(true);
+  test_neighbors<Graph>(false);
+  test_neighbors<Graph_<UpperTriangularMatrix>>(false);
+
+  Graph G {10};
+  G.add_edge(3, 1);
+  G.add_edge(3, 3);
+  G.add_edge(2, 3);
+
+  assert(G.degree(3) == 3);
+  assert(G.num_edges == 3);
+  assert(G.has_edge(1, 3));
+
+  test_depth_first_search();
+
   return 0;
 }
@@ -0,0 +1,234 @@
+#include <cassert>
+
+#include <cstdint>
+
+#include <cstdio>
+
+#include <fstream>
+
+#include <vector>
+
+#include <graph_file.hpp>
+
+#include "random_graph.hpp"
+// random graph of GraphType with num_verts vertices, loops included.
+// Weights tell edges apart
+template<typename GraphType>
+GraphType random_graph(std::size_t num_verts, double density){
+  GraphType g {num_verts};
+  if constexpr (std::is_same_v<GraphType, WeightedGraph<double>>){
+    for_each_random_pair(num_verts, density, static_cast<unsigned>(num_verts), [&](std::size_t u, std::size_t v){
+      g.add_edge(u, v, 0.5 + static_cast<double>(u * num_verts + v));
+    });
+  }
+  else{
+    add_random_edges(num_verts, density, true, g);
+  }
+
+  return g;
+}
+// both graphs have the same edges
+template<typename Loaded, typename Expected>
+void check_same(const Loaded& loaded, const Expected& expected){
+  assert(loaded.num_verts == expected.num_verts);
+  assert(loaded.num_edges == expected.num_edges);
+
+  for (std::size_t u {0}; u < expected.num_verts; ++u){
+    for (std::size_t v {0}; v < expected.num_verts; ++v){
+      assert(loaded.has_edge(u, v) == expected.has_edge(u, v));
+    }
+  }
+}
+// g is saved, loaded and mapped back
+template<typename GraphType>
+void check_round_trip(const GraphType& g){
+  const std::string path {"graph_file_test_round_trip.bin"};
+  assert(save_snapshot(g, path));
+
+  const auto loaded {load_snapshot<GraphType>(path)};
+  assert(loaded);
+  check_same(*loaded, g);
+
+  const auto mapped {MappedGraph<GraphType>::open(path)};
+  assert(mapped);
+  check_same(*mapped, g);
+  for (std::size_t u {0}; u < g.num_verts; ++u){
+    std::size_t degree {0};
+    for (std::size_t v {0}; v < g.num_verts; ++v){
+      degree += g.has_edge(u, v);
+    }
+    assert(mapped->out_degree(u) == degree);
+  }
+
+  std::remove(path.c_str());
+}
+
+void test_round_trips(){
+  for (const std::size_t n : {0, 1, 63, 64, 65, 150}){
+    check_round_trip(random_graph<Digraph>(n, 0.1));
+    check_round_trip(random_graph<Graph>(n, 0.1));
+    check_round_trip(random_graph<Digraph_<SquareMatrix>>(n, 0.2));
+    check_round_trip(random_graph<Graph_<SquareMatrix>>(n, 0.2));
+    check_round_trip(random_graph<Graph_<UpperTriangularMatrix>>(n, 0.2));
+  }
+  // representations may differ between the saved and loaded graphs
+  const std::string path {"graph_file_test_representations.bin"};
+  const auto g {random_graph<Graph_<UpperTriangularMatrix>>(100, 0.1)};
+  assert(save_snapshot(g, path));
+  const auto loaded {load_snapshot<Graph>(path)};
+  assert(loaded);
+  check_same(*loaded, g);
+
+  std::remove(path.c_str());
+}
+
+void test_weighted(){
+  const std::string path {"graph_file_test_weighted.bin"};
+
+  for (const std::size_t n : {0, 1, 70}){
+    const auto g {random_graph<WeightedGraph<double>>(n, 0.2)};
+    assert(save_snapshot(g, path));
+
+    const auto loaded {load_snapshot<WeightedGraph<double>>(path)};
+    assert(loaded);
+    const auto mapped {MappedGraph<WeightedGraph<double>>::open(path)};
+    assert(mapped);
+    check_same(*loaded, g);
+    check_same(*mapped, g);
+    for (std::size_t u {0}; u < n; ++u){
+      for (std::size_t v {0}; v < n; ++v){
+        assert(loaded->edge_weight(u, v) == g.edge_weight(u, v));
+        assert(mapped->edge_weight(u, v) == g.edge_weight(u, v));
+      }
+    }
+  }
+  // weights must agree, and weighted files are not unweighted graphs
+  assert(!load_snapshot<WeightedGraph<float>>(path));
+  assert(!load_snapshot<WeightedGraph<int>>(path));
+  assert(!load_snapshot<Graph>(path));
+  assert(!MappedGraph<Graph>::open(path));
+
+  std::remove(path.c_str());
+}
+
+void test_invalid(){
+  const std::string path {"graph_file_test_invalid.bin"};
+
+  const auto d {random_graph<Digraph>(100, 0.1)};
+  assert(save_snapshot(d, path));
+  // digraphs are not graphs
+  assert(!load_snapshot<Graph>(path));
+  assert(!MappedGraph<Graph>::open(path));
+  assert(!load_snapshot<Digraph>("no_such_file.bin"));
+  assert(!MappedGraph<Digraph>::open("no_such_file.bin"));
+  // a number of edges not matching the rows
+  GraphFileHeader header {};
+  {
+    std::fstream file {path, std::ios::binary | std::ios::in | std::ios::out};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    ++header.num_edges;
+    file.seekp(0).write(reinterpret_cast<const char*>(&header), sizeof(header));
+  }
+  assert(!load_snapshot<Digraph>(path));
+  // a truncated file
+  {
+    std::ofstream file {path, std::ios::binary | std::ios::trunc};
+    --header.num_edges;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  }
+  assert(!load_snapshot<Digraph>(path));
+  assert(!MappedGraph<Digraph>::open(path));
+
+  std::remove(path.c_str());
+}
+// corrupt sections behind a valid header are mapped, but weights are
+// never read outside the file
+void test_corrupt(){
+  const std::string path {"graph_file_test_corrupt.bin"};
+
+  WeightedGraph<double> g {3};
+  g.add_edge(0, 1, 2.5);
+  g.add_edge(1, 2, 5.0);
+  assert(save_snapshot(g, path));
+
+  GraphFileHeader header {};
+  {
+    std::fstream file {path, std::ios::binary | std::ios::in | std::ios::out};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    // edge (2, 0) without edge (0, 2)
+    const std::uint64_t row_2 {std::uint64_t{1} << 1 | 1};
+    file.seekp(static_cast<std::streamoff>(header.adjacency_offset + 2 * header.words_per_row() * sizeof(row_2)));
+    file.write(reinterpret_cast<const char*>(&row_2), sizeof(row_2));
+    // row 1 ending past the end of the weights
+    const std::uint64_t start_2 {std::uint64_t{1} << 60};
+    file.seekp(static_cast<std::streamoff>(header.weights_offset + 2 * sizeof(start_2)));
+    file.write(reinterpret_cast<const char*>(&start_2), sizeof(start_2));
+  }
+  const auto mapped {MappedGraph<WeightedGraph<double>>::open(path)};
+  assert(mapped);
+  assert(mapped->has_edge(2, 0) && !mapped->has_edge(0, 2));
+  assert(mapped->edge_weight(2, 0) == 0.0);
+  assert(mapped->edge_weight(0, 1) == 2.5);
+  assert(mapped->edge_weight(1, 2) == 0.0);
+  // bits past the last vertex of rows are not neighbors
+  Graph d {10};
+  d.add_edge(0, 1);
+  d.add_edge(1, 9);
+  assert(save_snapshot(d, path));
+  {
+    std::fstream file {path, std::ios::binary | std::ios::in | std::ios::out};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    const std::uint64_t row_1 {std::uint64_t{1} << 63 | std::uint64_t{1} << 40 | std::uint64_t{1} << 9 | 1};
+    file.seekp(static_cast<std::streamoff>(header.adjacency_offset + header.words_per_row() * sizeof(row_1)));
+    file.write(reinterpret_cast<const char*>(&row_1), sizeof(row_1));
+  }
+  const auto padded {MappedGraph<Graph>::open(path)};
+  assert(padded);
+  std::vector<std::size_t> neighbors {};
+  padded->for_each_neighbor(1, [&neighbors](std::size_t v){ neighbors.push_back(v); });
+  assert((neighbors == std::vector<std::size_t>{0, 9}));
+  assert(padded->out_degree(1) == 2);
+  assert(padded->next_neighbor(1, 1) == 9 && padded->next_neighbor(1, 10) == 10);
+  std::vector<std::size_t> found {};
+  depth_first_search(*padded, [&found](std::size_t v){ found.push_back(v); });
+  assert(found.size() == 10);
+
+  std::remove(path.c_str());
+}
+// mapped graphs are traversed as graphs are
+void test_traversal(){
+  const std::string path {"graph_file_test_traversal.bin"};
+
+  Digraph d {6};
+  d.add_edge(0, 1);
+  d.add_edge(1, 2);
+  d.add_edge(2, 0);
+  d.add_edge(1, 3);
+  d.add_edge(4, 5);
+  assert(save_snapshot(d, path));
+
+  auto mapped {MappedGraph<Digraph>::open(path)};
+  assert(mapped);
+  std::vector<std::size_t> expected {};
+  std::vector<std::size_t> found {};
+  depth_first_search(d, [&expected](std::size_t v){ expected.push_back(v); });
+  depth_first_search(*mapped, [&found](std::size_t v){ found.push_back(v); });
+  assert(found == expected);
+  // mappings are moved
+  MappedGraph<Digraph> moved {std::move(*mapped)};
+  assert(moved.num_verts == 6 && moved.num_edges == 5);
+  assert(mapped->num_verts == 0);
+  assert(moved.next_neighbor(1, 0) == 2 && moved.next_neighbor(1, 3) == 3 && moved.next_neighbor(3, 0) == 6);
+
+  std::remove(path.c_str());
+}
+
+int main(){
+  test_round_trips();
+  test_weighted();
+  test_invalid();
+  test_corrupt();
+  test_traversal();
+
+  return 0;
+}
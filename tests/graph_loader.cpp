@@ -0,0 +1,101 @@
+#include <cassert>
+
+#include <string>
+
+#include <graph_loader.hpp>
+
+void test_files(){
+  ParseError error {};
+
+  const auto m {load_weight_matrix<int>(GRAPH_FILES_DIR "/graph-1.txt", &error)};
+  assert(m);
+  assert(m->num_rows == 4 && m->num_cols == 4);
+  assert(m->const_at(0, 1) == 11);
+  assert(m->const_at(3, 2) == 5);
+
+  auto g {load_weighted_graph<int>(GRAPH_FILES_DIR "/graph-2.txt", &error)};
+  assert(g);
+  assert(g->num_verts == 6);
+  assert(g->num_edges == 9);
+  assert(g->has_edge(1, 5));
+  assert(!g->has_edge(0, 5));
+
+  WeightedGraph<int> graph {std::move(*g)};
+  assert(graph.num_edges == 9);
+  assert(graph.edge_weight(5, 1) == 42);
+
+  assert(!load_weight_matrix<int>("no_such_file.txt", &error));
+  assert(error.line == 0);
+}
+
+void test_errors(){
+  ParseError error {};
+
+  assert(!parse_weight_matrix<int>("  \n ", &error));
+  assert(error.line == 2 && error.column == 2);
+
+  assert(!parse_weight_matrix<int>("2\n1 2\n3 x4\n", &error));
+  assert(error.line == 3 && error.column == 3);
+  assert(error.message == "invalid number 'x4'");
+
+  assert(!parse_weight_matrix<int>("2\n1 2\n3\n", &error));
+  assert(error.line == 4 && error.column == 1);
+
+  assert(!parse_weight_matrix<int>("2\n1 2\n3 4 5\n", &error));
+  assert(error.line == 3 && error.column == 5);
+
+  assert(!parse_weight_matrix<signed char>("1\n300\n", &error));
+  assert(error.message == "number out of range");
+
+  assert(!parse_weight_matrix<int>("-1\n", &error));
+  assert(error.line == 1 && error.column == 1);
+
+  assert(!parse_weight_matrix<int>("100000000000 1 2", &error));
+
+  assert(!parse_weighted_graph<int>("2\n0 1\n2 0\n", &error));
+  assert(error.line == 3 && error.column == 1);
+
+  assert(!parse_weighted_graph<int>("2\n0 1\n1 7\n", &error));
+  assert(error.line == 3 && error.column == 3);
+  // weights may be laid out freely, and be floating point
+  const auto m {parse_weight_matrix<double>("2 0.5\t-1e3\n\n 2.25\r\n3")};
+  assert(m);
+  assert(m->const_at(0, 1) == -1e3);
+  assert(m->const_at(1, 0) == 2.25);
+}
+// large texts are split in chunks
+void test_large(){
+  const std::size_t n {700};
+  std::string text {std::to_string(n) + "\n"};
+  for (std::size_t i {0}; i < n; ++i){
+    for (std::size_t j {0}; j < n; ++j){
+      text += std::to_string(i == j ? 0 : (i + j) % 97 + 1000);
+      text += j + 1 < n ? ' ' : '\n';
+    }
+  }
+  assert(text.size() > 2 * graph_loader_detail::chunk_size);
+
+  ThreadPool pool {4};
+  ParseError error {};
+  const auto m {parse_weight_matrix<int>(text, &error, pool)};
+  assert(m);
+  for (std::size_t i {0}; i < n; ++i){
+    for (std::size_t j {0}; j < n; ++j){
+      assert(m->const_at(i, j) == (i == j ? 0 : int((i + j) % 97 + 1000)));
+    }
+  }
+
+  const auto g {parse_weighted_graph<int>(text, &error, pool)};
+  assert(g);
+  assert(g->num_edges == n * (n - 1) / 2);
+  // errors in later chunks are located in the whole text
+  text[text.size() - 3] = '?';
+  assert(!parse_weight_matrix<int>(text, &error, pool));
+  assert(error.line == n + 1);
+}
+
+int main(){
+  test_files();
+  test_errors();
+  test_large();
+}
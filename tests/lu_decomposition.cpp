@@ -0,0 +1,124 @@
+#include <cassert>
+
+#include <cmath>
+
+#include <random>
+
+#include <vector>
+
+#include <lu_decomposition.hpp>
+
+bool close(double a, double b, double tolerance = 1e-9){
+  return std::abs(a - b) <= tolerance * (1 + std::abs(b));
+}
+
+SquareMatrix<double> random_matrix(std::size_t n, unsigned seed){
+  std::mt19937 generator {seed};
+  std::uniform_real_distribution<double> value {-1, 1};
+
+  SquareMatrix<double> a {n};
+  for (std::size_t i {0}; i < n; ++i){
+    for (std::size_t j {0}; j < n; ++j){
+      a.at(i, j) = value(generator);
+    }
+  }
+
+  return a;
+}
+
+void test_small(){
+  SquareMatrix<double> a {3};
+  // needs a row exchange right away
+  a.at(0, 0) = 0; a.at(0, 1) = 2; a.at(0, 2) = 1;
+  a.at(1, 0) = 1; a.at(1, 1) = 1; a.at(1, 2) = 1;
+  a.at(2, 0) = 4; a.at(2, 1) = 3; a.at(2, 2) = 2;
+
+  LUDecomposition<double> lu {a};
+
+  assert(!lu.singular());
+  assert(lu.pivots()[0] == 2);
+  assert(close(lu.determinant(), 3));
+  assert(close(determinant(a), 3));
+
+  std::vector<double> b {3, 3, 9};
+  assert(lu.solve(b));
+  assert(close(b[0], 1) && close(b[1], 1) && close(b[2], 1));
+  // wrong dimensions
+  std::vector<double> c {1, 2};
+  assert(!lu.solve(c));
+}
+
+void test_singular(){
+  SquareMatrix<double> a {3};
+  a = 1;
+
+  LUDecomposition<double> lu {a};
+
+  assert(lu.singular());
+  assert(lu.determinant() == 0);
+  assert(!lu.inverse());
+
+  std::vector<double> b {1, 2, 3};
+  assert(!lu.solve(b));
+  assert(b[0] == 1 && b[1] == 2 && b[2] == 3);
+}
+// sizes cross several panels, with a partial last one
+void test_blocked(std::size_t n){
+  ThreadPool pool {3};
+  const SquareMatrix<double> a {random_matrix(n, n)};
+
+  LUDecomposition<double> lu {a, pool};
+  // P A = L U
+  const auto& f {lu.factors()};
+  SquareMatrix<double> pa {a};
+  for (std::size_t k {0}; k < n; ++k){
+    if (lu.pivots()[k] != k){
+      pa.row(k).swap(pa.row(lu.pivots()[k]));
+    }
+  }
+  for (std::size_t i {0}; i < n; ++i){
+    for (std::size_t j {0}; j < n; ++j){
+      double sum {0};
+      for (std::size_t p {0}; p <= std::min(i, j); ++p){
+        sum += (p == i ? 1 : f.const_at(i, p)) * f.const_at(p, j);
+      }
+      assert(close(sum, pa.const_at(i, j)));
+    }
+  }
+  // A A^-1 = I
+  const auto inverse {lu.inverse(pool)};
+  assert(inverse);
+  Matrix<double> product {n, n};
+  assert(multiply(a, *inverse, product));
+  for (std::size_t i {0}; i < n; ++i){
+    for (std::size_t j {0}; j < n; ++j){
+      assert(std::abs(product.const_at(i, j) - (i == j ? 1 : 0)) < 1e-8);
+    }
+  }
+  // several right hand sides at once
+  Matrix<double> x {n, 3};
+  for (std::size_t i {0}; i < n; ++i){
+    x.at(i, 0) = 1;
+    x.at(i, 1) = double(i);
+    x.at(i, 2) = -2;
+  }
+  Matrix<double> b {n, 3};
+  assert(multiply(a, x, b));
+  assert(solve(a, b, pool));
+  for (std::size_t i {0}; i < n; ++i){
+    for (std::size_t j {0}; j < 3; ++j){
+      assert(close(b.const_at(i, j), x.const_at(i, j), 1e-7));
+    }
+  }
+  // determinant does not depend on threads
+  ThreadPool single {1};
+  assert(close(LUDecomposition<double>{a, single}.determinant(), lu.determinant()));
+}
+
+int main(){
+  test_small();
+  test_singular();
+  test_blocked(1);
+  test_blocked(64);
+  test_blocked(150);
+}
@@ -1,7 +1,76 @@
 #include <cassert>
 
+#include <cstdint>
+
+#include <functional>
+
+#include <tuple>
+
+#include <vector>
+
 #include <matrix.hpp>
 
+// fills m with small values depending on its positions, so products
+// are exact even for floating point types
+template<typename Type, typename Storage>
+void fill(Matrix<Type, Storage>& m, int seed){
+  for (std::size_t i {0}; i < m.num_rows; ++i){
+    for (std::size_t j {0}; j < m.num_cols; ++j){
+      m.at(i, j) = static_cast<Type>((i * 7 + j * 3 + seed) % 11) - 5;
+    }
+  }
+}
+
+template<typename Type>
+Matrix<Type> naive_product(const Matrix<Type>& a, const Matrix<Type>& b){
+  Matrix<Type> c {a.num_rows, b.num_cols};
+
+  for (typename Matrix<Type>::size_type i {0}; i < a.num_rows; ++i){
+    for (typename Matrix<Type>::size_type j {0}; j < b.num_cols; ++j){
+      Type sum {};
+      for (typename Matrix<Type>::size_type k {0}; k < a.num_cols; ++k){
+        sum += a.const_at(i, k) * b.const_at(k, j);
+      }
+      c.at(i, j) = sum;
+    }
+  }
+
+  return c;
+}
+
+template<typename Type>
+bool equal(const Matrix<Type>& a, const Matrix<Type>& b){
+  if (a.num_rows != b.num_rows || a.num_cols != b.num_cols){
+    return false;
+  }
+
+  for (typename Matrix<Type>::size_type i {0}; i < a.num_rows; ++i){
+    for (typename Matrix<Type>::size_type j {0}; j < a.num_cols; ++j){
+      if (a.const_at(i, j) != b.const_at(i, j)){
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+template<typename Type>
+void test_multiply_type(){
+  // dimensions that are not multiples of any blocking parameter
+  for (auto [m, k, n] : {std::tuple{1, 1, 1}, std::tuple{7, 5, 3}, std::tuple{37, 301, 53}, std::tuple{130, 19, 150}}){
+    Matrix<Type> a {static_cast<std::size_t>(m), static_cast<std::size_t>(k)};
+    Matrix<Type> b {static_cast<std::size_t>(k), static_cast<std::size_t>(n)};
+    fill(a, 1);
+    fill(b, 2);
+
+    auto c {multiply(a, b)};
+
+    assert(c);
+    assert(equal(*c, naive_product(a, b)));
+  }
+}
+
 void test_matrix(){
   Matrix<bool> m {3, 4};
 
@@ -70,6 +139,499 @@ void test_upper_triangular_matrix(){
   assert(ut_m.at(2,3) == true);
 }
 
+void test_multiply(){
+  test_multiply_type<double>();
+  test_multiply_type<float>();
+  test_multiply_type<std::int32_t>();
+  test_multiply_type<long>();
+
+  Matrix<double> a {4, 3};
+  Matrix<double> b {3, 5};
+  fill(a, 3);
+  fill(b, 4);
+  // preallocated output is overwritten
+  Matrix<double> c {4, 5};
+  c = 100;
+
+  assert(multiply(a, b, c));
+  assert(equal(c, naive_product(a, b)));
+  // dimensions must agree
+  assert(!multiply(b, a));
+  assert(!multiply(a, b, a));
+  // product may overwrite one of its factors
+  SquareMatrix<double> s {3};
+  fill(s, 5);
+  Matrix<double> s_squared {naive_product<double>(s, s)};
+
+  assert(multiply(s, s, s));
+  assert(equal<double>(s, s_squared));
+  // types without packed kernels use the generic loop
+  Matrix<bool> p {2, 2};
+  Matrix<bool> q {2, 2};
+  p = false;
+  q = false;
+  p.at(0, 1) = true;
+  q.at(1, 0) = true;
+
+  auto pq {multiply(p, q)};
+
+  assert(pq);
+  assert(pq->at(0, 0) == true);
+  assert(pq->at(1, 1) == false);
+}
+
+// checks whether t holds the transpose of a matrix filled with seed
+template<typename Type>
+bool is_transpose(const Matrix<Type>& t, std::size_t rows, std::size_t cols, int seed){
+  Matrix<Type> a {rows, cols};
+  fill(a, seed);
+
+  if (t.num_rows != cols || t.num_cols != rows){
+    return false;
+  }
+
+  for (std::size_t i {0}; i < rows; ++i){
+    for (std::size_t j {0}; j < cols; ++j){
+      if (t.const_at(j, i) != a.const_at(i, j)){
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+void test_transpose(){
+  // square and rectangular, below and above the recursion block size
+  for (auto [rows, cols] : {std::pair{1, 1}, std::pair{5, 5}, std::pair{100, 100},
+                            std::pair{1, 9}, std::pair{3, 7}, std::pair{64, 37}, std::pair{97, 130}}){
+    Matrix<int> m {static_cast<std::size_t>(rows), static_cast<std::size_t>(cols)};
+    fill(m, 6);
+
+    Matrix<int> t {m.num_cols, m.num_rows};
+
+    assert(transpose(m, t));
+    assert(is_transpose(t, rows, cols, 6));
+
+    m.transpose();
+
+    assert(is_transpose(m, rows, cols, 6));
+  }
+  // output dimensions must agree
+  Matrix<int> m {3, 4};
+  Matrix<int> t {3, 4};
+
+  assert(!transpose(m, t));
+  // bitwise stored matrices are transposed in place as well
+  Matrix<bool> b {3, 5};
+  b = false;
+  b.at(0, 4) = true;
+  b.at(2, 1) = true;
+  b.transpose();
+
+  assert(b.num_rows == 5 && b.num_cols == 3);
+  assert(b.at(4, 0) == true);
+  assert(b.at(1, 2) == true);
+  assert(b.at(0, 1) == false);
+}
+
+void test_expressions(){
+  Matrix<double> a {5, 7};
+  Matrix<double> b {5, 7};
+  Matrix<double> d {5, 7};
+  fill(a, 1);
+  fill(b, 2);
+  fill(d, 3);
+  // evaluated on construction ...
+  Matrix<double> c = a + b * 2 - d;
+
+  assert(c.num_rows == 5 && c.num_cols == 7);
+  for (std::size_t i {0}; i < 5; ++i){
+    for (std::size_t j {0}; j < 7; ++j){
+      assert(c.at(i, j) == a.at(i, j) + b.at(i, j) * 2 - d.at(i, j));
+    }
+  }
+  // ... and on assignment, which may refer to the target itself
+  c = 0.5 * hadamard(c, a) - map(d, [](double x){ return x * x; }) + -c;
+
+  for (std::size_t i {0}; i < 5; ++i){
+    for (std::size_t j {0}; j < 7; ++j){
+      const double c_ij {a.at(i, j) + b.at(i, j) * 2 - d.at(i, j)};
+      assert(c.at(i, j) == 0.5 * c_ij * a.at(i, j) - d.at(i, j) * d.at(i, j) - c_ij);
+    }
+  }
+  // assignment takes the dimensions of the expression
+  Matrix<double> e {1, 1};
+  e = a - b;
+
+  assert(e.num_rows == 5 && e.num_cols == 7);
+  assert(e.at(4, 6) == a.at(4, 6) - b.at(4, 6));
+  // operands with disagreeing dimensions are not evaluated
+  Matrix<double> f {2, 2};
+  f = 1;
+
+  assert(!f.assign(a + e.row(0)));
+  f = a + Matrix<double>{7, 5};
+
+  assert(f.num_rows == 2 && f.at(1, 1) == 1);
+  // rows and columns are operands as well
+  a.row(0) = b.row(1) + d.row(2);
+
+  for (std::size_t j {0}; j < 7; ++j){
+    assert(a.at(0, j) == b.at(1, j) + d.at(2, j));
+  }
+
+  a.col(3) = 2 * b.col(0);
+
+  for (std::size_t i {0}; i < 5; ++i){
+    assert(a.at(i, 3) == 2 * b.at(i, 0));
+  }
+  // and so are square matrices, which keep their dimensions
+  SquareMatrix<int> s {3};
+  SquareMatrix<int> t {3};
+  fill(s, 4);
+  t = 1;
+  t = s - t;
+
+  assert(t.at(2, 1) == s.at(2, 1) - 1);
+
+  t = Matrix<int>{3, 4} + Matrix<int>{3, 4};
+
+  assert(t.num_cols == 3);
+}
+
+void test_views(){
+  Matrix<int> m {6, 8};
+  fill(m, 7);
+  // a view refers to elements of m ...
+  MatrixView<int> v {m.block(1, 2, 3, 4)};
+
+  assert(v.num_rows == 3 && v.num_cols == 4);
+  assert(v.stride() == 8);
+  assert(v.at(0, 0) == m.at(1, 2));
+  assert(v.at(2, 3) == m.at(3, 5));
+
+  v.at(1, 1) = 100;
+
+  assert(m.at(2, 3) == 100);
+  // ... as do its sub-blocks
+  MatrixView<int> w {v.block(1, 1, 2, 2)};
+
+  assert(w.at(0, 0) == 100);
+  assert(w.at(1, 1) == m.at(3, 4));
+  // mutable views convert to immutable ones
+  MatrixView<const int> c {w};
+
+  assert(c.const_at(1, 0) == m.at(3, 3));
+  // assignment copies elements, and views are expression operands
+  w = 0;
+
+  assert(m.at(2, 3) == 0 && m.at(3, 4) == 0);
+
+  m.block(0, 0, 2, 2) = m.block(4, 6, 2, 2) + 2 * c;
+
+  assert(m.at(1, 1) == m.at(5, 7) + 2 * m.at(3, 4));
+  // dimensions must agree
+  m.block(0, 0, 2, 2) = 5;
+  m.block(0, 0, 2, 2) = m.block(0, 0, 3, 3);
+
+  assert(m.at(0, 0) == 5);
+  // blocks may be assigned to overlapping blocks, in either direction,
+  // also within expressions
+  Matrix<int> o {3, 3};
+  for (std::size_t k {0}; k < 9; ++k){
+    o.at(k / 3, k % 3) = static_cast<int>(k);
+  }
+  o.block(1, 1, 2, 2) = o.block(0, 0, 2, 2);
+
+  assert(o.at(1, 1) == 0 && o.at(1, 2) == 1 && o.at(2, 1) == 3 && o.at(2, 2) == 4);
+
+  o.block(0, 0, 2, 2) = o.block(1, 1, 2, 2);
+
+  assert(o.at(0, 0) == 0 && o.at(0, 1) == 1 && o.at(1, 0) == 3 && o.at(1, 1) == 4);
+
+  o.block(0, 1, 3, 2) = o.block(0, 0, 3, 2) * 2;
+
+  assert(o.at(0, 1) == 0 && o.at(0, 2) == 2 && o.at(1, 2) == 8 && o.at(2, 2) == 6);
+  // blocks of matrices are multiplied in place
+  Matrix<double> a {40, 50};
+  Matrix<double> b {50, 30};
+  fill(a, 8);
+  fill(b, 9);
+
+  Matrix<double> a_block {a.block(3, 4, 20, 25)};
+  Matrix<double> b_block {b.block(5, 1, 25, 17)};
+  Matrix<double> product {naive_product(a_block, b_block)};
+
+  Matrix<double> c_big {30, 30};
+  c_big = -1;
+
+  assert(multiply(a.block(3, 4, 20, 25), b.block(5, 1, 25, 17), c_big.block(2, 3, 20, 17)));
+  assert(equal(Matrix<double>{c_big.block(2, 3, 20, 17)}, product));
+  assert(c_big.at(0, 0) == -1 && c_big.at(22, 3) == -1);
+  // even when the product overlaps a factor
+  SquareMatrix<double> s {10};
+  fill(s, 10);
+  Matrix<double> s_block {s.block(0, 0, 5, 5)};
+
+  assert(multiply(s.block(0, 0, 5, 5), s.block(0, 0, 5, 5), s.block(0, 0, 5, 5)));
+  assert(equal(Matrix<double>{s.block(0, 0, 5, 5)}, naive_product(s_block, s_block)));
+  // and transposed
+  Matrix<double> t {17, 20};
+
+  assert(transpose(c_big.block(2, 3, 20, 17), t.view()));
+  assert(t.at(16, 19) == product.at(19, 16));
+  assert(!transpose(s.block(0, 0, 5, 5), s.block(2, 2, 5, 5)));
+}
+
+void test_storage(){
+  // rows are aligned and padded
+  Matrix<double, AlignedRows<>> a {5, 13};
+
+  assert(a.stride() == 16);
+  assert(reinterpret_cast<std::uintptr_t>(a.data()) % 64 == 0);
+  // rows spanning a multiple of 4 KiB get an extra cache line
+  Matrix<double, AlignedRows<>> p {3, 512};
+
+  assert(p.stride() == 520);
+  // leading dimension can be set explicitly
+  Matrix<int> e {4, 6, 10};
+
+  assert(e.stride() == 10);
+  // accessors, rows and columns respect the stride
+  fill(a, 11);
+  Matrix<double> packed {a};
+
+  assert(packed.stride() == 13);
+  for (std::size_t i {0}; i < 5; ++i){
+    for (std::size_t j {0}; j < 13; ++j){
+      assert(packed.at(i, j) == a.at(i, j));
+    }
+  }
+
+  a.row(4) = 3.5;
+  a.col(12) = 4.5;
+
+  assert(a.at(4, 0) == 3.5 && a.at(3, 12) == 4.5 && a.at(4, 12) == 4.5);
+  assert(a.block(4, 10, 1, 3).const_at(0, 1) == 3.5);
+  // products and transposes of padded matrices
+  Matrix<double, AlignedRows<>> b {13, 7};
+  fill(b, 12);
+  fill(a, 11);
+  Matrix<double, AlignedRows<>> c {5, 7};
+
+  assert(multiply(a, b, c));
+  assert(equal(Matrix<double>{c}, naive_product(packed, Matrix<double>{b})));
+
+  a.transpose();
+
+  assert(a.stride() == 8);
+  assert(is_transpose(Matrix<double>{a}, 5, 13, 11));
+
+  SquareMatrix<double, AlignedRows<>> s {9};
+  fill(s, 13);
+  s.transpose();
+
+  assert(is_transpose(Matrix<double>{s}, 9, 9, 13));
+  // huge pages hold matrices as any other allocator
+  Matrix<float, HugePageRows> h {100, 100};
+  h = 1;
+  h.at(99, 99) = 2;
+
+  assert(h.at(0, 0) == 1 && h.at(99, 99) == 2);
+}
+
+void test_triangular_kernels(std::size_t n){
+  // unit diagonal and small integers keep substitutions exact
+  UpperTriangularMatrix<double> u {n};
+  LowerTriangularMatrix<double> l {n};
+  for (std::size_t i {0}; i < n; ++i){
+    for (std::size_t j {i}; j < n; ++j){
+      u.at(i, j) = i == j ? 1 : static_cast<double>((i * 5 + j * 3) % 7) - 3;
+      l.at(j, i) = i == j ? 1 : static_cast<double>((i * 2 + j) % 5) - 2;
+    }
+  }
+  assert(n == 1 || u.const_at(n - 1, 0) == 0);
+  assert(n == 1 || l.const_at(0, n - 1) == 0);
+
+  Matrix<double> x {n, 3};
+  fill(x, 1);
+  // dense products, computed through references
+  Matrix<double> ux {n, 3};
+  Matrix<double> lx {n, 3};
+  for (std::size_t i {0}; i < n; ++i){
+    for (std::size_t k {0}; k < 3; ++k){
+      double u_sum {0};
+      double l_sum {0};
+      for (std::size_t j {0}; j < n; ++j){
+        u_sum += u.const_at(i, j) * x.const_at(j, k);
+        l_sum += l.const_at(i, j) * x.const_at(j, k);
+      }
+      ux.at(i, k) = u_sum;
+      lx.at(i, k) = l_sum;
+    }
+  }
+  // triangular times dense
+  Matrix<double> c {n, 3};
+  assert(multiply(u, x, c));
+  assert(equal(c, ux));
+  assert(multiply(l, x, c));
+  assert(equal(c, lx));
+  Matrix<double> wrong {n + 1, 3};
+  assert(!multiply(u, x, wrong));
+  // matrix-vector products, in and out of place
+  std::vector<double> v (n);
+  std::vector<double> y (n);
+  for (std::size_t i {0}; i < n; ++i){
+    v[i] = x.const_at(i, 0);
+  }
+  assert(multiply(u, v, y));
+  for (std::size_t i {0}; i < n; ++i){
+    assert(y[i] == ux.const_at(i, 0));
+  }
+  y = v;
+  assert(multiply(l, y, y));
+  for (std::size_t i {0}; i < n; ++i){
+    assert(y[i] == lx.const_at(i, 0));
+  }
+  // triangular solves recover x
+  assert(solve(l, y));
+  for (std::size_t i {0}; i < n; ++i){
+    assert(y[i] == v[i]);
+  }
+  for (std::size_t i {0}; i < n; ++i){
+    y[i] = ux.const_at(i, 0);
+  }
+  assert(solve(u, y));
+  for (std::size_t i {0}; i < n; ++i){
+    assert(y[i] == v[i]);
+  }
+  assert(solve(u, ux));
+  assert(equal(ux, x));
+  assert(solve(l, lx));
+  assert(equal(lx, x));
+  // singular triangles are not solved
+  u.at(n - 1, n - 1) = 0;
+  assert(!solve(u, y));
+  assert(!solve(u, lx));
+}
+
+void test_symmetric_matrix(std::size_t n){
+  SymmetricMatrix<double> s {n};
+  Matrix<double> dense {n, n};
+  for (std::size_t i {0}; i < n; ++i){
+    for (std::size_t j {0}; j <= i; ++j){
+      s.at(i, j) = static_cast<double>((i * 3 + j * 3 + i * j) % 13) - 6;
+      dense.at(i, j) = dense.at(j, i) = s.const_at(j, i);
+    }
+  }
+  // both positions refer to one element
+  s.at(0, n - 1) = 42;
+  assert(s.const_at(n - 1, 0) == 42);
+  s.at(n - 1, 0) = dense.const_at(0, n - 1);
+
+  auto copy {SymmetricMatrix<double>::from(dense)};
+  assert(copy);
+  assert(copy->num_rows == n);
+  for (std::size_t i {0}; i < n; ++i){
+    for (std::size_t j {0}; j < n; ++j){
+      assert(copy->const_at(i, j) == dense.const_at(i, j));
+    }
+  }
+  if (n > 1){
+    dense.at(0, 1) += 1;
+    assert(!SymmetricMatrix<double>::from(dense));
+    dense.at(0, 1) -= 1;
+  }
+  // matrix-vector product
+  std::vector<double> x (n);
+  for (std::size_t i {0}; i < n; ++i){
+    x[i] = static_cast<double>(i % 5) - 2;
+  }
+  std::vector<double> y (n);
+  assert(multiply(s, x, y));
+  for (std::size_t i {0}; i < n; ++i){
+    double sum {0};
+    for (std::size_t j {0}; j < n; ++j){
+      sum += dense.const_at(i, j) * x[j];
+    }
+    assert(y[i] == sum);
+  }
+  std::vector<double> wrong (n + 1);
+  assert(!multiply(s, x, wrong));
+  // rank-k update
+  Matrix<double> a {n, 5};
+  fill(a, 2);
+  assert(rank_update(s, a, 2.0));
+  for (std::size_t i {0}; i < n; ++i){
+    for (std::size_t j {0}; j < n; ++j){
+      double sum {dense.const_at(i, j)};
+      for (std::size_t k {0}; k < 5; ++k){
+        sum += 2 * a.const_at(i, k) * a.const_at(j, k);
+      }
+      assert(s.const_at(i, j) == sum);
+    }
+  }
+  Matrix<double> b {n + 1, 5};
+  assert(!rank_update(s, b));
+}
+
+void test_map_reduce(){
+  ThreadPool pool {4};
+
+  for (std::size_t cols : {std::size_t{1}, std::size_t{37}, std::size_t{300}}){
+    Matrix<double> packed {500, cols};
+    Matrix<double, AlignedRows<64>> aligned {500, cols};
+    fill(packed, 3);
+    fill(aligned, 3);
+    // elements are -5 .. 5: squares, sums, maxima and counts are exact
+    packed.map([](double x){ return x * 2; }, pool);
+    aligned.map([](double x){ return x * 2; }, pool);
+
+    double sum {0};
+    double max {-100};
+    std::size_t positive {0};
+    std::vector<double> row_sums (500, 0);
+    std::vector<double> col_max (cols, -100);
+    for (std::size_t i {0}; i < 500; ++i){
+      for (std::size_t j {0}; j < cols; ++j){
+        const double x {packed.const_at(i, j)};
+        assert(x == aligned.const_at(i, j));
+        sum += x * x;
+        max = std::max(max, x);
+        positive += x > 0;
+        row_sums[i] += x;
+        col_max[j] = std::max(col_max[j], x);
+      }
+    }
+
+    const auto square   {[](double x){ return x * x; }};
+    const auto maximum  {[](double a, double b){ return std::max(a, b); }};
+    const auto count_if {[](double x){ return std::size_t{x > 0}; }};
+
+    assert(packed.reduce(0.0, std::plus<>{}, square, pool) == sum);
+    assert(aligned.reduce(0.0, std::plus<>{}, square, pool) == sum);
+    assert(packed.reduce(-100.0, maximum, {}, pool) == max);
+    assert(aligned.reduce(std::size_t{0}, std::plus<>{}, count_if) == positive);
+    assert(packed.row_reduce(0.0, std::plus<>{}, {}, pool) == row_sums);
+    assert(aligned.row_reduce(0.0, std::plus<>{}) == row_sums);
+    assert(packed.col_reduce(-100.0, maximum, {}, pool) == col_max);
+    assert(aligned.col_reduce(-100.0, maximum, {}, pool) == col_max);
+  }
+  // init is combined once, and returned for empty matrices
+  Matrix<int> empty {0, 4};
+  assert(empty.reduce(7, std::plus<>{}) == 7);
+  assert(empty.col_reduce(7, std::plus<>{}) == std::vector<int>(4, 7));
+  Matrix<int> ones {3, 3};
+  ones = 1;
+  assert(ones.reduce(7, std::plus<>{}) == 16);
+  // matrices of bits are mapped and reduced too
+  Matrix<bool> bits {10, 10};
+  bits = false;
+  bits.map([](bool){ return true; });
+  assert(bits.reduce(0, std::plus<>{}, [](bool b){ return int{b}; }) == 100);
+}
+
 int main(){
   test_matrix();
 
@@ -77,5 +639,25 @@ int main(){
 
   test_upper_triangular_matrix();
 
+  test_multiply();
+
+  test_transpose();
+
+  test_expressions();
+
+  test_views();
+
+  test_storage();
+
+  test_triangular_kernels(1);
+  test_triangular_kernels(7);
+  test_triangular_kernels(150);
+
+  test_symmetric_matrix(1);
+  test_symmetric_matrix(8);
+  test_symmetric_matrix(150);
+
+  test_map_reduce();
+
   return 0;
 }
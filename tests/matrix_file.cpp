@@ -0,0 +1,116 @@
+#include <cassert>
+
+#include <cstdio>
+
+#include <cstdint>
+
+#include <fstream>
+
+#include <matrix_file.hpp>
+
+template<typename Type, typename Storage>
+void fill(Matrix<Type, Storage>& m){
+  for (std::size_t i {0}; i < m.num_rows; ++i){
+    for (std::size_t j {0}; j < m.num_cols; ++j){
+      m.at(i, j) = static_cast<Type>(i * 100 + j);
+    }
+  }
+}
+
+void test_save_load(){
+  const std::string path {"matrix_file_test_save_load.bin"};
+
+  Matrix<double> m {13, 7};
+  fill(m);
+  assert(save(m, path));
+
+  auto loaded {load<double>(path)};
+  assert(loaded);
+  assert(loaded->num_rows == 13 && loaded->num_cols == 7);
+  for (std::size_t i {0}; i < 13; ++i){
+    for (std::size_t j {0}; j < 7; ++j){
+      assert(loaded->const_at(i, j) == m.const_at(i, j));
+    }
+  }
+  // padded rows are loaded into a packed matrix, and back
+  Matrix<std::int32_t, AlignedRows<64>> padded {5, 3};
+  fill(padded);
+  assert(padded.stride() == 16);
+  assert(save(padded, path));
+
+  auto packed {load<std::int32_t>(path)};
+  assert(packed);
+  assert(packed->stride() == 3);
+  auto aligned {load<std::int32_t, AlignedRows<64>>(path)};
+  assert(aligned);
+  for (std::size_t i {0}; i < 5; ++i){
+    for (std::size_t j {0}; j < 3; ++j){
+      assert(packed->const_at(i, j) == padded.const_at(i, j));
+      assert(aligned->const_at(i, j) == padded.const_at(i, j));
+    }
+  }
+  // element types must agree
+  assert(!load<float>(path));
+  assert(!load<std::uint32_t>(path));
+  assert(!load<double>("no_such_file.bin"));
+
+  std::remove(path.c_str());
+}
+
+void test_mapped(){
+  const std::string path {"matrix_file_test_mapped.bin"};
+
+  Matrix<double, AlignedRows<64>> m {20, 9};
+  fill(m);
+  assert(save(m, path));
+
+  auto mapped {MappedMatrix<double>::open(path)};
+  assert(mapped);
+  assert(mapped->num_rows == 20 && mapped->num_cols == 9);
+  assert(mapped->stride() == m.stride());
+  // elements are aligned as in memory
+  assert(reinterpret_cast<std::uintptr_t>(mapped->data()) % 64 == 0);
+  for (std::size_t i {0}; i < 20; ++i){
+    for (std::size_t j {0}; j < 9; ++j){
+      assert(mapped->const_at(i, j) == m.const_at(i, j));
+    }
+  }
+  // mapped matrices take part in expressions and products
+  Matrix<double> twice {*mapped + *mapped};
+  assert(twice.const_at(3, 4) == 2 * m.const_at(3, 4));
+
+  Matrix<double> identity {9, 9};
+  identity = 0;
+  for (std::size_t i {0}; i < 9; ++i){
+    identity.at(i, i) = 1;
+  }
+  Matrix<double> product {20, 9};
+  assert(multiply(mapped->view(), identity.view(), product.view()));
+  assert(product.const_at(19, 8) == m.const_at(19, 8));
+  assert(mapped->block(2, 3, 2, 2).const_at(1, 1) == m.const_at(3, 4));
+  // mappings move
+  MappedMatrix<double> moved {std::move(*mapped)};
+  assert(moved.num_rows == 20);
+  assert(mapped->num_rows == 0);
+  // wrong types, bad magic and truncated files are rejected
+  assert(!MappedMatrix<float>::open(path));
+  {
+    std::fstream corrupted {path, std::ios::binary | std::ios::in | std::ios::out};
+    corrupted.write("X", 1);
+  }
+  assert(!MappedMatrix<double>::open(path));
+  {
+    std::ofstream truncated {path, std::ios::binary | std::ios::trunc};
+    const auto header {MatrixFileHeader::make<double>(20, 9, 9)};
+    truncated.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  }
+  assert(!MappedMatrix<double>::open(path));
+  assert(!MappedMatrix<double>::open("no_such_file.bin"));
+
+  std::remove(path.c_str());
+}
+
+int main(){
+  test_save_load();
+  test_mapped();
+}
@@ -0,0 +1,34 @@
+// another way to achieve what #pragma once does
+#ifndef random_graph_hpp
+#define random_graph_hpp
+// pairs of vertices are drawn at random
+#include <random>
+// calls function(u, v) for each ordered pair of vertices among
+// num_verts, loops included, with a probability of density. Pairs are
+// drawn by a generator seeded with seed, so tests are repeatable
+template<typename Function>
+void for_each_random_pair(std::size_t num_verts, double density, unsigned seed, Function function){
+  std::mt19937 generator {seed};
+  std::bernoulli_distribution present {density};
+
+  for (std::size_t u {0}; u < num_verts; ++u){
+    for (std::size_t v {0}; v < num_verts; ++v){
+      if (present(generator)){
+        function(u, v);
+      }
+    }
+  }
+}
+// adds the same random edges to each of graphs, which have num_verts
+// vertices, so that representations can be checked against each
+// other. Loops are only added when loops is true
+template<typename... Graphs>
+void add_random_edges(std::size_t num_verts, double density, bool loops, Graphs&... graphs){
+  for_each_random_pair(num_verts, density, static_cast<unsigned>(num_verts), [&](std::size_t u, std::size_t v){
+    if (loops || u != v){
+      (graphs.add_edge(u, v), ...);
+    }
+  });
+}
+
+#endif
@@ -0,0 +1,153 @@
+#include <cassert>
+
+#include <vector>
+
+#include <sparse_matrix.hpp>
+
+// a 4 x 5 matrix with 6 nonzeros
+Matrix<double> example(){
+  Matrix<double> m {4, 5};
+
+  m.at(0, 0) = 1;
+  m.at(0, 3) = 2;
+  m.at(1, 1) = 3;
+  m.at(2, 0) = 4;
+  m.at(2, 4) = 5;
+  m.at(3, 3) = 6;
+
+  return m;
+}
+
+template<typename MatrixA, typename MatrixB>
+bool equal(const MatrixA& a, const MatrixB& b){
+  if (a.num_rows != b.num_rows || a.num_cols != b.num_cols){
+    return false;
+  }
+
+  for (std::size_t i {0}; i < a.num_rows; ++i){
+    for (std::size_t j {0}; j < a.num_cols; ++j){
+      if (a.const_at(i, j) != b.const_at(i, j)){
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+void test_construction(){
+  Matrix<double> dense {example()};
+
+  CsrMatrix<double> csr {dense};
+  CscMatrix<double> csc {dense};
+
+  assert(csr.num_rows == 4 && csr.num_cols == 5);
+  assert(csr.num_nonzeros() == 6 && csc.num_nonzeros() == 6);
+  assert(csr.const_at(2, 4) == 5 && csr.const_at(2, 3) == 0);
+  assert(csc.const_at(3, 3) == 6 && csc.const_at(1, 0) == 0);
+  assert(equal(csr.to_dense(), dense));
+  assert(equal(csc.to_dense(), dense));
+  assert(equal(CscMatrix<double>{csr}, dense));
+  // triplets come in any order; duplicates are summed and zeros dropped
+  std::vector<Triplet<double>> triplets {{3, 3, 6}, {2, 4, 5}, {0, 3, 1}, {1, 1, 3}, {0, 0, 1},
+                                         {2, 0, 4}, {0, 3, 1}, {1, 2, 7}, {1, 2, -7}};
+
+  auto from_triplets {CsrMatrix<double>::from_triplets(4, 5, triplets)};
+
+  assert(from_triplets);
+  assert(from_triplets->num_nonzeros() == 6);
+  assert(equal(*from_triplets, dense));
+
+  auto csc_from_triplets {CscMatrix<double>::from_triplets(4, 5, triplets)};
+
+  assert(csc_from_triplets);
+  assert(equal(*csc_from_triplets, dense));
+  // out of bounds triplets are rejected
+  assert(!CsrMatrix<double>::from_triplets(4, 4, triplets));
+  assert(!CscMatrix<double>::from_triplets(3, 5, triplets));
+}
+
+void test_products(){
+  Matrix<double> dense {example()};
+  CsrMatrix<double> csr {dense};
+  CscMatrix<double> csc {dense};
+  ThreadPool pool {3};
+  // matrix-vector
+  std::vector<double> x {1, 2, 3, 4, 5};
+  std::vector<double> y (4);
+  std::vector<double> expected {9, 6, 29, 24};
+
+  assert(multiply(csr, x, y, pool));
+  assert(y == expected);
+
+  std::fill(y.begin(), y.end(), -1);
+
+  assert(multiply(csc, x, y, pool));
+  assert(y == expected);
+  assert(!multiply(csr, y, x, pool));
+  // matrix-matrix
+  Matrix<double> b {5, 3};
+  for (std::size_t i {0}; i < 5; ++i){
+    for (std::size_t j {0}; j < 3; ++j){
+      b.at(i, j) = static_cast<double>(i * 3 + j);
+    }
+  }
+
+  Matrix<double> c {4, 3};
+  Matrix<double> d {4, 3};
+
+  assert(multiply(dense, b, d));
+  assert(multiply(csr, b, c, pool));
+  assert(equal(c, d));
+
+  c = -1;
+
+  assert(multiply(csc, b, c, pool));
+  assert(equal(c, d));
+  assert(!multiply(csr, c, b, pool));
+  // products may overwrite their dense operand
+  Matrix<double> square {5, 5};
+  for (std::size_t i {0}; i < 5; ++i){
+    for (std::size_t j {0}; j < 5; ++j){
+      square.at(i, j) = static_cast<double>((i * 7 + j * 3) % 11);
+    }
+  }
+  Matrix<double> s_dense {5, 5};
+  for (std::size_t i {0}; i < 4; ++i){
+    s_dense.at(i, i + 1) = 1;
+  }
+  s_dense.at(4, 0) = 2;
+  CsrMatrix<double> s_csr {s_dense};
+  CscMatrix<double> s_csc {s_dense};
+  Matrix<double> shifted {5, 5};
+
+  assert(multiply(s_dense, square, shifted));
+
+  Matrix<double> aliased {square};
+
+  assert(multiply(s_csr, aliased, aliased, pool));
+  assert(equal(aliased, shifted));
+
+  aliased = square;
+
+  assert(multiply(s_csc, aliased, aliased, pool));
+  assert(equal(aliased, shifted));
+
+  std::vector<double> z {1, 2, 3, 4, 5};
+
+  assert(multiply(s_csr, z, z, pool));
+  assert((z == std::vector<double>{2, 3, 4, 5, 2}));
+
+  z = {1, 2, 3, 4, 5};
+
+  assert(multiply(s_csc, z, z, pool));
+  assert((z == std::vector<double>{2, 3, 4, 5, 2}));
+}
+
+int main(){
+  test_construction();
+
+  test_products();
+
+  return 0;
+}
@@ -0,0 +1,92 @@
+#include <cassert>
+
+#include <static_matrix.hpp>
+
+void test_construction(){
+  constexpr StaticMatrix<int, 2, 3> m {1, 2, 3,
+                                       4, 5, 6};
+
+  static_assert(m.num_rows == 2 && m.num_cols == 3);
+  static_assert(m.const_at(1, 0) == 4);
+  static_assert(StaticMatrix<int, 3, 3>::identity().const_at(1, 1) == 1);
+  static_assert(StaticMatrix<int, 3, 3>::identity().const_at(1, 2) == 0);
+
+  StaticMatrix<double, 2, 2> z {};
+
+  assert(z.at(1, 1) == 0);
+
+  z.at(1, 1) = 3;
+
+  assert(z.const_at(1, 1) == 3);
+}
+
+void test_kernels(){
+  constexpr StaticMatrix<int, 2, 3> a {1, 2, 3,
+                                       4, 5, 6};
+  constexpr StaticMatrix<int, 3, 2> b {7,  8,
+                                       9,  10,
+                                       11, 12};
+  // everything is evaluated at compile time
+  static_assert(a.transposed() == StaticMatrix<int, 3, 2>{1, 4, 2, 5, 3, 6});
+  static_assert(a * b == StaticMatrix<int, 2, 2>{58, 64, 139, 154});
+  static_assert(determinant(StaticMatrix<int, 2, 2>{3, 8, 4, 6}) == -14);
+  static_assert(determinant(StaticMatrix<int, 3, 3>{6, 1, 1, 4, -2, 5, 2, 8, 7}) == -306);
+  static_assert(determinant(StaticMatrix<int, 4, 4>{1, 0, 2, -1, 3, 0, 0, 5, 2, 1, 4, -3, 1, 0, 5, 0}) == 30);
+  static_assert(determinant(StaticMatrix<int, 5, 5>::identity()) == 1);
+  // elimination with a zero pivot
+  static_assert(determinant(StaticMatrix<int, 5, 5>{0, 1, 0, 0, 0,
+                                                    1, 0, 0, 0, 0,
+                                                    0, 0, 2, 0, 0,
+                                                    0, 0, 0, 3, 0,
+                                                    0, 0, 0, 1, 1}) == -6);
+  // square matrices are transposed in place
+  StaticMatrix<float, 4, 4> m {StaticMatrix<float, 4, 4>::generate([](std::size_t i, std::size_t j){ return i * 4 + j; })};
+  m.transpose();
+
+  assert(m.at(1, 0) == 1 && m.at(0, 1) == 4);
+  assert((m * StaticMatrix<float, 4, 4>::identity() == m));
+}
+
+void test_interoperability(){
+  StaticMatrix<double, 3, 3> s {2, 0, 0,
+                                0, 3, 0,
+                                0, 0, 4};
+  // conversion to heap allocated matrices ...
+  Matrix<double> m {s};
+
+  assert(m.num_rows == 3 && m.at(2, 2) == 4);
+
+  SquareMatrix<double> q {static_cast<SquareMatrix<double>>(s)};
+
+  assert(q.at(1, 1) == 3);
+  // ... and back, when dimensions agree
+  auto t {StaticMatrix<double, 3, 3>::from(m)};
+
+  assert(t && *t == s);
+  assert(!(StaticMatrix<double, 2, 3>::from(m)));
+  // static matrices take part in expressions and products through
+  // views
+  m = s + s;
+
+  assert(m.at(0, 0) == 4);
+
+  Matrix<double> p {3, 3};
+
+  assert(multiply(s.view(), m.view(), p.view()));
+  assert(p.at(2, 2) == 32);
+
+  StaticMatrix<double, 2, 2> corner {};
+  corner.view() = m.block(1, 1, 2, 2);
+
+  assert(corner.at(1, 1) == 8);
+}
+
+int main(){
+  test_construction();
+
+  test_kernels();
+
+  test_interoperability();
+
+  return 0;
+}
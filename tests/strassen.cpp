@@ -0,0 +1,57 @@
+#include <cassert>
+
+#include <strassen.hpp>
+
+// small integers keep every sum and product exact
+template<typename Storage>
+void fill(SquareMatrix<double, Storage>& m, int seed){
+  for (std::size_t i {0}; i < m.num_rows; ++i){
+    for (std::size_t j {0}; j < m.num_cols; ++j){
+      m.at(i, j) = static_cast<double>((i * 7 + j * 3 + seed) % 11) - 5;
+    }
+  }
+}
+
+template<typename StorageA, typename StorageB>
+bool equal(const SquareMatrix<double, StorageA>& a, const SquareMatrix<double, StorageB>& b){
+  for (std::size_t i {0}; i < a.num_rows; ++i){
+    for (std::size_t j {0}; j < a.num_cols; ++j){
+      if (a.const_at(i, j) != b.const_at(i, j)){
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+void test_strassen(std::size_t n, std::size_t crossover){
+  ThreadPool pool {3};
+
+  SquareMatrix<double> a {n};
+  SquareMatrix<double, AlignedRows<64>> b {n};
+  fill(a, 1);
+  fill(b, 2);
+
+  SquareMatrix<double> expected {n};
+  assert(multiply(a, b, expected));
+
+  SquareMatrix<double> c {n};
+  assert(strassen_multiply(a, b, c, crossover, pool));
+  assert(equal(c, expected));
+  // the product may overwrite a factor
+  assert(strassen_multiply(a, b, a, crossover, pool));
+  assert(equal(a, expected));
+}
+
+int main(){
+  test_strassen(1, 1);
+  test_strassen(10, 16);
+  test_strassen(64, 16);
+  test_strassen(129, 16);
+  test_strassen(200, 7);
+
+  SquareMatrix<double> a {4};
+  SquareMatrix<double> b {5};
+  assert(!strassen_multiply(a, b, a));
+}
@@ -0,0 +1,173 @@
+#include <cassert>
+
+#include <cstdint>
+
+#include <utility>
+
+#include <vector>
+
+#include <strongly_connected_components.hpp>
+
+#include "random_graph.hpp"
+// whether v is reachable from u in d
+template<typename DigraphType>
+std::vector<bool> reachable_from(const DigraphType& d, std::size_t u){
+  std::vector<bool> reached (d.num_verts, false);
+  depth_first_search(d, u, [&reached](std::size_t v){ reached[v] = true; });
+
+  return reached;
+}
+// u and v are in the same component exactly when they reach each
+// other, and components are numbered in topological order
+template<typename DigraphType>
+void check_components(const DigraphType& d){
+  const Components c {strongly_connected_components(d)};
+  const std::size_t n {d.num_verts};
+
+  std::vector<std::vector<bool>> reach {};
+  for (std::size_t u {0}; u < n; ++u){
+    reach.push_back(reachable_from(d, u));
+  }
+
+  std::vector<std::size_t> size (c.count(), 0);
+  for (std::size_t u {0}; u < n; ++u){
+    assert(c.label[u] < c.count());
+    ++size[c.label[u]];
+    for (std::size_t v {0}; v < n; ++v){
+      assert((c.label[u] == c.label[v]) == (reach[u][v] && reach[v][u]));
+      if (d.has_edge(u, v)){
+        assert(c.label[u] <= c.label[v]);
+      }
+    }
+  }
+  assert(size == c.size);
+  // the condensation has an edge between different components joined
+  // by some edge of d, and is acyclic
+  const auto dag {condensation(d, c)};
+  assert(dag.num_verts == c.count());
+  for (std::size_t a {0}; a < c.count(); ++a){
+    for (std::size_t b {0}; b < c.count(); ++b){
+      bool joined {false};
+      for (std::size_t u {0}; u < n; ++u){
+        for (std::size_t v {0}; v < n; ++v){
+          joined = joined || (a != b && c.label[u] == a && c.label[v] == b && d.has_edge(u, v));
+        }
+      }
+      assert(dag.has_edge(a, b) == joined);
+    }
+  }
+  assert(topological_sort(dag).has_value());
+}
+// order is a permutation of the vertices of d where every edge goes
+// forward
+template<typename DigraphType>
+void check_order(const DigraphType& d, const std::vector<std::size_t>& order){
+  std::vector<std::size_t> position (d.num_verts, d.num_verts);
+  assert(order.size() == d.num_verts);
+  for (std::size_t k {0}; k < order.size(); ++k){
+    assert(position[order[k]] == d.num_verts);
+    position[order[k]] = k;
+  }
+  for (std::size_t u {0}; u < d.num_verts; ++u){
+    d.for_each_neighbor(u, [&](std::size_t v){ assert(position[u] < position[v]); });
+  }
+}
+
+void test_small(){
+  // two cycles, {0, 1, 2} and {3, 4}, joined by 2 -> 3, and 5 alone
+  Digraph d {6};
+  d.add_edge(0, 1);
+  d.add_edge(1, 2);
+  d.add_edge(2, 0);
+  d.add_edge(2, 3);
+  d.add_edge(3, 4);
+  d.add_edge(4, 3);
+  d.add_edge(5, 4);
+
+  const Components c {strongly_connected_components(d)};
+  assert(c.count() == 3);
+  assert(c.label[0] == c.label[1] && c.label[1] == c.label[2]);
+  assert(c.label[3] == c.label[4]);
+  assert(c.label[0] < c.label[3] && c.label[5] < c.label[3]);
+  assert(c.size[c.label[0]] == 3 && c.size[c.label[3]] == 2 && c.size[c.label[5]] == 1);
+
+  const auto dag {condensation(d)};
+  assert(dag.num_verts == 3 && dag.num_edges == 2);
+  assert(dag.has_edge(c.label[0], c.label[3]));
+  assert(dag.has_edge(c.label[5], c.label[3]));
+  // cycles have no topological order, but their condensations have
+  assert(!topological_sort(d));
+  const auto order {topological_sort(dag)};
+  assert(order);
+  check_order(dag, *order);
+
+  d.remove_edge(2, 0);
+  d.remove_edge(4, 3);
+  const auto sorted {topological_sort(d)};
+  assert(sorted);
+  check_order(d, *sorted);
+  assert(strongly_connected_components(d).count() == 6);
+}
+// a path 0 -> 1 -> ... -> n - 1, closed into a cycle when asked,
+// which a recursive search would go through with n nested calls
+CsrDigraph path(std::size_t n, bool cycle){
+  std::vector<std::size_t> start (n + 1);
+  std::vector<std::uint32_t> neighbor {};
+  for (std::size_t u {0}; u < n; ++u){
+    start[u] = neighbor.size();
+    if (u + 1 < n || cycle){
+      neighbor.push_back(static_cast<std::uint32_t>((u + 1) % n));
+    }
+  }
+  start[n] = neighbor.size();
+
+  return CsrDigraph::from_compressed(std::move(start), std::move(neighbor));
+}
+
+void test_deep(std::size_t n){
+  const CsrDigraph line {path(n, false)};
+  const auto order {topological_sort(line)};
+  assert(order);
+  check_order(line, *order);
+  assert(strongly_connected_components(line).count() == n);
+
+  const CsrDigraph ring {path(n, true)};
+  assert(!topological_sort(ring));
+  const Components c {strongly_connected_components(ring)};
+  assert(c.count() == 1 && c.size[0] == n);
+  assert(condensation(ring).num_edges == 0);
+}
+// random digraphs with num_verts vertices, each edge present with a
+// probability of density, on several backends
+void test_random(std::size_t num_verts, double density){
+  Digraph d {num_verts};
+  Digraph dag {num_verts};
+  for_each_random_pair(num_verts, density, static_cast<unsigned>(num_verts), [&](std::size_t u, std::size_t v){
+    if (u != v){
+      d.add_edge(u, v);
+      // edges of a random order of the vertices
+      dag.add_edge(std::min(u, v) * 7 % num_verts, std::max(u, v) * 7 % num_verts);
+    }
+  });
+
+  check_components(d);
+  check_components(CsrDigraph::from(d));
+
+  const auto order {topological_sort(dag)};
+  assert(order);
+  check_order(dag, *order);
+  assert(strongly_connected_components(dag).count() == num_verts);
+}
+
+int main(){
+  test_small();
+
+  test_deep(1000000);
+
+  test_random(1, 0.5);
+  test_random(30, 0.05);
+  test_random(50, 0.03);
+  test_random(60, 0.1);
+
+  return 0;
+}
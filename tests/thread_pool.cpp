@@ -0,0 +1,59 @@
+#include <cassert>
+
+#include <atomic>
+
+#include <vector>
+
+#include <thread_pool.hpp>
+
+void test_parallel_for(){
+  ThreadPool pool {4};
+
+  assert(pool.num_threads() == 4);
+
+  std::vector<int> v (10000, 0);
+  // every position is visited exactly once
+  pool.parallel_for(0, v.size(), [&v](std::size_t first, std::size_t last){
+    for (std::size_t i {first}; i < last; ++i){
+      ++v[i];
+    }
+  });
+
+  for (auto e : v){
+    assert(e == 1);
+  }
+  // chunks have at least grain positions
+  std::atomic<std::size_t> smallest {v.size()};
+  pool.parallel_for(0, 1000, [&smallest](std::size_t first, std::size_t last){
+    if (last != 1000 && last - first < smallest){
+      smallest = last - first;
+    }
+  }, 300);
+
+  assert(smallest >= 300);
+  // empty ranges do nothing
+  pool.parallel_for(5, 5, [](std::size_t, std::size_t){ assert(false); });
+}
+
+void test_nested(){
+  ThreadPool pool {3};
+  std::atomic<int> count {0};
+  // loops started from inside loops do not deadlock
+  pool.parallel_for(0, 16, [&pool, &count](std::size_t first, std::size_t last){
+    for (std::size_t i {first}; i < last; ++i){
+      pool.parallel_for(0, 100, [&count](std::size_t f, std::size_t l){
+        count += static_cast<int>(l - f);
+      });
+    }
+  });
+
+  assert(count == 1600);
+}
+
+int main(){
+  test_parallel_for();
+
+  test_nested();
+
+  return 0;
+}
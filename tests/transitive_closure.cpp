@@ -0,0 +1,79 @@
+#include <cassert>
+
+#include <vector>
+
+#include <transitive_closure.hpp>
+
+#include "random_graph.hpp"
+// vertices reachable from u through paths with at least one edge
+template<typename DigraphType>
+std::vector<bool> reachable_from(const DigraphType& d, std::size_t u){
+  std::vector<bool> reached (d.num_verts, false);
+  d.for_each_neighbor(u, [&](std::size_t v){
+    if (!reached[v]){
+      depth_first_search(d, v, [&reached](std::size_t w){ reached[w] = true; });
+    }
+  });
+
+  return reached;
+}
+
+template<typename DigraphType>
+void check_closure(const DigraphType& d, ThreadPool& pool){
+  const BitMatrix closure {transitive_closure(d, pool)};
+  const ReachabilityIndex index {d, pool};
+
+  assert(closure.num_rows == d.num_verts && closure.num_cols == d.num_verts);
+  assert(index.size() == d.num_verts);
+  assert(index.num_components() == strongly_connected_components(d).count());
+  for (std::size_t u {0}; u < d.num_verts; ++u){
+    const auto reached {reachable_from(d, u)};
+    for (std::size_t v {0}; v < d.num_verts; ++v){
+      assert(closure.const_at(u, v) == reached[v]);
+      assert(index.reachable(u, v) == (u == v || reached[v]));
+    }
+  }
+}
+
+void test_small(ThreadPool& pool){
+  // 0 -> 1 -> 2 -> 1, and 3 -> 0
+  Digraph d {4};
+  d.add_edge(0, 1);
+  d.add_edge(1, 2);
+  d.add_edge(2, 1);
+  d.add_edge(3, 0);
+
+  const BitMatrix closure {transitive_closure(d, pool)};
+  assert(!closure.const_at(0, 0) && closure.const_at(0, 1) && closure.const_at(0, 2) && !closure.const_at(0, 3));
+  assert(closure.const_at(1, 1) && closure.const_at(2, 2));
+  assert(closure.const_at(3, 2));
+  assert(closure.count() == 9);
+
+  const ReachabilityIndex index {d, pool};
+  assert(index.num_components() == 3);
+  assert(index.reachable(3, 2) && index.reachable(0, 0) && !index.reachable(2, 0));
+}
+// random digraphs with num_verts vertices, each edge present with a
+// probability of density, on several backends
+void test_random(std::size_t num_verts, double density, ThreadPool& pool){
+  Digraph d {num_verts};
+  add_random_edges(num_verts, density, true, d);
+
+  check_closure(d, pool);
+  check_closure(CsrDigraph::from(d), pool);
+}
+
+int main(){
+  // more threads than cores, so that rows are updated concurrently
+  ThreadPool pool {4};
+
+  test_small(pool);
+
+  test_random(1, 0.5, pool);
+  test_random(63, 0.02, pool);
+  test_random(130, 0.008, pool);
+  test_random(300, 0.003, pool);
+  test_random(300, 0.01, pool);
+
+  return 0;
+}
@@ -0,0 +1,115 @@
+#include <cassert>
+
+#include <cmath>
+
+#include <vector>
+
+#include <csr_graph.hpp>
+#include <triangle_counting.hpp>
+
+#include "random_graph.hpp"
+// triangles of each vertex, found by checking every triple of
+// distinct vertices
+template<typename GraphType>
+std::vector<std::size_t> reference_triangles(const GraphType& g){
+  const std::size_t n {g.num_verts};
+  std::vector<std::size_t> count (n, 0);
+  for (std::size_t u {0}; u < n; ++u){
+    for (std::size_t v {u + 1}; v < n; ++v){
+      for (std::size_t w {v + 1}; w < n; ++w){
+        if (g.has_edge(u, v) && g.has_edge(v, w) && g.has_edge(u, w)){
+          ++count[u];
+          ++count[v];
+          ++count[w];
+        }
+      }
+    }
+  }
+
+  return count;
+}
+// counts, per vertex counts and coefficients agree with the reference
+template<typename GraphType>
+void check_triangles(const GraphType& g, const std::vector<std::size_t>& expected, ThreadPool& pool){
+  std::size_t total {0};
+  for (const auto c : expected){
+    total += c;
+  }
+  assert(count_triangles(g, pool) == total / 3);
+  assert(triangles_per_vertex(g, pool) == expected);
+
+  const auto coefficient {clustering_coefficients(g, pool)};
+  for (std::size_t u {0}; u < g.num_verts; ++u){
+    std::size_t degree {0};
+    for (std::size_t v {0}; v < g.num_verts; ++v){
+      degree += v != u && g.has_edge(u, v);
+    }
+    const double pairs {degree * (degree - 1) / 2.0};
+    assert(std::abs(coefficient[u] - (degree > 1 ? expected[u] / pairs : 0.0)) < 1e-12);
+  }
+}
+
+void test_small(ThreadPool& pool){
+  // two triangles sharing edge (1, 2), a loop at 1, and a pendant 4
+  Graph g {6};
+  g.add_edge(0, 1);
+  g.add_edge(1, 2);
+  g.add_edge(0, 2);
+  g.add_edge(1, 3);
+  g.add_edge(2, 3);
+  g.add_edge(3, 4);
+  g.add_edge(1, 1);
+
+  assert(count_triangles(g, pool) == 2);
+  assert((triangles_per_vertex(g, pool) == std::vector<std::size_t>{1, 2, 2, 1, 0, 0}));
+  const auto coefficient {clustering_coefficients(g, pool)};
+  assert(coefficient[0] == 1.0);
+  assert(std::abs(coefficient[1] - 2.0 / 3.0) < 1e-12);
+  assert(std::abs(coefficient[3] - 1.0 / 3.0) < 1e-12);
+  assert(coefficient[4] == 0.0 && coefficient[5] == 0.0);
+  // a complete graph has every triple as a triangle
+  const std::size_t n {130};
+  Graph complete {n};
+  for (std::size_t u {0}; u < n; ++u){
+    for (std::size_t v {u + 1}; v < n; ++v){
+      complete.add_edge(u, v);
+    }
+  }
+  assert(count_triangles(complete, pool) == n * (n - 1) * (n - 2) / 6);
+  for (const double c : clustering_coefficients(complete, pool)){
+    assert(c == 1.0);
+  }
+
+  assert(count_triangles(Graph{0}, pool) == 0);
+}
+// random graphs with num_verts vertices, each edge present with a
+// probability of density, on every backend
+void test_random(std::size_t num_verts, double density, ThreadPool& pool){
+  Graph g {num_verts};
+  Graph_<SquareMatrix> dense_g {num_verts};
+  Graph_<UpperTriangularMatrix> triangular_g {num_verts};
+  // loops are never part of triangles
+  add_random_edges(num_verts, density, true, g, dense_g, triangular_g);
+
+  const auto expected {reference_triangles(g)};
+  check_triangles(g, expected, pool);
+  check_triangles(dense_g, expected, pool);
+  check_triangles(triangular_g, expected, pool);
+  check_triangles(CsrGraph::from(g), expected, pool);
+}
+
+int main(){
+  // more threads than cores, so that rows are intersected
+  // concurrently
+  ThreadPool pool {4};
+
+  test_small(pool);
+
+  test_random(1, 0.5, pool);
+  test_random(64, 0.3, pool);
+  test_random(65, 0.5, pool);
+  test_random(200, 0.1, pool);
+  test_random(300, 0.02, pool);
+
+  return 0;
+}
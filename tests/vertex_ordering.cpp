@@ -0,0 +1,181 @@
+#include <cassert>
+
+#include <algorithm>
+
+#include <random>
+
+#include <vector>
+
+#include <vertex_ordering.hpp>
+// forward and inverse are permutations of the vertices, inverse of
+// each other
+void check_permutation(const Permutation& p, std::size_t num_verts){
+  assert(p.size() == num_verts);
+  assert(p.inverse.size() == num_verts);
+
+  for (std::size_t v {0}; v < num_verts; ++v){
+    assert(p.forward[v] < num_verts);
+    assert(p.inverse[p.forward[v]] == v);
+  }
+}
+// relabeled has an edge (forward[u], forward[v]) for each edge (u, v)
+// of g, and nothing else
+template<typename GraphType>
+void check_relabeled(const GraphType& g, const Reordered<GraphType>& reordered){
+  const auto& [h, p] {reordered};
+  check_permutation(p, g.num_verts);
+  assert(h.num_verts == g.num_verts);
+  assert(h.num_edges == g.num_edges);
+
+  for (std::size_t u {0}; u < g.num_verts; ++u){
+    for (std::size_t v {0}; v < g.num_verts; ++v){
+      assert(h.has_edge(p.forward[u], p.forward[v]) == g.has_edge(u, v));
+    }
+  }
+}
+// largest difference between the labels of the endpoints of an edge
+template<typename GraphType>
+std::size_t bandwidth(const GraphType& g){
+  std::size_t result {0};
+  for (std::size_t u {0}; u < g.num_verts; ++u){
+    g.for_each_neighbor(u, [&](std::size_t v){ result = std::max(result, u > v ? u - v : v - u); });
+  }
+
+  return result;
+}
+// a graph whose edges form a path, or a grid of width columns, with
+// vertices labeled at random
+template<typename GraphType>
+GraphType shuffled_grid(std::size_t num_verts, std::size_t width){
+  std::vector<std::size_t> label (num_verts);
+  for (std::size_t v {0}; v < num_verts; ++v){
+    label[v] = v;
+  }
+  std::shuffle(label.begin(), label.end(), std::mt19937{static_cast<unsigned>(num_verts)});
+
+  GraphType g {num_verts};
+  for (std::size_t v {0}; v < num_verts; ++v){
+    if ((v + 1) % width != 0 && v + 1 < num_verts){
+      g.add_edge(label[v], label[v + 1]);
+    }
+    if (v + width < num_verts){
+      g.add_edge(label[v], label[v + width]);
+    }
+  }
+
+  return g;
+}
+
+void test_cuthill_mckee(){
+  // a shuffled path gets back its bandwidth of 1
+  const auto path {shuffled_grid<Graph>(100, 100)};
+  assert(bandwidth(path) > 1);
+  const auto ordered {reorder(path, VertexOrdering::reverse_cuthill_mckee)};
+  check_relabeled(path, ordered);
+  assert(bandwidth(ordered.graph) == 1);
+  // a shuffled grid gets a bandwidth close to its width
+  const auto grid {shuffled_grid<Graph>(400, 10)};
+  const auto ordered_grid {reorder(grid, VertexOrdering::reverse_cuthill_mckee)};
+  check_relabeled(grid, ordered_grid);
+  assert(bandwidth(ordered_grid.graph) <= 11);
+  // several components, isolated vertices among them
+  Graph g {8};
+  g.add_edge(5, 1);
+  g.add_edge(1, 7);
+  g.add_edge(2, 4);
+  check_relabeled(g, reorder(g, VertexOrdering::reverse_cuthill_mckee));
+}
+
+void test_degree(){
+  const auto g {shuffled_grid<Graph>(300, 17)};
+  const auto ordered {reorder(g, VertexOrdering::degree)};
+  check_relabeled(g, ordered);
+
+  for (std::size_t w {1}; w < g.num_verts; ++w){
+    assert(ordered.graph.degree(w - 1) >= ordered.graph.degree(w));
+  }
+}
+
+void test_breadth_first(){
+  const auto g {shuffled_grid<Graph>(300, 17)};
+  const auto ordered {reorder(g, VertexOrdering::breadth_first)};
+  check_relabeled(g, ordered);
+  // searching from 0 again finds vertices in increasing order
+  assert(ordered.permutation.inverse[0] == 0);
+  const auto again {breadth_first_order(ordered.graph)};
+  for (std::size_t w {0}; w < g.num_verts; ++w){
+    assert(again.inverse[w] == w);
+  }
+}
+
+void test_digraphs(){
+  // 0 -> 1 -> 2, 3 -> 2, and 4 reaching nothing
+  Digraph d {5};
+  d.add_edge(0, 1);
+  d.add_edge(1, 2);
+  d.add_edge(3, 2);
+  d.add_edge(2, 2);
+
+  for (const auto ordering : {VertexOrdering::reverse_cuthill_mckee, VertexOrdering::degree, VertexOrdering::breadth_first}){
+    check_relabeled(d, reorder(d, ordering));
+  }
+  // any representation is reordered
+  const auto g {shuffled_grid<Graph>(200, 9)};
+  const auto csr {CsrGraph::from(g)};
+  const auto ordered {reorder(csr, VertexOrdering::reverse_cuthill_mckee)};
+  check_permutation(ordered.permutation, g.num_verts);
+  assert(ordered.graph.num_edges == g.num_edges);
+  assert(ordered.permutation.forward == reverse_cuthill_mckee(g).forward);
+}
+
+void test_weighted(){
+  WeightedGraph<int> wg {6};
+  wg.add_edge(0, 5, 10);
+  wg.add_edge(5, 2, 20);
+  wg.add_edge(2, 4, 30);
+  wg.add_edge(1, 3, 40);
+  wg.add_edge(3, 3, 50);
+
+  const auto [h, p] {reorder(wg, VertexOrdering::reverse_cuthill_mckee)};
+  check_permutation(p, wg.num_verts);
+  assert(h.num_edges == wg.num_edges);
+  for (std::size_t u {0}; u < wg.num_verts; ++u){
+    for (std::size_t v {0}; v < wg.num_verts; ++v){
+      assert(h.has_edge(p.forward[u], p.forward[v]) == wg.has_edge(u, v));
+      assert(h.edge_weight(p.forward[u], p.forward[v]) == wg.edge_weight(u, v));
+    }
+  }
+}
+
+void test_relabel(){
+  const auto g {shuffled_grid<Graph>(50, 7)};
+  std::vector<std::size_t> forward (g.num_verts);
+  for (std::size_t v {0}; v < g.num_verts; ++v){
+    forward[v] = g.num_verts - 1 - v;
+  }
+  const auto h {relabel(g, forward)};
+  assert(h && h->num_edges == g.num_edges);
+  // labels must be a permutation of the vertices
+  forward[3] = g.num_verts;
+  assert(!relabel(g, forward));
+  forward[3] = forward[4];
+  assert(!relabel(g, forward));
+  forward.pop_back();
+  assert(!relabel(g, forward));
+
+  WeightedGraph<int> wg {3};
+  wg.add_edge(0, 1, 5);
+  assert(relabel(wg, {2, 0, 1})->edge_weight(2, 0) == 5);
+  assert(!relabel(wg, {0, 1, 3}));
+}
+
+int main(){
+  test_cuthill_mckee();
+  test_degree();
+  test_breadth_first();
+  test_digraphs();
+  test_weighted();
+  test_relabel();
+
+  return 0;
+}
@@ -73,9 +73,23 @@ void test2(){
   assert(wg.num_edges == 9);
 }
 
+void test3(){
+  const WeightedGraph<int> wg {WeightedGraph<int>::from_sorted_edges(5, {{0, 1}, {0, 4}, {1, 2}, {2, 2}, {3, 4}},
+                                                                     {10, 20, 30, 40, 50})};
+  assert(wg.num_verts == 5);
+  assert(wg.num_edges == 5);
+  assert(wg.has_edge(4, 0));
+  assert(!wg.has_edge(1, 3));
+  assert(wg.edge_weight(1, 0) == 10);
+  assert(wg.edge_weight(2, 2) == 40);
+  assert(wg.edge_weight(4, 3) == 50);
+  assert(wg.graph().degree(4) == 2);
+}
+
 int main(){
   test1();
   test2();
+  test3();
 
   return 0;
 }
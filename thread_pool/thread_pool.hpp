@@ -0,0 +1,158 @@
+// another way to achieve what #pragma once does
+#ifndef thread_pool_hpp
+#define thread_pool_hpp
+// min and max
+#include <algorithm>
+// chunks are claimed through an atomic counter
+#include <atomic>
+// waiting for work and for its completion
+#include <condition_variable>
+#include <mutex>
+// pending tasks are kept in a queue
+#include <deque>
+// tasks are type-erased functions
+#include <functional>
+// state of a parallel loop is shared among threads
+#include <memory>
+// worker threads
+#include <thread>
+#include <vector>
+// a fixed set of worker threads executing tasks. Parallel loops split
+// their range in chunks, which are claimed by the workers and by the
+// calling thread itself. As the caller works instead of just waiting,
+// a parallel loop may be started from inside another one without
+// deadlocking, even when every worker is busy
+class ThreadPool{
+public:
+  // alias used as index type
+  using size_type = std::size_t;
+private:
+  // alias for tasks
+  using Task = std::function<void()>;
+  // worker threads and pending tasks
+  std::vector<std::thread> workers_;
+  std::deque<Task>         tasks_;
+  // protects tasks_ and stopping_
+  std::mutex              mutex_;
+  std::condition_variable available_;
+  // signals workers to finish
+  bool stopping_;
+  // executed by each worker: runs tasks until pool is destroyed
+  void work_(){
+    while (true){
+      Task task {};
+      {
+        std::unique_lock<std::mutex> lock {mutex_};
+        available_.wait(lock, [this](){ return stopping_ || !tasks_.empty(); });
+        if (tasks_.empty()){
+          return;
+        }
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+      }
+      task();
+    }
+  }
+  // state of a parallel loop: next chunk to be claimed and number of
+  // chunks already finished
+  struct Loop_{
+    std::atomic<size_type>  next;
+    size_type               finished;
+    std::mutex              mutex;
+    std::condition_variable done;
+  };
+public:
+  // builds a pool whose parallel loops use num_threads threads: the
+  // caller and num_threads - 1 workers
+  explicit ThreadPool(size_type num_threads = std::thread::hardware_concurrency())
+    : workers_{}, tasks_{}, mutex_{}, available_{}, stopping_{false}
+  {
+    for (size_type t {1}; t < num_threads; ++t){
+      workers_.emplace_back([this](){ work_(); });
+    }
+  }
+  // pools are neither copied nor moved, as workers refer to them
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  // finishes pending tasks, then joins workers
+  ~ThreadPool(){
+    {
+      std::lock_guard<std::mutex> lock {mutex_};
+      stopping_ = true;
+    }
+    available_.notify_all();
+
+    for (auto& worker : workers_){
+      worker.join();
+    }
+  }
+  // number of threads running parallel loops
+  size_type num_threads() const{
+    return workers_.size() + 1;
+  }
+  // pool shared by the whole program, with one thread per core
+  static ThreadPool& shared(){
+    static ThreadPool pool {};
+
+    return pool;
+  }
+  // calls function(first, last) for disjoint chunks [first, last)
+  // covering [begin, end), possibly in parallel, and returns when
+  // every chunk is done. Chunks have at least grain positions, and
+  // there are a few of them per thread, so that uneven chunks still
+  // balance out
+  template<typename Function>
+  void parallel_for(size_type begin, size_type end, Function function, size_type grain = 1){
+    if (begin >= end){
+      return;
+    }
+
+    const size_type size       {end - begin};
+    const size_type max_chunks {num_threads() * 4};
+    const size_type chunk      {std::max(grain, (size + max_chunks - 1) / max_chunks)};
+    const size_type num_chunks {(size + chunk - 1) / chunk};
+    // a single chunk is run right away
+    if (num_chunks == 1 || workers_.empty()){
+      function(begin, end);
+
+      return;
+    }
+    // state outlives this call, as workers may start after all
+    // chunks have been finished
+    auto loop {std::make_shared<Loop_>()};
+    loop->next     = 0;
+    loop->finished = 0;
+    // claims and runs chunks until none is left
+    auto run {[loop, begin, end, chunk, num_chunks, &function](){
+                size_type finished {0};
+                for (size_type c {loop->next++}; c < num_chunks; c = loop->next++){
+                  const size_type first {begin + c * chunk};
+                  function(first, std::min(end, first + chunk));
+                  ++finished;
+                }
+                if (finished > 0){
+                  std::lock_guard<std::mutex> lock {loop->mutex};
+                  loop->finished += finished;
+                  if (loop->finished == num_chunks){
+                    loop->done.notify_all();
+                  }
+                }
+              }};
+    // workers help with the loop ...
+    {
+      std::lock_guard<std::mutex> lock {mutex_};
+      for (size_type w {0}; w < std::min(workers_.size(), num_chunks - 1); ++w){
+        tasks_.emplace_back(run);
+      }
+    }
+    available_.notify_all();
+    // ... as does the caller, which then waits for chunks taken by
+    // workers
+    run();
+
+    std::unique_lock<std::mutex> lock {loop->mutex};
+    loop->done.wait(lock, [&loop, num_chunks](){ return loop->finished == num_chunks; });
+  }
+};
+
+#endif
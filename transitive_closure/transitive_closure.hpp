@@ -0,0 +1,155 @@
+// another way to achieve what #pragma once does
+#ifndef transitive_closure_hpp
+#define transitive_closure_hpp
+// min
+#include <algorithm>
+// components are moved into indices
+#include <utility>
+// masks of pivots are kept in vectors
+#include <vector>
+// closures are matrices of bits, whose rows are combined a word at a
+// time
+#include <bit_matrix.hpp>
+// reachability indices are built on the condensation of digraphs
+#include <strongly_connected_components.hpp>
+// rows are updated in parallel
+#include <thread_pool.hpp>
+// Warshall's algorithm: for each pivot k, every row i with bit k set
+// gets row k ORed into it, so that after pivot k row i holds every
+// vertex reachable from i through intermediate vertices up to k.
+// Pivots are taken a word (64 pivots) at a time. The rows of the
+// pivots are first updated among themselves, in order; then every
+// other row i needs only the pivots whose bits were set in it before
+// the block, as the first pivot of a path from i lies after vertices
+// already handled, and rows of pivots are complete for the block.
+// Those rows are independent, so they are updated in parallel, and
+// in slices of words small enough for the 64 pivot slices to stay in
+// cache while every row of a chunk goes through them
+namespace closure_detail{
+  using size_type = std::size_t;
+  using word_type = bit_detail::word_type;
+
+  constexpr size_type word_bits {BitMatrix::word_bits};
+  // words per slice: 64 pivot slices take 128 KiB
+  constexpr size_type slice_words {256};
+  // rows per chunk of parallel loops
+  constexpr size_type row_grain {64};
+  // replaces square matrix r, seen as the adjacency matrix of a
+  // digraph, with its transitive closure
+  inline void warshall(BitMatrix& r, ThreadPool& pool){
+    const size_type n {r.num_rows};
+    const size_type words {r.words_per_row()};
+    word_type* data {r.data()};
+
+    for (size_type kw {0}; kw < words; ++kw){
+      const size_type k_0 {kw * word_bits};
+      const size_type k_1 {std::min(n, k_0 + word_bits)};
+      // rows of pivots, among themselves, in order
+      for (size_type k {k_0}; k < k_1; ++k){
+        for (size_type i {k_0}; i < k_1; ++i){
+          if (i != k && r.const_at(i, k)){
+            r.row(i) |= r.row(k);
+          }
+        }
+      }
+      // every other row
+      pool.parallel_for(0, n, [&](size_type first, size_type last){
+        // pivots set in each row before the block, as the slice of
+        // word kw changes along the way
+        std::vector<word_type> mask (last - first);
+        for (size_type i {first}; i < last; ++i){
+          mask[i - first] = i >= k_0 && i < k_1 ? 0 : data[i * words + kw];
+        }
+        for (size_type s_0 {0}; s_0 < words; s_0 += slice_words){
+          const size_type s_1 {std::min(words, s_0 + slice_words)};
+          for (size_type i {first}; i < last; ++i){
+            word_type* row_i {data + i * words};
+            for (word_type pivots {mask[i - first]}; pivots != 0; pivots &= pivots - 1){
+              const word_type* row_k {data + (k_0 + bit_detail::lowest_set(pivots)) * words};
+              for (size_type w {s_0}; w < s_1; ++w){
+                row_i[w] |= row_k[w];
+              }
+            }
+          }
+        }
+      }, row_grain);
+    }
+  }
+  // adjacency matrix of D, as a matrix of bits
+  template<typename DigraphType>
+  BitMatrix adjacency(const DigraphType& D, ThreadPool& pool){
+    const size_type n {D.num_verts};
+    BitMatrix r {n, n};
+    pool.parallel_for(0, n, [&](size_type first, size_type last){
+      for (size_type u {first}; u < last; ++u){
+        if constexpr (graph_detail::has_neighbor_rows<DigraphType>::value){
+          r.row(u).assign(D.neighbor_row(u));
+        }
+        else{
+          const auto row {r.row(u)};
+          D.for_each_neighbor(u, [&row](size_type v){ row.set(v); });
+        }
+      }
+    }, row_grain);
+
+    return r;
+  }
+}
+// transitive closure of D, which may be any digraph providing
+// num_verts and for_each_neighbor: bit (u, v) is set when there is a
+// path with at least one edge from u to v, so bit (u, u) is only set
+// when u is on a cycle. It is computed with a blocked, parallel,
+// Warshall's algorithm, whose running time grows with the cube of the
+// number of vertices, divided by 64
+template<typename DigraphType>
+BitMatrix transitive_closure(const DigraphType& D, ThreadPool& pool = ThreadPool::shared()){
+  BitMatrix r {closure_detail::adjacency(D, pool)};
+  closure_detail::warshall(r, pool);
+
+  return r;
+}
+// answers whether a vertex can reach another one in constant time.
+// Vertices of a strongly connected component reach the same vertices,
+// so the index only keeps the component of each vertex, and the
+// transitive closure of the condensation, which is usually much
+// smaller than the closure of the digraph. Indices are snapshots: they
+// are rebuilt when the digraph changes
+class ReachabilityIndex{
+public:
+  using size_type = std::size_t;
+private:
+  // strongly connected component of each vertex
+  std::vector<size_type> component_;
+  // closure of the condensation
+  BitMatrix closure_;
+public:
+  // indexes digraph D, which may be any digraph providing num_verts,
+  // next_neighbor and for_each_neighbor
+  template<typename DigraphType>
+  explicit ReachabilityIndex(const DigraphType& D, ThreadPool& pool = ThreadPool::shared())
+    : component_{}, closure_{0, 0}
+  {
+    Components components {strongly_connected_components(D)};
+    closure_ = transitive_closure(condensation(D, components), pool);
+    component_ = std::move(components.label);
+  }
+  // number of vertices
+  size_type size() const{
+    return component_.size();
+  }
+  // number of strongly connected components, which is the size of the
+  // closure
+  size_type num_components() const{
+    return closure_.num_rows;
+  }
+  // whether there is a path from u to v. Every vertex reaches itself,
+  // through a path with no edges
+  bool reachable(size_type u, size_type v) const{
+    const size_type a {component_[u]};
+    const size_type b {component_[v]};
+
+    return a == b || closure_.const_at(a, b);
+  }
+};
+
+#endif
@@ -0,0 +1,293 @@
+// another way to achieve what #pragma once does
+#ifndef triangle_counting_hpp
+#define triangle_counting_hpp
+// intersections are limited to words set in both rows
+#include <algorithm>
+// totals of threads are added up
+#include <numeric>
+// counts and coefficients are kept in vectors
+#include <vector>
+// neighborhoods are rows of bits, intersected a word at a time
+#include <bit_matrix.hpp>
+// graphs provide neighbors through for_each_neighbor
+#include <graph.hpp>
+// rows are intersected in parallel
+#include <thread_pool.hpp>
+// a triangle is a set of three vertices with edges between each pair
+// of them, so the triangles over an edge (u, v) are the vertices
+// adjacent to both u and v. Graphs stored as rows of bits intersect
+// rows: the vertices adjacent to both are the set bits of row u AND
+// row v, counted with a popcount per word, instead of a has_edge call
+// per vertex. Any other graph, such as a compressed one, would need
+// n x n bits as rows, so it intersects sorted lists of neighbors
+// instead, merging them, in time and memory proportional to its
+// edges. Loops are never part of triangles, so they are left out of
+// rows and lists
+namespace triangle_detail{
+  using size_type = std::size_t;
+  using word_type = bit_detail::word_type;
+  // rows per chunk of parallel loops
+  constexpr size_type row_grain {64};
+  // words of a row holding set bits: any other word is zero, so
+  // intersections skip it
+  struct Span{
+    size_type first;
+    size_type last;
+  };
+  // whether u comes before v when edges are oriented: vertices of
+  // lower degree come first, and so do smaller labels among vertices of
+  // the same degree
+  inline bool before(const std::vector<size_type>& degree, size_type u, size_type v){
+    return degree[u] < degree[v] || (degree[u] == degree[v] && u < v);
+  }
+  // degree of each vertex of g when oriented, which orientation needs,
+  // and nothing otherwise
+  template<typename GraphType>
+  std::vector<size_type> degrees(const GraphType& g, bool oriented, ThreadPool& pool){
+    std::vector<size_type> degree (oriented ? g.num_verts : 0);
+    pool.parallel_for(0, degree.size(), [&](size_type first, size_type last){
+      for (size_type u {first}; u < last; ++u){
+        degree[u] = graph_detail::out_degree(g, u);
+      }
+    }, row_grain);
+
+    return degree;
+  }
+  // adjacency matrix of g, which is stored as rows of bits, without
+  // loops. When oriented, row u only keeps the neighbors coming after
+  // u, so each edge is kept once, by its endpoint of lower degree, and
+  // rows of vertices of high degree, which would be the most expensive
+  // to intersect, hold few bits
+  template<typename GraphType>
+  BitMatrix adjacency(const GraphType& g, bool oriented, ThreadPool& pool){
+    const size_type n {g.num_verts};
+    const std::vector<size_type> degree {degrees(g, oriented, pool)};
+
+    BitMatrix r {n, n};
+    pool.parallel_for(0, n, [&](size_type first, size_type last){
+      for (size_type u {first}; u < last; ++u){
+        const auto row {r.row(u)};
+        if (!oriented){
+          row.assign(g.neighbor_row(u));
+          row.set(u, false);
+          continue;
+        }
+        g.for_each_neighbor(u, [&](size_type v){
+          if (v != u && before(degree, u, v)){
+            row.set(v);
+          }
+        });
+      }
+    }, row_grain);
+
+    return r;
+  }
+  // span of each row of r
+  inline std::vector<Span> spans(const BitMatrix& r, ThreadPool& pool){
+    const size_type words {r.words_per_row()};
+    std::vector<Span> span (r.num_rows);
+    pool.parallel_for(0, r.num_rows, [&](size_type first, size_type last){
+      for (size_type u {first}; u < last; ++u){
+        const word_type* row {r.data() + u * words};
+        Span& s {span[u]};
+        for (s.first = 0; s.first < words && row[s.first] == 0; ++s.first){}
+        for (s.last = words; s.last > s.first && row[s.last - 1] == 0; --s.last){}
+      }
+    }, row_grain);
+
+    return span;
+  }
+  // number of bits set in both row u and row v of r
+  inline size_type count_common(const BitMatrix& r, const std::vector<Span>& span, size_type u, size_type v){
+    const size_type words {r.words_per_row()};
+    const word_type* a {r.data() + u * words};
+    const word_type* b {r.data() + v * words};
+
+    size_type total {0};
+    for (size_type w {std::max(span[u].first, span[v].first)}; w < std::min(span[u].last, span[v].last); ++w){
+      total += bit_detail::popcount(a[w] & b[w]);
+    }
+
+    return total;
+  }
+  // neighbors of each vertex, in increasing order: those of u are
+  // neighbor[start[u]] to neighbor[start[u + 1] - 1]
+  struct NeighborLists{
+    std::vector<size_type> start;
+    std::vector<size_type> neighbor;
+
+    const size_type* begin(size_type u) const{
+      return neighbor.data() + start[u];
+    }
+    const size_type* end(size_type u) const{
+      return neighbor.data() + start[u + 1];
+    }
+  };
+  // lists of neighbors of g, without loops, kept as adjacency keeps
+  // rows: when oriented, u only keeps the neighbors coming after it.
+  // Vertices count their neighbors, and then fill their lists, in
+  // parallel
+  template<typename GraphType>
+  NeighborLists neighbor_lists(const GraphType& g, bool oriented, ThreadPool& pool){
+    const size_type n {g.num_verts};
+    const std::vector<size_type> degree {degrees(g, oriented, pool)};
+    const auto kept {[&](size_type u, size_type v){ return v != u && (!oriented || before(degree, u, v)); }};
+
+    NeighborLists lists {std::vector<size_type>(n + 1, 0), {}};
+    pool.parallel_for(0, n, [&](size_type first, size_type last){
+      for (size_type u {first}; u < last; ++u){
+        g.for_each_neighbor(u, [&](size_type v){ lists.start[u + 1] += kept(u, v); });
+      }
+    }, row_grain);
+    for (size_type u {0}; u < n; ++u){
+      lists.start[u + 1] += lists.start[u];
+    }
+
+    lists.neighbor.resize(lists.start[n]);
+    pool.parallel_for(0, n, [&](size_type first, size_type last){
+      for (size_type u {first}; u < last; ++u){
+        size_type next {lists.start[u]};
+        g.for_each_neighbor(u, [&](size_type v){
+          if (kept(u, v)){
+            lists.neighbor[next++] = v;
+          }
+        });
+      }
+    }, row_grain);
+
+    return lists;
+  }
+  // number of vertices in both the lists of u and v, merged as in
+  // std::set_intersection
+  inline size_type count_common(const NeighborLists& lists, size_type u, size_type v){
+    const size_type* a     {lists.begin(u)};
+    const size_type* a_end {lists.end(u)};
+    const size_type* b     {lists.begin(v)};
+    const size_type* b_end {lists.end(v)};
+
+    size_type total {0};
+    while (a != a_end && b != b_end){
+      if (*a < *b){
+        ++a;
+      }
+      else if (*b < *a){
+        ++b;
+      }
+      else{
+        ++total;
+        ++a;
+        ++b;
+      }
+    }
+
+    return total;
+  }
+  // sum of triangles_at(u) over the vertices u of g. Chunks of
+  // vertices are added up in parallel, each one into its own total
+  template<typename Function>
+  size_type sum_over_vertices(size_type n, Function triangles_at, ThreadPool& pool){
+    std::vector<size_type> total ((n + row_grain - 1) / row_grain, 0);
+    pool.parallel_for(0, total.size(), [&](size_type first, size_type last){
+      for (size_type c {first}; c < last; ++c){
+        size_type sum {0};
+        for (size_type u {c * row_grain}; u < std::min(n, (c + 1) * row_grain); ++u){
+          sum += triangles_at(u);
+        }
+        total[c] = sum;
+      }
+    });
+
+    return std::accumulate(total.begin(), total.end(), size_type{0});
+  }
+}
+// number of triangles of undirected graph g, which may be any graph
+// providing num_verts and for_each_neighbor. Edges are oriented from
+// their endpoint of lower degree, and each triangle is counted once,
+// at its first two vertices, by intersecting their rows, or their
+// lists for graphs not stored as rows of bits. Neighbors of different
+// vertices are intersected in parallel
+template<typename GraphType>
+std::size_t count_triangles(const GraphType& g, ThreadPool& pool = ThreadPool::shared()){
+  static_assert(!GraphType::directed, "triangles are only counted in undirected graphs");
+  using namespace triangle_detail;
+
+  if constexpr (graph_detail::has_neighbor_rows<GraphType>::value){
+    const BitMatrix r {adjacency(g, true, pool)};
+    const std::vector<Span> span {spans(r, pool)};
+
+    return sum_over_vertices(g.num_verts, [&](size_type u){
+      size_type sum {0};
+      r.row(u).for_each_set([&](size_type v){ sum += count_common(r, span, u, v); });
+      return sum;
+    }, pool);
+  }
+  else{
+    const NeighborLists lists {neighbor_lists(g, true, pool)};
+
+    return sum_over_vertices(g.num_verts, [&](size_type u){
+      size_type sum {0};
+      for (const size_type* v {lists.begin(u)}; v != lists.end(u); ++v){
+        sum += count_common(lists, u, *v);
+      }
+      return sum;
+    }, pool);
+  }
+}
+// number of triangles each vertex of undirected graph g belongs to.
+// Every vertex u counts its own, with no orientation, as the sum of
+// the vertices adjacent to both u and v over its neighbors v, which
+// finds each triangle twice; so threads never write to the counts of
+// vertices they do not own
+template<typename GraphType>
+std::vector<std::size_t> triangles_per_vertex(const GraphType& g, ThreadPool& pool = ThreadPool::shared()){
+  static_assert(!GraphType::directed, "triangles are only counted in undirected graphs");
+  using namespace triangle_detail;
+
+  std::vector<size_type> count (g.num_verts, 0);
+  if constexpr (graph_detail::has_neighbor_rows<GraphType>::value){
+    const BitMatrix r {adjacency(g, false, pool)};
+    const std::vector<Span> span {spans(r, pool)};
+    pool.parallel_for(0, g.num_verts, [&](size_type first, size_type last){
+      for (size_type u {first}; u < last; ++u){
+        r.row(u).for_each_set([&](size_type v){ count[u] += count_common(r, span, u, v); });
+        count[u] /= 2;
+      }
+    }, row_grain);
+  }
+  else{
+    const NeighborLists lists {neighbor_lists(g, false, pool)};
+    pool.parallel_for(0, g.num_verts, [&](size_type first, size_type last){
+      for (size_type u {first}; u < last; ++u){
+        for (const size_type* v {lists.begin(u)}; v != lists.end(u); ++v){
+          count[u] += count_common(lists, u, *v);
+        }
+        count[u] /= 2;
+      }
+    }, row_grain);
+  }
+
+  return count;
+}
+// local clustering coefficient of each vertex of undirected graph g:
+// the fraction of pairs of its neighbors which are adjacent, that is,
+// its triangles divided by d (d - 1) / 2, for its d neighbors other
+// than itself. Vertices with fewer than two neighbors have coefficient
+// zero
+template<typename GraphType>
+std::vector<double> clustering_coefficients(const GraphType& g, ThreadPool& pool = ThreadPool::shared()){
+  using size_type = std::size_t;
+
+  const std::vector<size_type> triangles {triangles_per_vertex(g, pool)};
+  std::vector<double> coefficient (g.num_verts, 0.0);
+  for (size_type u {0}; u < g.num_verts; ++u){
+    size_type degree {0};
+    g.for_each_neighbor(u, [&](size_type v){ degree += v != u; });
+    if (degree > 1){
+      coefficient[u] = 2.0 * static_cast<double>(triangles[u]) / static_cast<double>(degree * (degree - 1));
+    }
+  }
+
+  return coefficient;
+}
+
+#endif
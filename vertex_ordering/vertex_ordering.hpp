@@ -0,0 +1,316 @@
+// another way to achieve what #pragma once does
+#ifndef vertex_ordering_hpp
+#define vertex_ordering_hpp
+// vertices are sorted by degree
+#include <algorithm>
+// relabeling fails unless labels are a permutation
+#include <optional>
+// relabeled edges and weights are moved into graphs
+#include <utility>
+// orders and permutations are kept in vectors
+#include <vector>
+// relabeled graphs are built in bulk from their edges
+#include <edge_list.hpp>
+// weighted graphs are relabeled along with their weights
+#include <weighted_graph.hpp>
+// a relabeling of the vertices of a graph: vertex v becomes
+// forward[v], and inverse[w] is the vertex which became w
+struct Permutation{
+  using size_type = std::size_t;
+
+  std::vector<size_type> forward;
+  std::vector<size_type> inverse;
+  // whether forward gives each of num_verts vertices its own label
+  // among them
+  static bool valid(const std::vector<size_type>& forward, size_type num_verts){
+    if (forward.size() != num_verts){
+      return false;
+    }
+
+    std::vector<char> used (num_verts, 0);
+    for (const size_type w : forward){
+      if (w >= num_verts || used[w]){
+        return false;
+      }
+      used[w] = 1;
+    }
+
+    return true;
+  }
+  // the permutation placing vertex order[w] at position w
+  static Permutation from_order(std::vector<size_type> order){
+    std::vector<size_type> forward (order.size());
+    for (size_type w {0}; w < order.size(); ++w){
+      forward[order[w]] = w;
+    }
+
+    return {std::move(forward), std::move(order)};
+  }
+  // number of vertices
+  size_type size() const{
+    return forward.size();
+  }
+};
+// ways to order vertices so that vertices used together get close
+// labels, and so are stored close together:
+// - reverse_cuthill_mckee: breadth first order from a vertex far from
+//   the others, visiting neighbors of lower degree first, and then
+//   reversed. It reduces the bandwidth, the largest difference between
+//   the labels of the endpoints of an edge
+// - degree: vertices of higher degree first, so that the vertices
+//   most often used are stored together
+// - breadth_first: order in which a breadth first search finds
+//   vertices, so that neighbors of a vertex get consecutive labels
+enum class VertexOrdering{reverse_cuthill_mckee, degree, breadth_first};
+// a graph whose vertices were relabeled, and its permutation
+template<typename GraphType>
+struct Reordered{
+  GraphType graph;
+  Permutation permutation;
+};
+// helpers of orderings. Every ordering only needs num_verts and
+// for_each_neighbor, so graphs of any representation are ordered; on
+// digraphs, only edges leaving each vertex are followed. Vertices
+// which cannot be reached are searched from later, so every ordering
+// is a permutation of all vertices
+namespace ordering_detail{
+  using size_type = std::size_t;
+  // the edges of weighted graphs are their underlying graphs'
+  template<typename GraphType>
+  const GraphType& structure(const GraphType& g){
+    return g;
+  }
+  template<typename Weight>
+  const Graph& structure(const WeightedGraph<Weight>& g){
+    return g.graph();
+  }
+  // number of edges leaving each vertex
+  template<typename GraphType>
+  std::vector<size_type> degrees(const GraphType& g){
+    std::vector<size_type> degree (g.num_verts);
+    for (size_type u {0}; u < g.num_verts; ++u){
+      degree[u] = graph_detail::out_degree(g, u);
+    }
+
+    return degree;
+  }
+  // vertices by increasing degree, and by increasing label among
+  // vertices of the same degree
+  inline std::vector<size_type> by_degree(const std::vector<size_type>& degree){
+    std::vector<size_type> order (degree.size());
+    for (size_type v {0}; v < order.size(); ++v){
+      order[v] = v;
+    }
+    std::stable_sort(order.begin(), order.end(), [&degree](size_type a, size_type b){ return degree[a] < degree[b]; });
+
+    return order;
+  }
+  // number of levels of a breadth first search, and position of the
+  // first vertex of its last level
+  struct Levels{
+    size_type count;
+    size_type last;
+  };
+  // appends to order the vertices reached from start, which must not
+  // be visited yet, in breadth first order, marking them as visited.
+  // Unvisited neighbors of each vertex are appended in increasing
+  // order of degree when degree is given, and of label otherwise
+  template<typename GraphType>
+  Levels breadth_first(const GraphType& g, size_type start, std::vector<char>& visited, std::vector<size_type>& order,
+                       const std::vector<size_type>* degree = nullptr){
+    Levels levels {1, order.size()};
+    size_type level_end {order.size() + 1};
+
+    visited[start] = 1;
+    order.push_back(start);
+    // order doubles as the queue of the search
+    for (size_type k {levels.last}; k < order.size(); ++k){
+      if (k == level_end){
+        ++levels.count;
+        levels.last = level_end;
+        level_end   = order.size();
+      }
+      const size_type first {order.size()};
+      g.for_each_neighbor(order[k], [&](size_type v){
+        if (!visited[v]){
+          visited[v] = 1;
+          order.push_back(v);
+        }
+      });
+      if (degree != nullptr){
+        std::stable_sort(order.begin() + first, order.end(), [degree](size_type a, size_type b){
+          return (*degree)[a] < (*degree)[b];
+        });
+      }
+    }
+
+    return levels;
+  }
+  // a vertex far from the others reached from start, found as George
+  // and Liu do: the vertex of lowest degree in the last level of a
+  // breadth first search is searched from, for as long as that adds
+  // levels. Vertices visited meanwhile are unmarked
+  template<typename GraphType>
+  size_type peripheral(const GraphType& g, size_type start, const std::vector<size_type>& degree, std::vector<char>& visited,
+                       std::vector<size_type>& scratch){
+    size_type eccentricity {0};
+    for (;;){
+      scratch.clear();
+      const Levels levels {breadth_first(g, start, visited, scratch)};
+      for (const size_type v : scratch){
+        visited[v] = 0;
+      }
+      if (levels.count <= eccentricity){
+        return start;
+      }
+      eccentricity = levels.count;
+
+      for (size_type k {levels.last}; k < scratch.size(); ++k){
+        if (degree[scratch[k]] < degree[start] || k == levels.last){
+          start = scratch[k];
+        }
+      }
+    }
+  }
+}
+// Reverse Cuthill-McKee order of the vertices of g, which may be any
+// graph providing num_verts and for_each_neighbor, or a weighted
+// graph. Each component is searched from a vertex far from the
+// others, so that levels are many and narrow
+template<typename GraphType>
+Permutation reverse_cuthill_mckee(const GraphType& graph){
+  using namespace ordering_detail;
+
+  const auto& g {structure(graph)};
+  const auto degree {degrees(g)};
+  std::vector<char> visited (g.num_verts, 0);
+  std::vector<size_type> order {};
+  std::vector<size_type> scratch {};
+  order.reserve(g.num_verts);
+
+  for (const size_type v : by_degree(degree)){
+    if (!visited[v]){
+      breadth_first(g, peripheral(g, v, degree, visited, scratch), visited, order, &degree);
+      // in digraphs, the vertex found may not reach v
+      if (!visited[v]){
+        breadth_first(g, v, visited, order, &degree);
+      }
+    }
+  }
+  std::reverse(order.begin(), order.end());
+
+  return Permutation::from_order(std::move(order));
+}
+// vertices of graph by decreasing degree, and by increasing label
+// among vertices of the same degree
+template<typename GraphType>
+Permutation degree_order(const GraphType& graph){
+  using namespace ordering_detail;
+
+  const auto degree {degrees(structure(graph))};
+  std::vector<size_type> order (degree.size());
+  for (size_type v {0}; v < order.size(); ++v){
+    order[v] = v;
+  }
+  std::stable_sort(order.begin(), order.end(), [&degree](size_type a, size_type b){ return degree[a] > degree[b]; });
+
+  return Permutation::from_order(std::move(order));
+}
+// vertices of graph in the order a breadth first search from vertex 0
+// finds them, searching again from the smallest vertex not found yet
+template<typename GraphType>
+Permutation breadth_first_order(const GraphType& graph){
+  using namespace ordering_detail;
+
+  const auto& g {structure(graph)};
+  std::vector<char> visited (g.num_verts, 0);
+  std::vector<size_type> order {};
+  order.reserve(g.num_verts);
+
+  for (size_type v {0}; v < g.num_verts; ++v){
+    if (!visited[v]){
+      breadth_first(g, v, visited, order);
+    }
+  }
+
+  return Permutation::from_order(std::move(order));
+}
+// g with every vertex v relabeled as forward[v]. Graphs of any type
+// built by build_graph are rebuilt in bulk from their relabeled edges.
+// Nothing is returned unless forward is a permutation of the vertices
+// of g
+template<typename GraphType>
+std::optional<GraphType> relabel(const GraphType& g, const std::vector<std::size_t>& forward,
+                                 ThreadPool& pool = ThreadPool::shared()){
+  using size_type = std::size_t;
+
+  if (!Permutation::valid(forward, g.num_verts)){
+    return {};
+  }
+
+  std::vector<Edge> edges {};
+  edges.reserve(g.num_edges);
+  for (size_type u {0}; u < g.num_verts; ++u){
+    g.for_each_neighbor(u, [&](size_type v){
+      if (GraphType::directed || u <= v){
+        edges.push_back({forward[u], forward[v]});
+      }
+    });
+  }
+
+  return build_graph<GraphType>(g.num_verts, std::move(edges), pool);
+}
+// weighted graph g with every vertex v relabeled as forward[v], each
+// edge keeping its weight. Nothing is returned unless forward is a
+// permutation of the vertices of g
+template<typename Weight>
+std::optional<WeightedGraph<Weight>> relabel(const WeightedGraph<Weight>& g, const std::vector<std::size_t>& forward,
+                                             ThreadPool& pool = ThreadPool::shared()){
+  using size_type = std::size_t;
+
+  if (!Permutation::valid(forward, g.num_verts)){
+    return {};
+  }
+  // relabeled edges (u, v), u <= v, with their weights
+  std::vector<std::pair<Edge, Weight>> weighted {};
+  weighted.reserve(g.num_edges);
+  for (size_type u {0}; u < g.num_verts; ++u){
+    g.graph().for_each_neighbor(u, [&](size_type v){
+      if (u <= v){
+        weighted.push_back({{std::min(forward[u], forward[v]), std::max(forward[u], forward[v])}, g.edge_weight(u, v)});
+      }
+    });
+  }
+  std::sort(weighted.begin(), weighted.end(), [](const auto& a, const auto& b){ return a.first < b.first; });
+
+  std::vector<Edge> edges (weighted.size());
+  std::vector<Weight> weights (weighted.size());
+  for (size_type k {0}; k < weighted.size(); ++k){
+    edges[k]   = weighted[k].first;
+    weights[k] = std::move(weighted[k].second);
+  }
+
+  return WeightedGraph<Weight>::from_sorted_edges(g.num_verts, edges, weights, pool);
+}
+// relabels g with an ordering of its vertices, returning the
+// relabeled graph and the permutation used
+template<typename GraphType>
+Reordered<GraphType> reorder(const GraphType& g, VertexOrdering ordering, ThreadPool& pool = ThreadPool::shared()){
+  Permutation permutation {};
+  switch (ordering){
+    case VertexOrdering::reverse_cuthill_mckee:
+      permutation = reverse_cuthill_mckee(g);
+      break;
+    case VertexOrdering::degree:
+      permutation = degree_order(g);
+      break;
+    case VertexOrdering::breadth_first:
+      permutation = breadth_first_order(g);
+      break;
+  }
+
+  // orderings are permutations, so relabeling cannot fail
+  return {std::move(*relabel(g, permutation.forward, pool)), std::move(permutation)};
+}
+
+#endif
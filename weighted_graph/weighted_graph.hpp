@@ -4,6 +4,8 @@
 #include <bstree.hpp>
 // we are going to use Graph class as a component
 #include <graph.hpp>
+// edges are given to bulk construction in vectors
+#include <vector>
 // class to represent an undirected graph with weight values
 // associated to its edges. Default weight type is int
 template<typename Weight = int>
@@ -24,6 +26,10 @@ private:
       std::swap(u, v);
     }
   }
+  // builds a weighted graph over graph g, with no weights yet
+  WeightedGraph(Graph&& g)
+    : graph_{std::move(g)}, edge_weight_{}, num_verts{graph_.num_verts}, num_edges{graph_.num_edges}
+  {}
 public:
   // public const references to number of vertices and edges, respectively
   const size_type& num_verts;
@@ -32,8 +38,40 @@ public:
   WeightedGraph(size_type num_verts)
     : graph_{num_verts}, edge_weight_{}, num_verts{graph_.num_verts}, num_edges{graph_.num_edges}
   {}
+  // move constructor, which binds references to this graph
+  WeightedGraph(WeightedGraph&& wg)
+    : graph_{std::move(wg.graph_)}, edge_weight_{std::move(wg.edge_weight_)},
+      num_verts{graph_.num_verts}, num_edges{graph_.num_edges}
+  {}
+  // builds a weighted graph with num_v vertices and the edges (u, v),
+  // u <= v, of edges, which must be sorted and without duplicates,
+  // edges[k] weighing weights[k]. Edges are set at once, and weights
+  // are inserted medians first, as sorted insertions would degenerate
+  // the binary search tree into a list
+  static WeightedGraph from_sorted_edges(size_type num_v, const std::vector<std::pair<size_type, size_type>>& edges,
+                                         const std::vector<Weight>& weights, ThreadPool& pool = ThreadPool::shared()){
+    WeightedGraph result {Graph::from_sorted_edges(num_v, edges.data(), edges.size(), pool)};
+
+    std::vector<std::pair<size_type, size_type>> ranges {{0, edges.size()}};
+    while (!ranges.empty()){
+      const auto [first, last] {ranges.back()};
+      ranges.pop_back();
+      if (first < last){
+        const size_type middle {first + (last - first) / 2};
+        result.edge_weight_.insert(edges[middle], weights[middle]);
+        ranges.push_back({middle + 1, last});
+        ranges.push_back({first, middle});
+      }
+    }
+
+    return result;
+  }
+  // the underlying graph, for algorithms which only need edges
+  const Graph& graph() const{
+    return graph_;
+  }
   // determines whether an edge between u and v exists
-  bool has_edge(size_type u, size_type v){
+  bool has_edge(size_type u, size_type v) const{
     return graph_.has_edge(u, v);
   }
   // adds edge betweem u and v associated with weight w. Returns false
@@ -76,7 +114,7 @@ public:
   }
   // returns weight of edge between u amd v. In case such an edge does
   // not exist, returms default initialization value of Weight
-  Weight edge_weight(size_type u, size_type v){
+  Weight edge_weight(size_type u, size_type v) const{
     if (has_edge(u, v)){
       // adjusts endpoints
       adjust_endpoints_(u, v);